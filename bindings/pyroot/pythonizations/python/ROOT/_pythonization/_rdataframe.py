@@ -177,7 +177,21 @@ from . import pythonization
 from ._pyz_utils import MethodTemplateGetter, MethodTemplateWrapper
 
 
-def RDataFrameAsNumpy(df, columns=None, exclude=None, lazy=False):
+# C++ column types that TakeInto can write directly into a NumPy array, with the
+# name of the corresponding NumPy type
+_preallocatable_types = {
+    "short": "short", "Short_t": "short",
+    "unsigned short": "ushort", "UShort_t": "ushort",
+    "int": "intc", "Int_t": "intc",
+    "unsigned int": "uintc", "UInt_t": "uintc",
+    "long long": "longlong", "Long64_t": "longlong",
+    "unsigned long long": "ulonglong", "ULong64_t": "ulonglong",
+    "float": "single", "Float_t": "single",
+    "double": "double", "Double_t": "double",
+}
+
+
+def RDataFrameAsNumpy(df, columns=None, exclude=None, lazy=False, preallocate=False):
     """Read-out the RDataFrame as a collection of numpy arrays.
 
     The values of the dataframe are read out as numpy array of the respective type
@@ -194,10 +208,19 @@ def RDataFrameAsNumpy(df, columns=None, exclude=None, lazy=False):
     Note that this is an instant action of the RDataFrame graph and will trigger the
     event-loop.
 
+    By default the values are collected in C++ std::vectors, one per thread, which are
+    concatenated at the end of the event loop and then adopted by the NumPy arrays. With
+    `preallocate=True`, the number of entries is counted first and the columns of
+    fundamental type are written by ROOT::RDF::Experimental::TakeInto directly into NumPy
+    arrays of that size, so that no intermediate copy is made. This halves the peak memory
+    usage for large exports, at the cost of an additional event loop to count the entries
+    (which runs immediately, even if `lazy=True`).
+
     Parameters:
         columns: If None return all branches as columns, otherwise specify names in iterable.
         exclude: Exclude branches from selection.
         lazy: Determines whether this action is instant (False, default) or lazy (True).
+        preallocate: Count the entries first and write the values directly into the NumPy arrays.
 
     Returns:
         dict or AsNumpyResult: if instant (default), dict with column names as keys and
@@ -225,13 +248,26 @@ def RDataFrameAsNumpy(df, columns=None, exclude=None, lazy=False):
         exclude = []
     columns = [col for col in columns if not col in exclude]
 
+    # Count the entries to size the output arrays of the columns that can be preallocated
+    buffers = {}
+    if preallocate:
+        column_types = {column: df.GetColumnType(column) for column in columns}
+        if any(t in _preallocatable_types for t in column_types.values()):
+            import ROOT
+            n_entries = df.Count().GetValue()
+            node = ROOT.RDF.AsRNode(df)
+
     # Register Take action for each column
     result_ptrs = {}
     for column in columns:
         column_type = df.GetColumnType(column)
-        result_ptrs[column] = df.Take[column_type](column)
+        if preallocate and column_type in _preallocatable_types:
+            buffers[column] = numpy.empty(n_entries, dtype=getattr(numpy, _preallocatable_types[column_type]))
+            result_ptrs[column] = ROOT.RDF.Experimental.TakeInto[column_type](node, column, buffers[column], n_entries)
+        else:
+            result_ptrs[column] = df.Take[column_type](column)
 
-    result = AsNumpyResult(result_ptrs, columns)
+    result = AsNumpyResult(result_ptrs, columns, buffers)
 
     if lazy:
         return result
@@ -251,8 +287,10 @@ class AsNumpyResult(object):
             column name, the value is the NumPy array for that column.
         _result_ptrs (dict): results of the AsNumpy action. The key is the
             column name, the value is the result pointer for that column.
+        _buffers (dict): preallocated NumPy arrays that TakeInto actions write
+            into. The key is the column name.
     """
-    def __init__(self, result_ptrs, columns):
+    def __init__(self, result_ptrs, columns, buffers=None):
         """Constructs an AsNumpyResult object.
 
         Parameters:
@@ -260,10 +298,13 @@ class AsNumpyResult(object):
                 column name, the value is the result pointer for that column.
             columns (list): list of the names of the columns returned by
                 AsNumpy.
+            buffers (dict): preallocated NumPy arrays for the columns that are
+                read with TakeInto rather than Take.
         """
 
         self._result_ptrs = result_ptrs
         self._columns = columns
+        self._buffers = buffers if buffers is not None else {}
         self._py_arrays = None
 
     def GetValue(self):
@@ -282,6 +323,11 @@ class AsNumpyResult(object):
             # Convert the C++ vectors to numpy arrays
             self._py_arrays = {}
             for column in self._columns:
+                if column in self._buffers:
+                    # TakeInto wrote the values at the beginning of the preallocated array: no copy needed
+                    size = self._result_ptrs[column].GetValue()
+                    self._py_arrays[column] = ndarray(self._buffers[column][:size], self._result_ptrs[column])
+                    continue
                 cpp_reference = self._result_ptrs[column].GetValue()
                 if hasattr(cpp_reference, "__array_interface__"):
                     tmp = numpy.asarray(cpp_reference) # This adopts the memory of the C++ object.
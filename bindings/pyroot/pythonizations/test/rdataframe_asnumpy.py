@@ -308,6 +308,21 @@ class RDataFrameAsNumpy(unittest.TestCase):
         pyarr[0][0] = 42
         self.assertTrue(cpparr[0][0] == pyarr[0][0])
 
+    def test_preallocate(self):
+        """
+        Testing the read-out into preallocated NumPy arrays
+        """
+        root_dtypes = ["S", "s", "I", "i", "L", "l", "F", "D"]
+        tree, ref, _, col_names, _ = make_tree(*root_dtypes)
+        df = ROOT.ROOT.RDataFrame(tree).Define("v", "ROOT::RVecF{1.f, 2.f}")
+        npy = df.Filter("col_I > 1").AsNumpy(col_names + ["v"], preallocate=True)
+        for col in col_names:
+            self.assertTrue(all(npy[col] == ref[col][2:]))
+            self.assertEqual(npy[col].result_ptr.GetValue(), 3)
+        # columns of non-fundamental types fall back to Take
+        self.assertEqual(len(npy["v"]), 3)
+        self.assertEqual(list(npy["v"][0]), [1., 2.])
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -344,6 +344,11 @@
   source="" target="fBinSumw2" \
   code="{ fBinSumw2.Reset(); }"
 
+// the spatial index of the bins refers to the bins being replaced when reading into an existing object
+#pragma read sourceClass="TH2Poly" version="[1-]" targetClass="TH2Poly" \
+  source="" target="fBinIndex" \
+  code="{ delete fBinIndex; fBinIndex = nullptr; }"
+
 #pragma read sourceClass="TF1" targetClass="TF1" version="[10]" source="TF1AbsComposition* fComposition_ptr" target="fComposition" code="{ fComposition.reset(onfile.fComposition_ptr); onfile.fComposition_ptr = nullptr; }"
 
 #pragma read sourceClass="TNDArrayT<Float_t>" targetClass="TNDArrayT<Float_t>" source="Int_t fNumData; Float_t *fData;" target="fData" version="[1]" code="{ fData.clear(); if(onfile.fData){fData.reserve(onfile.fNumData); for(int i = 0; i < onfile.fNumData; ++i) fData.push_back(onfile.fData[i]);} }"
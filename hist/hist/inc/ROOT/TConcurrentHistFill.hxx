@@ -0,0 +1,296 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TConcurrentHistFill
+#define ROOT_TConcurrentHistFill
+
+#include "TAxis.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+
+namespace Internal {
+/// Number of dimensions of a histogram class of the TH1/TH2/TH3 families.
+template <class HIST>
+struct THistDim
+   : std::integral_constant<int, std::is_base_of<TH3, HIST>::value ? 3 : (std::is_base_of<TH2, HIST>::value ? 2 : 1)> {
+};
+} // namespace Internal
+
+template <class HIST>
+class TConcurrentHistFiller;
+
+/**
+\class ROOT::TConcurrentHistFill
+\ingroup Hist
+\brief Lets many threads fill the same TH1, TH2 or TH3 without cloning it.
+
+Threads do not fill the histogram directly, as TH1::Fill is not thread-safe. Each thread obtains its own
+TConcurrentHistFiller from MakeFiller() and fills through it: the filler finds the bins of its fills and accumulates
+the corresponding statistics locally, without any synchronization, and periodically adds them to the histogram
+under a lock. Memory usage is bounded by the buffer size of each filler, independently of the size of the histogram.
+
+~~~{.cpp}
+TH1D h("h", "h", 100, 0, 10);
+ROOT::TConcurrentHistFill<TH1D> fill(h);
+auto work = [&fill] {
+   auto filler = fill.MakeFiller();
+   for (int i = 0; i < 1000000; ++i)
+      filler.Fill(gRandom->Gaus(5, 1));
+}; // the destructor of the filler flushes the remaining fills
+std::thread t1(work), t2(work);
+t1.join();
+t2.join();
+h.Draw();
+~~~
+
+The histogram must not be used otherwise while fillers are alive, except after having flushed all of them.
+Histograms whose axes can be extended or have labels, histograms in buffer mode (TH1::SetBuffer) and histograms
+with an axis range set are filled by replaying the buffered coordinates with TH1::Fill under the lock instead, as
+their binning can change during filling. Profiles are not supported.
+*/
+template <class HIST>
+class TConcurrentHistFill {
+   static_assert(std::is_base_of<TH1, HIST>::value, "TConcurrentHistFill only supports histograms deriving from TH1");
+   friend class TConcurrentHistFiller<HIST>;
+
+   static constexpr int kNDim = Internal::THistDim<HIST>::value;
+
+   HIST &fHist;
+   const std::size_t fBufferSize;
+   /// Whether fillers must buffer coordinates rather than bins, because the binning of fHist can change.
+   const bool fReplayFills;
+   std::mutex fMutex;
+
+   bool MustReplayFills() const
+   {
+      if (fHist.GetBuffer())
+         return true;
+      const std::array<const TAxis *, 3> axes{{fHist.GetXaxis(), fHist.GetYaxis(), fHist.GetZaxis()}};
+      for (int d = 0; d < kNDim; ++d) {
+         auto *axis = const_cast<TAxis *>(axes[d]);
+         if (axis->CanExtend() || axis->GetLabels() || axis->TestBit(TAxis::kAxisRange))
+            return true;
+      }
+      return false;
+   }
+
+public:
+   /// \param[in] hist The histogram to fill. It must outlive this object and all its fillers.
+   /// \param[in] bufferSize Number of fills that each filler buffers before adding them to the histogram.
+   explicit TConcurrentHistFill(HIST &hist, std::size_t bufferSize = 1024)
+      : fHist(hist), fBufferSize(std::max(bufferSize, std::size_t(1))), fReplayFills(MustReplayFills())
+   {
+      if (hist.InheritsFrom("TProfile") || hist.InheritsFrom("TProfile2D") || hist.InheritsFrom("TProfile3D"))
+         throw std::invalid_argument("TConcurrentHistFill does not support profiles.");
+   }
+   TConcurrentHistFill(const TConcurrentHistFill &) = delete;
+   TConcurrentHistFill &operator=(const TConcurrentHistFill &) = delete;
+
+   /// Return a new filler. Fillers are not thread-safe: each thread must use its own.
+   TConcurrentHistFiller<HIST> MakeFiller() { return TConcurrentHistFiller<HIST>(*this); }
+
+   /// The histogram being filled. Its content is only complete once all fillers have been flushed.
+   HIST &GetHist() { return fHist; }
+
+   std::size_t GetBufferSize() const { return fBufferSize; }
+};
+
+/**
+\class ROOT::TConcurrentHistFiller
+\ingroup Hist
+\brief Buffers the fills of one thread and adds them to the histogram of a TConcurrentHistFill.
+
+Fills are flushed when the buffer is full, when Flush() is called and when the filler is destroyed. A flush
+only waits for the lock if the buffer has grown to four times the buffer size of the TConcurrentHistFill: before
+that, fills keep being buffered while other threads are flushing.
+*/
+template <class HIST>
+class TConcurrentHistFiller {
+   friend class TConcurrentHistFill<HIST>;
+
+   static constexpr int kNDim = Internal::THistDim<HIST>::value;
+   /// Number of statistics as in TH1::GetStats: sumw, sumw2 and then the sums of w*x, w*x*x, ... for each axis.
+   static constexpr int kNStats = kNDim == 1 ? 4 : (kNDim == 2 ? 7 : 11);
+
+   TConcurrentHistFill<HIST> *fManager;
+   std::vector<std::pair<Int_t, Double_t>> fBinFills; ///< Global bin and weight of each buffered fill
+   std::vector<Double_t> fReplayFills;                ///< Coordinates and weight of each fill, if they must be replayed
+   std::array<Double_t, 11> fStats;                   ///< Statistics of the buffered fills, the first kNStats are used
+   Double_t fNEntries = 0.;                           ///< Number of buffered fills
+   bool fHasWeights = false;                          ///< Whether a buffered fill has a weight different from 1
+
+   /// Coordinates of a fill, padded with zeros beyond the dimension of the histogram.
+   using Coords_t = std::array<Double_t, 3>;
+
+   explicit TConcurrentHistFiller(TConcurrentHistFill<HIST> &manager) : fManager(&manager)
+   {
+      fStats.fill(0.);
+      if (fManager->fReplayFills)
+         fReplayFills.reserve(fManager->fBufferSize * (kNDim + 1));
+      else
+         fBinFills.reserve(fManager->fBufferSize);
+   }
+
+   void AddStats(const Coords_t &x, Double_t w)
+   {
+      fStats[0] += w;
+      fStats[1] += w * w;
+      fStats[2] += w * x[0];
+      fStats[3] += w * x[0] * x[0];
+      if (kNDim > 1) {
+         fStats[4] += w * x[1];
+         fStats[5] += w * x[1] * x[1];
+         fStats[6] += w * x[0] * x[1];
+      }
+      if (kNDim > 2) {
+         fStats[7] += w * x[2];
+         fStats[8] += w * x[2] * x[2];
+         fStats[9] += w * x[0] * x[2];
+         fStats[10] += w * x[1] * x[2];
+      }
+   }
+
+   void FillImpl(const Coords_t &x, Double_t w)
+   {
+      auto &hist = fManager->fHist;
+      if (fManager->fReplayFills) {
+         fReplayFills.insert(fReplayFills.end(), x.begin(), x.begin() + kNDim);
+         fReplayFills.emplace_back(w);
+      } else {
+         // the binning cannot change, so the bins can be found without holding the lock
+         const std::array<const TAxis *, 3> axes{{hist.GetXaxis(), hist.GetYaxis(), hist.GetZaxis()}};
+         std::array<Int_t, 3> bins{{0, 0, 0}};
+         bool inRange = true;
+         for (int d = 0; d < kNDim; ++d) {
+            bins[d] = axes[d]->FindFixBin(x[d]);
+            inRange &= bins[d] > 0 && bins[d] <= axes[d]->GetNbins();
+         }
+         fBinFills.emplace_back(static_cast<const TH1 &>(hist).GetBin(bins[0], bins[1], bins[2]), w);
+         fNEntries += 1.;
+         fHasWeights |= w != 1.;
+         if (inRange || hist.GetStatOverflowsBehaviour())
+            AddStats(x, w);
+      }
+
+      const auto nBuffered = fManager->fReplayFills ? fReplayFills.size() / (kNDim + 1) : fBinFills.size();
+      if (nBuffered >= fManager->fBufferSize) {
+         std::unique_lock<std::mutex> lock(fManager->fMutex, std::try_to_lock);
+         // if another thread is flushing, keep buffering for a while rather than waiting
+         if (!lock.owns_lock() && nBuffered >= 4 * fManager->fBufferSize)
+            lock.lock();
+         if (lock.owns_lock())
+            FlushLocked();
+      }
+   }
+
+   /// Add the buffered fills to the histogram. The lock of the manager must be held.
+   void FlushLocked()
+   {
+      auto &hist = fManager->fHist;
+      if (fManager->fReplayFills) {
+         for (std::size_t i = 0; i < fReplayFills.size(); i += kNDim + 1)
+            ReplayFill(hist, &fReplayFills[i]);
+         fReplayFills.clear();
+         return;
+      }
+
+      if (fBinFills.empty())
+         return;
+      // TH1::GetStats recomputes the statistics from the bin contents when they
+      // were all out of range so far: get them before adding the buffered bins,
+      // which fStats already accounts for.
+      Double_t stats[TH1::kNstat];
+      hist.GetStats(stats);
+      if (fHasWeights && !hist.GetSumw2N() && !hist.TestBit(TH1::kIsNotW))
+         hist.Sumw2(); // as TH1::Fill does, must be called before AddBinContent
+      auto *sumw2 = hist.GetSumw2N() ? hist.GetSumw2()->GetArray() : nullptr;
+      for (const auto &binAndWeight : fBinFills) {
+         hist.AddBinContent(binAndWeight.first, binAndWeight.second);
+         if (sumw2)
+            sumw2[binAndWeight.first] += binAndWeight.second * binAndWeight.second;
+      }
+
+      for (int i = 0; i < kNStats; ++i)
+         stats[i] += fStats[i];
+      hist.PutStats(stats);
+      hist.SetEntries(hist.GetEntries() + fNEntries);
+
+      fBinFills.clear();
+      fStats.fill(0.);
+      fNEntries = 0.;
+      fHasWeights = false;
+   }
+
+   static void ReplayFill(TH1 &hist, const Double_t *xw)
+   {
+      if (kNDim == 1)
+         hist.Fill(xw[0], xw[1]);
+      else if (kNDim == 2)
+         static_cast<TH2 &>(hist).Fill(xw[0], xw[1], xw[2]);
+      else
+         static_cast<TH3 &>(hist).Fill(xw[0], xw[1], xw[2], xw[3]);
+   }
+
+public:
+   TConcurrentHistFiller(TConcurrentHistFiller &&other)
+      : fManager(other.fManager), fBinFills(std::move(other.fBinFills)), fReplayFills(std::move(other.fReplayFills)),
+        fStats(other.fStats), fNEntries(other.fNEntries), fHasWeights(other.fHasWeights)
+   {
+      other.fManager = nullptr; // the moved-from filler has nothing left to flush
+   }
+   TConcurrentHistFiller(const TConcurrentHistFiller &) = delete;
+   TConcurrentHistFiller &operator=(const TConcurrentHistFiller &) = delete;
+   ~TConcurrentHistFiller() { Flush(); }
+
+   /// Thread-local equivalent of TH1::Fill(x, w).
+   template <int N = kNDim, std::enable_if_t<N == 1, int> = 0>
+   void Fill(Double_t x, Double_t w = 1.)
+   {
+      FillImpl({{x, 0., 0.}}, w);
+   }
+
+   /// Thread-local equivalent of TH2::Fill(x, y, w).
+   template <int N = kNDim, std::enable_if_t<N == 2, int> = 0>
+   void Fill(Double_t x, Double_t y, Double_t w = 1.)
+   {
+      FillImpl({{x, y, 0.}}, w);
+   }
+
+   /// Thread-local equivalent of TH3::Fill(x, y, z, w).
+   template <int N = kNDim, std::enable_if_t<N == 3, int> = 0>
+   void Fill(Double_t x, Double_t y, Double_t z, Double_t w = 1.)
+   {
+      FillImpl({{x, y, z}}, w);
+   }
+
+   /// Add all buffered fills to the histogram, waiting for the lock if needed.
+   /// A moved-from filler has nothing to flush.
+   void Flush()
+   {
+      if (!fManager)
+         return;
+      std::lock_guard<std::mutex> lock(fManager->fMutex);
+      FlushLocked();
+   }
+};
+
+} // namespace ROOT
+
+#endif // ROOT_TConcurrentHistFill
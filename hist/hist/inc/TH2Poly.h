@@ -63,6 +63,12 @@ class TGraph;
 class TMultiGraph;
 class TPad;
 
+namespace ROOT {
+namespace Internal {
+class TH2PolyBinIndex;
+}
+}
+
 class TH2Poly : public TH2 {
 
 public:
@@ -165,8 +171,11 @@ protected:
    Bool_t   fNewBinAdded;          ///<!For the 3D Painter
    Bool_t   fBinContentChanged;    ///<!For the 3D Painter
    TList   *fBins;                 ///< List of bins. The list owns the contained objects
+   ROOT::Internal::TH2PolyBinIndex *fBinIndex = nullptr; ///<!Spatial index of the bins, built when first needed
 
    void   AddBinToPartition(TH2PolyBin *bin);  // Adds the input bin into the partition matrix
+   TH2PolyBin *FindBinInIndex(Double_t x, Double_t y); // Finds the bin containing (x,y) using the spatial index
+   void   ResetBinIndex();                     // Deletes the spatial index, to be rebuilt when next needed
    void   Initialize(Double_t xlow, Double_t xup, Double_t ylow, Double_t yup, Int_t n, Int_t m);
    Bool_t IsIntersecting(TH2PolyBin *bin, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
    Bool_t IsIntersectingPolygon(Int_t bn, Double_t *x, Double_t *y, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
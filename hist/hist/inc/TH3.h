@@ -61,6 +61,8 @@ protected:
            Int_t    Fill(Double_t,const char*,Double_t) {return Fill(0);} //MayNotUse
            Int_t    Fill(const char*,Double_t,Double_t)  {return Fill(0);} //MayNotUse
            Int_t    Fill(const char*,const char*,Double_t) {return Fill(0);} //MayNotUse
+           void     FillN(Int_t, const Double_t *, const Double_t *, Int_t) override {} //MayNotUse
+           void     FillN(Int_t, const Double_t *, const Double_t *, const Double_t *, Int_t) override {} //MayNotUse
 
            Double_t Interpolate(Double_t x, Double_t y) const override; // May not use
            Double_t Interpolate(Double_t x) const override; // MayNotUse
@@ -87,6 +89,7 @@ public:
    virtual Int_t    Fill(const char *namex, Double_t y, Double_t z, Double_t w);
    virtual Int_t    Fill(Double_t x, const char *namey, Double_t z, Double_t w);
    virtual Int_t    Fill(Double_t x, Double_t y, const char *namez, Double_t w);
+   virtual void     FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride=1);
 
            void     FillRandom(const char *fname, Int_t ntimes=5000, TRandom *rng = nullptr) override;
            void     FillRandom(TH1 *h, Int_t ntimes=5000, TRandom *rng = nullptr) override;
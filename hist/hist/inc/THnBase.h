@@ -102,6 +102,9 @@ protected:
    THnBase* CloneEmpty(const char* name, const char* title,
                        const TObjArray* axes, Bool_t keepTargetAxis) const;
    virtual void Reserve(Long64_t /*nbins*/) {}
+   /// Add the bins of h scaled by c directly from its storage, bypassing the translation through bin coordinates.
+   /// Return kFALSE if the storage of h is not compatible with this one; statistics are not updated.
+   virtual Bool_t AddBinsFromSameStorage(const THnBase* /*h*/, Double_t /*c*/, Bool_t /*haveErrors*/) { return kFALSE; }
    virtual void SetFilledBins(Long64_t /*nbins*/) {};
 
    Bool_t CheckConsistency(const THnBase *h, const char *tag) const;
@@ -180,6 +183,8 @@ protected:
       return -1;
    }
 
+   void FillN(Int_t nev, const Double_t *x, const Double_t *w = nullptr);
+
    virtual void FillBin(Long64_t bin, Double_t w) = 0;
 
    void SetBinEdges(Int_t idim, const Double_t* bins);
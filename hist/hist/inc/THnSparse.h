@@ -21,7 +21,6 @@
 
 
 #include "THnBase.h"
-#include "TExMap.h"
 #include "THnSparse_Internal.h"
 
 // needed only for template instantiations of THnSparseT:
@@ -31,6 +30,9 @@
 #include "TArrayS.h"
 #include "TArrayC.h"
 
+#include <utility>
+#include <vector>
+
 class THnSparseCompactBinCoord;
 
 class THnSparse: public THnBase {
@@ -38,8 +40,7 @@ class THnSparse: public THnBase {
    Int_t      fChunkSize;                   ///<  Number of entries for each chunk
    Long64_t   fFilledBins;                  ///<  Number of filled bins
    TObjArray  fBinContent;                  ///<  Array of THnSparseArrayChunk
-   TExMap     fBins;                        ///<! Filled bins
-   TExMap     fBinsContinued;               ///<! Filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   std::vector<std::pair<ULong64_t, Long64_t>> fBinMap; ///<! Open-addressing table of (hash, bin index + 1) of filled bins
    THnSparseCompactBinCoord *fCompactCoord; ///<! Compact coordinate
 
    THnSparse(const THnSparse&) = delete;
@@ -57,7 +58,9 @@ class THnSparse: public THnBase {
 
    THnSparseArrayChunk* AddChunk();
    void Reserve(Long64_t nbins) override;
-   void FillExMap();
+   void FillBinMap();
+   void ResizeBinMap(Long64_t nbins);
+   void InsertBin(ULong64_t hash, Long64_t linidx);
    virtual TArray* GenerateArray() const = 0;
    Long64_t GetBinIndexForCurrentBin(Bool_t allocate);
 
@@ -69,6 +72,7 @@ class THnSparse: public THnBase {
       FillBinBase(w);
    }
    void InitStorage(Int_t* nbins, Int_t chunkSize) override;
+   Bool_t AddBinsFromSameStorage(const THnBase* h, Double_t c, Bool_t haveErrors) override;
 
  public:
    ~THnSparse() override;
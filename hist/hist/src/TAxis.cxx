@@ -434,6 +434,50 @@ Int_t TAxis::FindFixBin(Double_t x) const
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the bin numbers of n abscissas at once.
+///
+/// \param[in] n number of abscissas
+/// \param[in] x array of abscissas (array size must be n*stride)
+/// \param[out] bins array of at least n bin numbers, filled as TAxis::FindFixBin(x[i*stride]) would
+/// \param[in] stride step size through the array x
+///
+/// The loops have no data-dependent branches, so that the compiler can vectorize them: for fixed bins
+/// the bin is computed with the same arithmetic as FindFixBin and then replaced for out-of-range values, for
+/// variable bins a binary search with a fixed number of steps is done for each abscissa.
+
+void TAxis::FindFixBins(Int_t n, const Double_t *x, Int_t *bins, Int_t stride) const
+{
+   const Double_t xmin = fXmin;
+   const Double_t xmax = fXmax;
+   const Int_t nbins = fNbins;
+   if (!fXbins.fN) {        //*-* fix bins
+      const Double_t width = xmax - xmin;
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i * stride];
+         const bool under = xi < xmin;
+         const bool inRange = !under && xi < xmax; // false for NaN, as in FindFixBin
+         // out-of-range values are replaced so that the conversion to an integer is always well defined
+         const Double_t xr = inRange ? xi : xmin;
+         const Int_t bin = 1 + Int_t(nbins * (xr - xmin) / width);
+         bins[i] = inRange ? bin : (under ? 0 : nbins + 1);
+      }
+   } else {                 //*-* variable bin sizes
+      const Double_t *edges = fXbins.fArray;
+      const Int_t nedges = fXbins.fN;
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i * stride];
+         const bool under = xi < xmin;
+         const bool inRange = !under && xi < xmax;
+         // index of the last edge <= xi, as returned by TMath::BinarySearch
+         Int_t first = 0;
+         for (Int_t len = nedges; len > 1; len -= len / 2)
+            first = edges[first + len / 2] <= xi ? first + len / 2 : first;
+         bins[i] = inRange ? 1 + first : (under ? 0 : nbins + 1);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return label for bin
 
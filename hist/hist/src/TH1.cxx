@@ -17,6 +17,7 @@
 #include <sstream>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 
 #include "TROOT.h"
 #include "TBuffer.h"
@@ -3473,6 +3474,41 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
+
+   if (!fXaxis.CanExtend()) {
+      // the binning cannot change while filling: find the bins of batches of entries at once
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i = 0; i < ntimes; ++i) {
+            if (w[i * stride] != 1.0) {
+               Sumw2();
+               break;
+            }
+         }
+      }
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      constexpr Int_t kBatchSize = 256;
+      Int_t bins[kBatchSize];
+      for (Int_t first = 0; first < ntimes; first += kBatchSize) {
+         const Int_t n = std::min(kBatchSize, ntimes - first);
+         const Double_t *xb = x + first * stride;
+         const Double_t *wb = w ? w + first * stride : nullptr;
+         fXaxis.FindFixBins(n, xb, bins, stride);
+         for (i = 0; i < n; ++i) {
+            bin = bins[i];
+            if (wb) ww = wb[i * stride];
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin, ww);
+            if (!statOverflows && (bin == 0 || bin > nbins)) continue;
+            const Double_t xx = xb[i * stride];
+            fTsumw   += ww;
+            fTsumw2  += ww*ww;
+            fTsumwx  += ww*xx;
+            fTsumwx2 += ww*xx*xx;
+         }
+      }
+      return;
+   }
+
    ntimes *= stride;
    for (i=0;i<ntimes;i+=stride) {
       bin =fXaxis.FindBin(x[i]);
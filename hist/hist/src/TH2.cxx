@@ -28,6 +28,8 @@
 #include "TVirtualHistPainter.h"
 #include "snprintf.h"
 
+#include <algorithm>
+
 ClassImp(TH2);
 
 /** \addtogroup Histograms
@@ -619,6 +621,55 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
    }
 
    Double_t ww = 1;
+   if (!fXaxis.CanExtend() && !fYaxis.CanExtend()) {
+      // the binning cannot change while filling: find the bins of batches of entries at once
+      const Int_t nentries = (ntimes - ifirst) / stride;
+      x += ifirst;
+      y += ifirst;
+      if (w) w += ifirst;
+      fEntries += nentries;
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i = 0; i < nentries; ++i) {
+            if (w[i * stride] != 1.0) {
+               Sumw2();
+               break;
+            }
+         }
+      }
+      const Int_t nbinsx = fXaxis.GetNbins();
+      const Int_t nbinsy = fYaxis.GetNbins();
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      constexpr Int_t kBatchSize = 256;
+      Int_t binsx[kBatchSize], binsy[kBatchSize];
+      for (Int_t first = 0; first < nentries; first += kBatchSize) {
+         const Int_t n = std::min(kBatchSize, nentries - first);
+         const Double_t *xb = x + first * stride;
+         const Double_t *yb = y + first * stride;
+         const Double_t *wb = w ? w + first * stride : nullptr;
+         fXaxis.FindFixBins(n, xb, binsx, stride);
+         fYaxis.FindFixBins(n, yb, binsy, stride);
+         for (i = 0; i < n; ++i) {
+            binx = binsx[i];
+            biny = binsy[i];
+            bin  = biny*(nbinsx+2) + binx;
+            if (wb) ww = wb[i * stride];
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin,ww);
+            if (!statOverflows && (binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy)) continue;
+            const Double_t xx = xb[i * stride];
+            const Double_t yy = yb[i * stride];
+            fTsumw   += ww;
+            fTsumw2  += ww*ww;
+            fTsumwx  += ww*xx;
+            fTsumwx2 += ww*xx*xx;
+            fTsumwy  += ww*yy;
+            fTsumwy2 += ww*yy*yy;
+            fTsumwxy += ww*xx*yy;
+         }
+      }
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       fEntries++;
       binx = fXaxis.FindBin(x[i]);
@@ -16,7 +16,9 @@
 #include "Riostream.h"
 #include "TList.h"
 #include "TMath.h"
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 ClassImp(TH2Poly);
 
@@ -139,8 +141,134 @@ filling, it also adds a constant time delay into the code. When `Fill()`
 is to be called many times, it is more efficient to divide the histogram into
 a large number cells. However, if the histogram is to be filled only a few
 times, it is better to divide into a small number of cells.
+
+## Spatial Index
+With many bins, a partition cell still holds many bins that are all tested one
+by one. `FindBin()` and `Fill()` therefore look bins up in a spatial index
+instead: a bounding volume hierarchy over the bounding boxes of the bins,
+which is built the first time it is needed after bins have been added. Finding
+a bin then only calls `IsInside()` on the few bins whose bounding box contains
+the point, independently of the partition. To fill many points at once, use
+`FillN()`.
 */
 
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Bounding volume hierarchy over the bounding boxes of the bins of a TH2Poly.
+/// Each node holds the bounding box of the bins below it; leaves hold up to
+/// kMaxLeafSize bins. The bins are split at the median of their centers along
+/// the longest side of the bounding box, so the tree is balanced.
+
+class TH2PolyBinIndex {
+   struct TEntry {
+      Double_t fXmin, fXmax, fYmin, fYmax; // Bounding box of the bin
+      TH2PolyBin *fBin;
+   };
+   struct TNode {
+      Double_t fXmin, fXmax, fYmin, fYmax; // Bounding box of the bins below this node
+      Int_t fFirst; // For leaves, first entry of the leaf; for inner nodes, index of the second child
+      Int_t fN;     // For leaves, number of entries of the leaf; 0 for inner nodes, whose first child follows them
+   };
+   static constexpr Int_t kMaxLeafSize = 4;
+
+   std::vector<TEntry> fEntries;
+   std::vector<TNode> fNodes;
+
+   void Build(Int_t first, Int_t last);
+
+public:
+   explicit TH2PolyBinIndex(TList &bins);
+   TH2PolyBin *Find(Double_t x, Double_t y) const;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the index over all bins in the list.
+
+TH2PolyBinIndex::TH2PolyBinIndex(TList &bins)
+{
+   fEntries.reserve(bins.GetSize());
+   TIter next(&bins);
+   while (auto bin = (TH2PolyBin *)next())
+      fEntries.push_back({bin->GetXMin(), bin->GetXMax(), bin->GetYMin(), bin->GetYMax(), bin});
+   fNodes.reserve(2 * fEntries.size() / kMaxLeafSize + 1);
+   if (!fEntries.empty())
+      Build(0, fEntries.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the node for entries [first, last) and, recursively, its children.
+
+void TH2PolyBinIndex::Build(Int_t first, Int_t last)
+{
+   TNode node{fEntries[first].fXmin, fEntries[first].fXmax, fEntries[first].fYmin, fEntries[first].fYmax, first,
+              last - first};
+   for (Int_t i = first + 1; i < last; ++i) {
+      node.fXmin = std::min(node.fXmin, fEntries[i].fXmin);
+      node.fXmax = std::max(node.fXmax, fEntries[i].fXmax);
+      node.fYmin = std::min(node.fYmin, fEntries[i].fYmin);
+      node.fYmax = std::max(node.fYmax, fEntries[i].fYmax);
+   }
+   const Int_t inode = fNodes.size();
+   fNodes.push_back(node);
+   if (last - first <= kMaxLeafSize)
+      return;
+
+   const Bool_t splitX = node.fXmax - node.fXmin >= node.fYmax - node.fYmin;
+   auto lessCenter = [splitX](const TEntry &a, const TEntry &b) {
+      return splitX ? a.fXmin + a.fXmax < b.fXmin + b.fXmax : a.fYmin + a.fYmax < b.fYmin + b.fYmax;
+   };
+   const Int_t middle = first + (last - first) / 2;
+   std::nth_element(fEntries.begin() + first, fEntries.begin() + middle, fEntries.begin() + last, lessCenter);
+
+   fNodes[inode].fN = 0;
+   Build(first, middle);
+   fNodes[inode].fFirst = fNodes.size();
+   Build(middle, last);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the bin with the lowest bin number that contains (x,y), nullptr if
+/// there is none.
+
+TH2PolyBin *TH2PolyBinIndex::Find(Double_t x, Double_t y) const
+{
+   if (fNodes.empty())
+      return nullptr;
+
+   TH2PolyBin *found = nullptr;
+   // the tree is balanced, so its depth is at most log2 of the number of bins
+   Int_t stack[64];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   while (nstack) {
+      const Int_t inode = stack[--nstack];
+      const TNode &node = fNodes[inode];
+      if (x < node.fXmin || x > node.fXmax || y < node.fYmin || y > node.fYmax)
+         continue;
+      if (node.fN) {
+         for (Int_t i = node.fFirst; i < node.fFirst + node.fN; ++i) {
+            const TEntry &e = fEntries[i];
+            if (x < e.fXmin || x > e.fXmax || y < e.fYmin || y > e.fYmax)
+               continue;
+            // overlapping bins: keep the first one that was added, as the partition cells do
+            if (found && e.fBin->GetBinNumber() > found->GetBinNumber())
+               continue;
+            if (e.fBin->IsInside(x, y))
+               found = e.fBin;
+         }
+      } else {
+         stack[nstack++] = node.fFirst; // second child
+         stack[nstack++] = inode + 1;   // first child
+      }
+   }
+   return found;
+}
+
+} // namespace Internal
+} // namespace ROOT
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default Constructor. No boundaries specified.
 
@@ -186,6 +314,7 @@ TH2Poly::~TH2Poly()
    delete[] fCells;
    delete[] fIsEmpty;
    delete[] fCompletelyInside;
+   delete fBinIndex;
    // delete at the end the bin List since it owns the objects
    delete fBins;
 }
@@ -252,6 +381,7 @@ Int_t TH2Poly::AddBin(TObject *poly)
 
    fBins->Add((TObject*) bin);
    SetNewBinAdded(kTRUE);
+   ResetBinIndex();
 
    // Adds the bin to the partition matrix
    AddBinToPartition(bin);
@@ -442,6 +572,8 @@ void TH2Poly::ChangePartition(Int_t n, Int_t m)
    fCellX = n;                          // Set the number of cells
    fCellY = m;                          // Set the number of cells
 
+   ResetBinIndex();
+
    delete [] fCells;                    // Deletes the old partition
 
    // number of cells in the grid
@@ -555,36 +687,36 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
    else if (x > fXaxis.GetXmin()) overflow += -1;
    if (overflow != -5) return overflow;
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) return -5;
+   // If the search does not return a bin, the point must be on "the sea"
+   TH2PolyBin *bin = FindBinInIndex(x, y);
+   return bin ? bin->GetBinNumber() : -5;
+}
 
-   TH2PolyBin *bin;
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the bin containing (x,y), or nullptr if there is none. If several
+/// bins contain (x,y), the one that was added first is returned.
+/// Builds the spatial index of the bins if needed.
 
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
+TH2PolyBin *TH2Poly::FindBinInIndex(Double_t x, Double_t y)
+{
+   if (!fBins) return nullptr;
+   if (!fBinIndex) fBinIndex = new ROOT::Internal::TH2PolyBinIndex(*fBins);
+   return fBinIndex->Find(x, y);
+}
 
-   // Search for the bin in the cell
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      if (bin->IsInside(x,y)) return bin->GetBinNumber();
-   }
+////////////////////////////////////////////////////////////////////////////////
+/// Deletes the spatial index of the bins. It is rebuilt the next time a bin is
+/// looked up; this method is called whenever a bin is added.
 
-   // If the search has not returned a bin, the point must be on "the sea"
-   return -5;
+void TH2Poly::ResetBinIndex()
+{
+   delete fBinIndex;
+   fBinIndex = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment the bin containing (x,y) by 1.
-/// Uses the partitioning algorithm.
+/// Uses the spatial index of the bins.
 
 Int_t TH2Poly::Fill(Double_t x, Double_t y)
 {
@@ -593,7 +725,7 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment the bin containing (x,y) by w.
-/// Uses the partitioning algorithm.
+/// Uses the spatial index of the bins.
 
 Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
 {
@@ -621,52 +753,28 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
       return overflow;
    }
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) {
-      fOverflow[4]+= w;
-      if (fSumw2.fN) fSumw2.fArray[4] += w*w;
-      return -5;
-   }
-
-   TH2PolyBin *bin;
-   Int_t bi;
-
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
+   TH2PolyBin *bin = FindBinInIndex(x, y);
+   if (bin) {
       // needs to account offset in array for overflow bins
-      bi = bin->GetBinNumber()-1+kNOverflow;
-      if (bin->IsInside(x,y)) {
-         bin->Fill(w);
-
-         // Statistics
-         fTsumw   = fTsumw + w;
-         fTsumw2  = fTsumw2 + w*w;
-         fTsumwx  = fTsumwx + w*x;
-         fTsumwx2 = fTsumwx2 + w*x*x;
-         fTsumwy  = fTsumwy + w*y;
-         fTsumwy2 = fTsumwy2 + w*y*y;
-         if (fSumw2.fN) {
-            assert(bi < fSumw2.fN);
-            fSumw2.fArray[bi] += w*w;
-         }
-         fEntries++;
+      Int_t bi = bin->GetBinNumber()-1+kNOverflow;
+      bin->Fill(w);
+
+      // Statistics
+      fTsumw   = fTsumw + w;
+      fTsumw2  = fTsumw2 + w*w;
+      fTsumwx  = fTsumwx + w*x;
+      fTsumwx2 = fTsumwx2 + w*x*x;
+      fTsumwy  = fTsumwy + w*y;
+      fTsumwy2 = fTsumwy2 + w*y*y;
+      if (fSumw2.fN) {
+         assert(bi < fSumw2.fN);
+         fSumw2.fArray[bi] += w*w;
+      }
+      fEntries++;
 
-         SetBinContentChanged(kTRUE);
+      SetBinContentChanged(kTRUE);
 
-         return bin->GetBinNumber();
-      }
+      return bin->GetBinNumber();
    }
 
    fOverflow[4]+= w;
@@ -705,14 +813,17 @@ Int_t TH2Poly::Fill(const char* name, Double_t w)
 ///                      (array size must be ntimes*stride)
 /// \param [in] x:       array of x values to be histogrammed
 /// \param [in] y:       array of y values to be histogrammed
-/// \param [in] w:       array of weights
+/// \param [in] w:       array of weights; if null, each entry has a weight of 1
 /// \param [in] stride:  step size through arrays x, y and w
+///
+/// The spatial index of the bins is built once, by the first entry.
 
 void TH2Poly::FillN(Int_t ntimes, const Double_t* x, const Double_t* y,
                                const Double_t* w, Int_t stride)
 {
+   ntimes *= stride;
    for (int i = 0; i < ntimes; i += stride) {
-      Fill(x[i], y[i], w[i]);
+      Fill(x[i], y[i], w ? w[i] : 1.);
    }
 }
 
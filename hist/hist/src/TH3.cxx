@@ -25,6 +25,8 @@
 #include "TMath.h"
 #include "TObjString.h"
 
+#include <algorithm>
+
 ClassImp(TH3);
 
 /** \addtogroup Histograms
@@ -767,6 +769,106 @@ Int_t TH3::Fill(Double_t x, Double_t y, const char *namez, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x:       array of x values to be histogrammed
+///  - y:       array of y values to be histogrammed
+///  - z:       array of z values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+///   - If the weight is not equal to 1, the storage of the sum of squares of
+///     weights is automatically triggered and the sum of the squares of weights is incremented
+///     by w[i]^2 in the bin corresponding to x[i],y[i],z[i].
+///   - If w is NULL each entry is assumed a weight=1
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t i;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         BufferFill(x[i], y[i], z[i], w ? w[i] : 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==0)
+         ifirst = i;
+      else
+         return;
+   }
+
+   if (fXaxis.CanExtend() || fYaxis.CanExtend() || fZaxis.CanExtend()) {
+      for (i=ifirst;i<ntimes;i+=stride)
+         Fill(x[i], y[i], z[i], w ? w[i] : 1.);
+      return;
+   }
+
+   // the binning cannot change while filling: find the bins of batches of entries at once
+   const Int_t nentries = (ntimes - ifirst) / stride;
+   x += ifirst;
+   y += ifirst;
+   z += ifirst;
+   if (w) w += ifirst;
+   fEntries += nentries;
+   if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+      for (i = 0; i < nentries; ++i) {
+         if (w[i * stride] != 1.0) {
+            Sumw2();
+            break;
+         }
+      }
+   }
+   const Int_t nbinsx = fXaxis.GetNbins();
+   const Int_t nbinsy = fYaxis.GetNbins();
+   const Int_t nbinsz = fZaxis.GetNbins();
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   constexpr Int_t kBatchSize = 256;
+   Int_t binsx[kBatchSize], binsy[kBatchSize], binsz[kBatchSize];
+   Double_t ww = 1;
+   for (Int_t first = 0; first < nentries; first += kBatchSize) {
+      const Int_t n = std::min(kBatchSize, nentries - first);
+      const Double_t *xb = x + first * stride;
+      const Double_t *yb = y + first * stride;
+      const Double_t *zb = z + first * stride;
+      const Double_t *wb = w ? w + first * stride : nullptr;
+      fXaxis.FindFixBins(n, xb, binsx, stride);
+      fYaxis.FindFixBins(n, yb, binsy, stride);
+      fZaxis.FindFixBins(n, zb, binsz, stride);
+      for (i = 0; i < n; ++i) {
+         const Int_t binx = binsx[i];
+         const Int_t biny = binsy[i];
+         const Int_t binz = binsz[i];
+         const Int_t bin  = binx + (nbinsx+2)*(biny + (nbinsy+2)*binz);
+         if (wb) ww = wb[i * stride];
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (!statOverflows && (binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy || binz == 0 || binz > nbinsz))
+            continue;
+         const Double_t xx = xb[i * stride];
+         const Double_t yy = yb[i * stride];
+         const Double_t zz = zb[i * stride];
+         fTsumw   += ww;
+         fTsumw2  += ww*ww;
+         fTsumwx  += ww*xx;
+         fTsumwx2 += ww*xx*xx;
+         fTsumwy  += ww*yy;
+         fTsumwy2 += ww*yy*yy;
+         fTsumwxy += ww*xx*yy;
+         fTsumwz  += ww*zz;
+         fTsumwz2 += ww*zz*zz;
+         fTsumwxz += ww*xx*zz;
+         fTsumwyz += ww*yy*zz;
+      }
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill histogram following distribution in function fname.
 ///
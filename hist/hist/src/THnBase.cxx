@@ -31,6 +31,9 @@
 #include "Math/MinimizerOptions.h"
 #include "Math/WrappedMultiTF1.h"
 
+#include <algorithm>
+#include <vector>
+
 
 /** \class THnBase
     \ingroup Hist
@@ -727,6 +730,36 @@ void THnBase::Scale(Double_t c)
    SetEntries(nEntries);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram with nev entries.
+///
+/// \param[in] nev number of entries
+/// \param[in] x array of nev * GetNdimensions() values: the coordinates of the first entry, then of the second one...
+/// \param[in] w array of nev weights; if null each entry has a weight of 1
+///
+/// Equivalent to calling Fill(x + i * GetNdimensions(), w[i]) for each entry, but the bins of batches of entries
+/// are found at once for each axis, see TAxis::FindFixBins().
+
+void THnBase::FillN(Int_t nev, const Double_t *x, const Double_t *w /*= nullptr*/)
+{
+   constexpr Int_t kBatchSize = 256;
+   std::vector<Int_t> bins(kBatchSize * fNdimensions);
+   std::vector<Int_t> coord(fNdimensions);
+   for (Int_t first = 0; first < nev; first += kBatchSize) {
+      const Int_t n = std::min(kBatchSize, nev - first);
+      const Double_t *xb = x + (Long64_t)first * fNdimensions;
+      for (Int_t d = 0; d < fNdimensions; ++d)
+         GetAxis(d)->FindFixBins(n, xb + d, &bins[d * kBatchSize], fNdimensions);
+      for (Int_t i = 0; i < n; ++i) {
+         for (Int_t d = 0; d < fNdimensions; ++d)
+            coord[d] = bins[d * kBatchSize + i];
+         const Double_t ww = w ? w[first + i] : 1.;
+         UpdateXStat(xb + (Long64_t)i * fNdimensions, ww);
+         FillBin(GetBin(coord.data(), kTRUE /*alloc*/), ww);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add() implementation for both rebinned histograms and those with identical
 /// binning. See THnBase::Add().
@@ -743,44 +776,47 @@ void THnBase::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
       Sumw2();
    Bool_t haveErrors = GetCalculateErrors();
 
-   Double_t* x = 0;
-   if (rebinned) {
-      x = new Double_t[fNdimensions];
-   }
-   Int_t* coord = new Int_t[fNdimensions];
-
-   // Expand the exmap if needed, to reduce collisions
-   Long64_t numTargetBins = GetNbins() + h->GetNbins();
-   Reserve(numTargetBins);
-
-   Long64_t i = 0;
-   THnIter iter(h);
-   // Add to this whatever is found inside the other histogram
-   while ((i = iter.Next(coord)) >= 0) {
-      // Get the content of the bin from the second histogram
-      Double_t v = h->GetBinContent(i);
-
-      Long64_t mybinidx = -1;
+   // with identical binning, bins can possibly be copied without going through their coordinates
+   if (rebinned || !AddBinsFromSameStorage(h, c, haveErrors)) {
+      Double_t* x = 0;
       if (rebinned) {
-         // Get the bin center given a coord
-         for (Int_t j = 0; j < fNdimensions; ++j)
-            x[j] = h->GetAxis(j)->GetBinCenter(coord[j]);
-
-         mybinidx = GetBin(x, kTRUE /* allocate*/);
-      } else {
-         mybinidx = GetBin(coord, kTRUE /*allocate*/);
+         x = new Double_t[fNdimensions];
       }
+      Int_t* coord = new Int_t[fNdimensions];
+
+      // Expand the bin map if needed, to reduce collisions
+      Long64_t numTargetBins = GetNbins() + h->GetNbins();
+      Reserve(numTargetBins);
+
+      Long64_t i = 0;
+      THnIter iter(h);
+      // Add to this whatever is found inside the other histogram
+      while ((i = iter.Next(coord)) >= 0) {
+         // Get the content of the bin from the second histogram
+         Double_t v = h->GetBinContent(i);
+
+         Long64_t mybinidx = -1;
+         if (rebinned) {
+            // Get the bin center given a coord
+            for (Int_t j = 0; j < fNdimensions; ++j)
+               x[j] = h->GetAxis(j)->GetBinCenter(coord[j]);
+
+            mybinidx = GetBin(x, kTRUE /* allocate*/);
+         } else {
+            mybinidx = GetBin(coord, kTRUE /*allocate*/);
+         }
 
-      if (haveErrors) {
-         Double_t err2 = h->GetBinError2(i) * c * c;
-         AddBinError2(mybinidx, err2);
+         if (haveErrors) {
+            Double_t err2 = h->GetBinError2(i) * c * c;
+            AddBinError2(mybinidx, err2);
+         }
+         // only _after_ error calculation, or sqrt(v) is taken into account!
+         AddBinContent(mybinidx, c * v);
       }
-      // only _after_ error calculation, or sqrt(v) is taken into account!
-      AddBinContent(mybinidx, c * v);
-   }
 
-   delete [] coord;
-   delete [] x;
+      delete [] coord;
+      delete [] x;
+   }
 
    // add also the statistics
    fTsumw += c * h->fTsumw;
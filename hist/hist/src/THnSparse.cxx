@@ -17,6 +17,19 @@
 #include "TDataType.h"
 
 namespace {
+////////////////////////////////////////////////////////////////////////////////
+/// Mix the bits of a bin hash to find its slot in the bin map. Small compact
+/// coordinates are their own hash, so their low bits only depend on the first
+/// axes and cannot be used as slot index directly.
+
+inline ULong64_t GetBinMapSlot(ULong64_t hash, ULong64_t mask)
+{
+   hash ^= hash >> 33;
+   hash *= 0xff51afd7ed558ccdULL;
+   hash ^= hash >> 33;
+   return hash & mask;
+}
+
 //______________________________________________________________________________
 //
 // THnSparseBinIter iterates over all filled bins of a THnSparse.
@@ -318,9 +331,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for the bin map.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the bin map's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -570,14 +583,17 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+This hash is used to lookup the linear index in the open-addressing hash table
+fBinMap, a flat array of (hash, linear index) pairs that is kept at most half
+full and is probed linearly. The probe continues until an empty slot is found
+or until an entry with the same hash is found whose coordinates match the
+coordinates passed to GetBin(); the coordinates only need to be compared if the
+compact bin coordinates are larger than 8 bytes, as only then two different
+coordinates can have the same hash.
+
+Bins can be filled in bulk with THnBase::FillN(). Adding or merging
+histograms with the same binning copies the compact coordinates of the filled
+bins directly, without translating them to and from n-dimensional coordinates.
 */
 
 
@@ -650,49 +666,72 @@ void THnSparse::InitStorage(Int_t* nbins, Int_t chunkSize)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///We have been streamed; set up fBins
+///We have been streamed; set up fBinMap
 
-void THnSparse::FillExMap()
+void THnSparse::FillBinMap()
 {
    TIter iChunk(&fBinContent);
    THnSparseArrayChunk* chunk = 0;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   ResizeBinMap(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         InsertBin(compactCoord.GetHashFromBuffer(buf), idx);
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Make sure fBinMap can hold nbins while staying at most half full, rehashing
+/// the bins it already contains if it needs to grow.
+
+void THnSparse::ResizeBinMap(Long64_t nbins)
+{
+   ULong64_t size = 16;
+   while (size < 3 * (ULong64_t)nbins)
+      size *= 2;
+   if (size <= fBinMap.size())
+      return;
+
+   std::vector<std::pair<ULong64_t, Long64_t>> oldMap(size, {0, 0});
+   fBinMap.swap(oldMap);
+   const ULong64_t mask = size - 1;
+   for (const auto &entry : oldMap) {
+      if (!entry.second)
+         continue;
+      ULong64_t slot = GetBinMapSlot(entry.first, mask);
+      while (fBinMap[slot].second)
+         slot = (slot + 1) & mask;
+      fBinMap[slot] = entry;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bin with linear index linidx and the given hash to fBinMap, which
+/// must have a free slot.
+
+void THnSparse::InsertBin(ULong64_t hash, Long64_t linidx)
+{
+   const ULong64_t mask = fBinMap.size() - 1;
+   ULong64_t slot = GetBinMapSlot(hash, mask);
+   while (fBinMap[slot].second)
+      slot = (slot + 1) & mask;
+   // we store idx+1, 0 is "empty slot"
+   fBinMap[slot] = std::make_pair(hash, linidx + 1);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
-      FillExMap();
-   }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
+   if (fBinMap.empty() && GetNChunks()) {
+      FillBinMap();
    }
+   ResizeBinMap(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -790,19 +829,18 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 {
    THnSparseCompactBinCoord* cc = GetCompactCoord();
    ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
-      FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
-
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
-
-      linidx = nextlinidx;
+   if (fBinMap.empty() && GetNChunks())
+      FillBinMap();
+   if (!fBinMap.empty()) {
+      const ULong64_t mask = fBinMap.size() - 1;
+      for (ULong64_t slot = GetBinMapSlot(hash, mask); fBinMap[slot].second; slot = (slot + 1) & mask) {
+         if (fBinMap[slot].first != hash)
+            continue;
+         // fBinMap stores index + 1!
+         const Long64_t linidx = fBinMap[slot].second - 1;
+         if (GetChunk(linidx / fChunkSize)->Matches(linidx % fChunkSize, cc->GetBuffer()))
+            return linidx;
+      }
    }
    if (!allocate) return -1;
 
@@ -819,19 +857,47 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   if (2 * (ULong64_t)(newidx + 1) > fBinMap.size())
+      ResizeBinMap(newidx + 1);
+   InsertBin(hash, newidx);
    return newidx;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add the filled bins of h scaled by c if h is a THnSparse with the same
+/// number of bins on each axis: their compact coordinates are then identical,
+/// and are looked up directly in this histogram.
+
+Bool_t THnSparse::AddBinsFromSameStorage(const THnBase* h, Double_t c, Bool_t haveErrors)
+{
+   const THnSparse* hs = dynamic_cast<const THnSparse*>(h);
+   if (!hs)
+      return kFALSE;
+   for (Int_t d = 0; d < fNdimensions; ++d) {
+      if (GetAxis(d)->GetNbins() != hs->GetAxis(d)->GetNbins())
+         return kFALSE;
+   }
+
+   Reserve(GetNbins() + hs->GetNbins());
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   const Int_t singleCoordSize = cc->GetBufferSize();
+   for (Int_t iChunk = 0; iChunk < hs->GetNChunks(); ++iChunk) {
+      const THnSparseArrayChunk* chunk = hs->GetChunk(iChunk);
+      const Int_t nbins = chunk->GetEntries();
+      for (Int_t i = 0; i < nbins; ++i) {
+         cc->SetBuffer(chunk->fCoordinates + i * singleCoordSize);
+         const Long64_t mybinidx = GetBinIndexForCurrentBin(kTRUE);
+         const Double_t v = chunk->fContent->GetAt(i);
+         if (haveErrors) {
+            const Double_t err2 = chunk->fSumw2 ? chunk->fSumw2->GetAt(i) : v;
+            AddBinError2(mybinidx, err2 * c * c);
+         }
+         AddBinContent(mybinidx, c * v);
+      }
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return THnSparseCompactBinCoord object.
 
@@ -880,7 +946,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += sizeof(std::pair<ULong64_t, Long64_t>) * fBinMap.size();
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -962,8 +1028,7 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   std::vector<std::pair<ULong64_t, Long64_t>>().swap(fBinMap);
    fBinContent.Delete();
    ResetBase(option);
 }
@@ -15,6 +15,7 @@
 #include "TF1.h"
 #include "THLimitsFinder.h"
 #include <iostream>
+#include <algorithm>
 #include "TError.h"
 #include "TClass.h"
 #include "TObjString.h"
@@ -790,6 +791,48 @@ void TProfile::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const D
          return;
    }
 
+   if (!fXaxis.CanExtend()) {
+      // the binning cannot change while filling: find the bins of batches of entries at once
+      const Int_t nentries = (ntimes - ifirst) / stride;
+      x += ifirst;
+      y += ifirst;
+      if (w) w += ifirst;
+      const Int_t nbins = fXaxis.GetNbins();
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      constexpr Int_t kBatchSize = 256;
+      Int_t bins[kBatchSize];
+      for (Int_t first = 0; first < nentries; first += kBatchSize) {
+         const Int_t n = std::min(kBatchSize, nentries - first);
+         const Double_t *xb = x + first * stride;
+         const Double_t *yb = y + first * stride;
+         const Double_t *wb = w ? w + first * stride : nullptr;
+         fXaxis.FindFixBins(n, xb, bins, stride);
+         for (i = 0; i < n; ++i) {
+            const Double_t xx = xb[i * stride];
+            const Double_t yy = yb[i * stride];
+            if (fYmin != fYmax) {
+               if (yy <fYmin || yy> fYmax || TMath::IsNaN(yy)) continue;
+            }
+            const Double_t u = wb ? wb[i * stride] : 1;
+            fEntries++;
+            bin = bins[i];
+            AddBinContent(bin, u*yy);
+            fSumw2.fArray[bin] += u*yy*yy;
+            if (!fBinSumw2.fN && u != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();  // must be called before accumulating the entries
+            if (fBinSumw2.fN)  fBinSumw2.fArray[bin] += u*u;
+            fBinEntries.fArray[bin] += u;
+            if (!statOverflows && (bin == 0 || bin > nbins)) continue;
+            fTsumw   += u;
+            fTsumw2  += u*u;
+            fTsumwx  += u*xx;
+            fTsumwx2 += u*xx*xx;
+            fTsumwy  += u*yy;
+            fTsumwy2 += u*yy*yy;
+         }
+      }
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       if (fYmin != fYmax) {
          if (y[i] <fYmin || y[i]> fYmax || TMath::IsNaN(y[i])) continue;
@@ -1,8 +1,13 @@
 #include "gtest/gtest.h"
 
 #include "THn.h"
+#include "THnSparse.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "TList.h"
+
+#include <memory>
+#include <vector>
 
 // Filling THn
 TEST(THn, Fill) {
@@ -111,3 +116,120 @@ TEST(THn, Projection) {
    }
 
 }
+
+namespace {
+// deterministic, widely spread coordinates of the i-th entry, including under/overflows
+void SparseCoords(Int_t i, Int_t ndim, Double_t *x)
+{
+   for (Int_t d = 0; d < ndim; ++d)
+      x[d] = -0.05 + 1.1 * ((i * (2 * d + 7) + d * 13) % 1009) / 1008.;
+}
+} // namespace
+
+// Bins are found again after the bin map has grown, also for compact coordinates larger than 8 bytes
+TEST(THnSparse, FillAndFind) {
+   for (Int_t nbinsPerAxis : {10, 1000}) {
+      const Int_t ndim = 8;
+      std::vector<Int_t> bins(ndim, nbinsPerAxis);
+      std::vector<Double_t> xmin(ndim, 0.), xmax(ndim, 1.);
+      THnSparseD hs("hs", "hs", ndim, bins.data(), xmin.data(), xmax.data(), 100);
+      hs.Sumw2();
+      std::vector<Double_t> x(ndim);
+      const Int_t nentries = 5000;
+      for (Int_t i = 0; i < nentries; ++i) {
+         SparseCoords(i, ndim, x.data());
+         hs.Fill(x.data(), 1. + i % 3);
+      }
+      EXPECT_DOUBLE_EQ(nentries, hs.GetEntries());
+      Double_t sum = 0.;
+      for (Long64_t b = 0; b < hs.GetNbins(); ++b)
+         sum += hs.GetBinContent(b);
+      EXPECT_DOUBLE_EQ(hs.GetWeightSum(), sum);
+
+      for (Int_t i = 0; i < nentries; ++i) {
+         SparseCoords(i, ndim, x.data());
+         const Long64_t bin = static_cast<const THnSparse &>(hs).GetBin(x.data());
+         ASSERT_GE(bin, 0);
+         EXPECT_GE(hs.GetBinContent(bin), 1. + i % 3);
+      }
+      x.assign(ndim, 0.5);
+      x[0] = -1.;
+      x[1] = 2.;
+      EXPECT_EQ(-1, static_cast<const THnSparse &>(hs).GetBin(x.data()));
+   }
+}
+
+TEST(THnSparse, FillN) {
+   const Int_t ndim = 5;
+   std::vector<Int_t> bins(ndim, 20);
+   std::vector<Double_t> xmin(ndim, 0.), xmax(ndim, 1.);
+   THnSparseD ref("ref", "ref", ndim, bins.data(), xmin.data(), xmax.data());
+   THnSparseD hs("hs", "hs", ndim, bins.data(), xmin.data(), xmax.data());
+   ref.Sumw2();
+   hs.Sumw2();
+
+   const Int_t nentries = 1000;
+   std::vector<Double_t> x(nentries * ndim), w(nentries);
+   for (Int_t i = 0; i < nentries; ++i) {
+      SparseCoords(i, ndim, &x[i * ndim]);
+      w[i] = 0.5 * (i % 4);
+      ref.Fill(&x[i * ndim], w[i]);
+   }
+   hs.FillN(nentries, x.data(), w.data());
+
+   EXPECT_EQ(ref.GetNbins(), hs.GetNbins());
+   EXPECT_DOUBLE_EQ(ref.GetEntries(), hs.GetEntries());
+   EXPECT_DOUBLE_EQ(ref.GetWeightSum(), hs.GetWeightSum());
+   std::vector<Int_t> coord(ndim);
+   for (Long64_t b = 0; b < ref.GetNbins(); ++b) {
+      const Double_t v = ref.GetBinContent(b, coord.data());
+      const Long64_t hsbin = static_cast<const THnSparse &>(hs).GetBin(coord.data());
+      ASSERT_GE(hsbin, 0);
+      EXPECT_DOUBLE_EQ(v, hs.GetBinContent(hsbin));
+      EXPECT_DOUBLE_EQ(ref.GetBinError2(b), hs.GetBinError2(hsbin));
+   }
+}
+
+// Adding histograms with the same binning goes through the compact coordinates, with different binning through
+// the bin centers: both must give the same result
+TEST(THnSparse, AddAndMerge) {
+   const Int_t ndim = 6;
+   std::vector<Int_t> bins(ndim, 50);
+   std::vector<Double_t> xmin(ndim, 0.), xmax(ndim, 1.);
+   THnSparseD h1("h1", "h1", ndim, bins.data(), xmin.data(), xmax.data());
+   THnSparseD h2("h2", "h2", ndim, bins.data(), xmin.data(), xmax.data());
+   THnSparseF h2f("h2f", "h2f", ndim, bins.data(), xmin.data(), xmax.data());
+   h2.Sumw2();
+   std::vector<Double_t> x(ndim);
+   for (Int_t i = 0; i < 2000; ++i) {
+      SparseCoords(i, ndim, x.data());
+      h1.Fill(x.data());
+      SparseCoords(3 * i + 1, ndim, x.data());
+      h2.Fill(x.data(), 2.);
+      h2f.Fill(x.data(), 2.);
+   }
+
+   std::unique_ptr<THnSparse> sum(static_cast<THnSparse *>(h1.Clone("sum")));
+   sum->Add(&h2, 0.5);
+   std::unique_ptr<THnSparse> rebinnedSum(static_cast<THnSparse *>(h1.Clone("rebinnedSum")));
+   rebinnedSum->RebinnedAdd(&h2, 0.5);
+   TList list;
+   list.Add(&h2f);
+   std::unique_ptr<THnSparse> merged(static_cast<THnSparse *>(h1.Clone("merged")));
+   merged->Merge(&list);
+
+   EXPECT_EQ(rebinnedSum->GetNbins(), sum->GetNbins());
+   EXPECT_EQ(rebinnedSum->GetNbins(), merged->GetNbins());
+   std::vector<Int_t> coord(ndim);
+   for (Long64_t b = 0; b < rebinnedSum->GetNbins(); ++b) {
+      const Double_t v = rebinnedSum->GetBinContent(b, coord.data());
+      const Long64_t sumbin = static_cast<const THnSparse &>(*sum).GetBin(coord.data());
+      ASSERT_GE(sumbin, 0);
+      EXPECT_DOUBLE_EQ(v, sum->GetBinContent(sumbin));
+      EXPECT_DOUBLE_EQ(rebinnedSum->GetBinError2(b), sum->GetBinError2(sumbin));
+      const Long64_t mergedbin = static_cast<const THnSparse &>(*merged).GetBin(coord.data());
+      ASSERT_GE(mergedbin, 0);
+      EXPECT_DOUBLE_EQ(h1.GetBinContent(coord.data()) + h2f.GetBinContent(coord.data()),
+                       merged->GetBinContent(mergedbin));
+   }
+}
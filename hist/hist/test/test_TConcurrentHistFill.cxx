@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/TConcurrentHistFill.hxx"
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TH3D.h"
+#include "TProfile.h"
+
+#include <cmath>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+// fill `ref` sequentially and `h` from nThreads threads with the same values
+template <typename HIST, typename Fill>
+void FillBoth(HIST &ref, HIST &h, Fill fill, unsigned int nThreads = 4, int nPerThread = 10000)
+{
+   for (auto t = 0u; t < nThreads; ++t) {
+      for (int i = 0; i < nPerThread; ++i)
+         fill(ref, t, i);
+   }
+
+   ROOT::TConcurrentHistFill<HIST> manager(h, 100);
+   std::vector<std::thread> threads;
+   for (auto t = 0u; t < nThreads; ++t) {
+      threads.emplace_back([&manager, &fill, t, nPerThread] {
+         auto filler = manager.MakeFiller();
+         for (int i = 0; i < nPerThread; ++i)
+            fill(filler, t, i);
+      });
+   }
+   for (auto &t : threads)
+      t.join();
+}
+
+void ExpectEqualHistos(const TH1 &ref, const TH1 &h)
+{
+   EXPECT_DOUBLE_EQ(ref.GetEntries(), h.GetEntries());
+   for (int i = 0; i < ref.GetNcells(); ++i) {
+      EXPECT_DOUBLE_EQ(ref.GetBinContent(i), h.GetBinContent(i));
+      EXPECT_DOUBLE_EQ(ref.GetBinError(i), h.GetBinError(i));
+   }
+   Double_t refStats[TH1::kNstat] = {};
+   Double_t stats[TH1::kNstat] = {};
+   ref.GetStats(refStats);
+   h.GetStats(stats);
+   for (int i = 0; i < 11; ++i)
+      EXPECT_NEAR(refStats[i], stats[i], 1e-6 * std::abs(refStats[i]));
+}
+} // namespace
+
+TEST(TConcurrentHistFill, TH1D)
+{
+   TH1D ref("ref", "ref", 20, 0, 1);
+   TH1D h("h", "h", 20, 0, 1);
+   // includes under/overflows and weights
+   FillBoth(ref, h, [](auto &hist, unsigned int t, int i) { hist.Fill(-0.1 + i * 1e-4, t + 1.); });
+   ExpectEqualHistos(ref, h);
+   EXPECT_GT(h.GetSumw2N(), 0);
+}
+
+TEST(TConcurrentHistFill, TH2D)
+{
+   TH2D ref("ref", "ref", 10, 0, 1, 10, 0, 1);
+   TH2D h("h", "h", 10, 0, 1, 10, 0, 1);
+   FillBoth(ref, h, [](auto &hist, unsigned int t, int i) { hist.Fill(i * 1e-4, t * 0.3); });
+   ExpectEqualHistos(ref, h);
+}
+
+TEST(TConcurrentHistFill, TH3D)
+{
+   TH3D ref("ref", "ref", 5, 0, 1, 5, 0, 1, 5, 0, 1);
+   TH3D h("h", "h", 5, 0, 1, 5, 0, 1, 5, 0, 1);
+   FillBoth(ref, h, [](auto &hist, unsigned int t, int i) { hist.Fill(i * 1e-4, t * 0.3, (i % 7) * 0.15, 0.5); });
+   ExpectEqualHistos(ref, h);
+}
+
+TEST(TConcurrentHistFill, ExtendableAxis)
+{
+   TH1D ref("ref", "ref", 10, 0, 1);
+   TH1D h("h", "h", 10, 0, 1);
+   ref.SetCanExtend(TH1::kAllAxes);
+   h.SetCanExtend(TH1::kAllAxes);
+   // the axis is extended while filling: fills are replayed under the lock
+   FillBoth(ref, h, [](auto &hist, unsigned int t, int i) { hist.Fill(i * 1e-3 * (t + 1)); });
+   EXPECT_EQ(ref.GetNbinsX(), h.GetNbinsX());
+   ExpectEqualHistos(ref, h);
+}
+
+TEST(TConcurrentHistFill, Flush)
+{
+   TH1D h("h", "h", 10, 0, 1);
+   ROOT::TConcurrentHistFill<TH1D> manager(h);
+   auto filler = manager.MakeFiller();
+   filler.Fill(0.5);
+   EXPECT_EQ(h.GetEntries(), 0.); // buffered
+   filler.Flush();
+   EXPECT_EQ(h.GetEntries(), 1.);
+   EXPECT_EQ(h.GetBinContent(6), 1.);
+
+   // the buffered fills move with the filler, the moved-from one has nothing left to flush
+   filler.Fill(0.5);
+   auto moved = std::move(filler);
+   filler.Flush();
+   EXPECT_EQ(h.GetEntries(), 1.);
+   moved.Flush();
+   EXPECT_EQ(h.GetEntries(), 2.);
+}
+
+TEST(TConcurrentHistFill, OverflowOnlyFirstFlush)
+{
+   TH1D ref("ref", "ref", 10, 0, 1);
+   TH1D h("h", "h", 10, 0, 1);
+   ROOT::TConcurrentHistFill<TH1D> manager(h);
+   auto filler = manager.MakeFiller();
+   ref.Fill(1.5);
+   filler.Fill(1.5);
+   filler.Flush();
+   // the histogram now has entries but no in-range statistics, from which
+   // TH1::GetStats recomputes them: the next flush must not count its bins twice
+   ref.Fill(0.25);
+   ref.Fill(0.75);
+   filler.Fill(0.25);
+   filler.Fill(0.75);
+   filler.Flush();
+   ExpectEqualHistos(ref, h);
+   EXPECT_DOUBLE_EQ(h.GetMean(), 0.5);
+}
+
+TEST(TConcurrentHistFill, Profile)
+{
+   TProfile p("p", "p", 10, 0, 1);
+   EXPECT_THROW(ROOT::TConcurrentHistFill<TProfile>{p}, std::invalid_argument);
+}
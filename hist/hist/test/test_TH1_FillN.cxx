@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+
+#include "TAxis.h"
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TH3D.h"
+#include "TProfile.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+// values spanning the axis ranges used below, including under/overflows, bin edges and NaN
+std::vector<double> MakeValues(int n)
+{
+   std::vector<double> v;
+   for (int i = 0; i < n; ++i)
+      v.push_back(-0.2 + 1.4 * (i % 97) / 96.);
+   v.push_back(0.);
+   v.push_back(1.);
+   v.push_back(0.25);
+   v.push_back(std::numeric_limits<double>::quiet_NaN());
+   v.push_back(std::numeric_limits<double>::infinity());
+   v.push_back(-std::numeric_limits<double>::infinity());
+   return v;
+}
+
+void ExpectEqualHistos(const TH1 &ref, const TH1 &h)
+{
+   EXPECT_EQ(ref.GetEntries(), h.GetEntries());
+   EXPECT_EQ(ref.GetSumw2N(), h.GetSumw2N());
+   for (int i = 0; i < ref.GetNcells(); ++i) {
+      EXPECT_DOUBLE_EQ(ref.GetBinContent(i), h.GetBinContent(i)) << "bin " << i;
+      EXPECT_DOUBLE_EQ(ref.GetBinError(i), h.GetBinError(i)) << "bin " << i;
+   }
+   Double_t refStats[TH1::kNstat] = {};
+   Double_t stats[TH1::kNstat] = {};
+   ref.GetStats(refStats);
+   h.GetStats(stats);
+   for (int i = 0; i < TH1::kNstat; ++i)
+      EXPECT_DOUBLE_EQ(refStats[i], stats[i]) << "stat " << i;
+}
+} // namespace
+
+TEST(TAxis, FindFixBins)
+{
+   const auto values = MakeValues(1000);
+   const double edges[] = {0., 0.1, 0.25, 0.3, 0.7, 1.};
+   for (const TAxis &axis : {TAxis(7, 0., 1.), TAxis(5, edges)}) {
+      std::vector<Int_t> bins(values.size());
+      axis.FindFixBins(values.size(), values.data(), bins.data());
+      for (std::size_t i = 0; i < values.size(); ++i)
+         EXPECT_EQ(axis.FindFixBin(values[i]), bins[i]) << "x = " << values[i];
+
+      // every other value
+      axis.FindFixBins(values.size() / 2, values.data(), bins.data(), 2);
+      for (std::size_t i = 0; i < values.size() / 2; ++i)
+         EXPECT_EQ(axis.FindFixBin(values[2 * i]), bins[i]);
+   }
+}
+
+TEST(TH1, FillNMatchesFill)
+{
+   const auto x = MakeValues(1000);
+   std::vector<double> w(x.size());
+   for (std::size_t i = 0; i < w.size(); ++i)
+      w[i] = 0.5 + (i % 3);
+
+   const double edges[] = {0., 0.1, 0.25, 0.3, 0.7, 1.};
+   TH1D fixRef("fixRef", "", 7, 0, 1), fix("fix", "", 7, 0, 1);
+   TH1D varRef("varRef", "", 5, edges), var("var", "", 5, edges);
+   for (std::size_t i = 0; i < x.size(); ++i) {
+      fixRef.Fill(x[i], w[i]);
+      varRef.Fill(x[i], w[i]);
+   }
+   fix.FillN(x.size(), x.data(), w.data());
+   var.FillN(x.size(), x.data(), w.data());
+   ExpectEqualHistos(fixRef, fix);
+   ExpectEqualHistos(varRef, var);
+
+   // unweighted, with a stride
+   TH1D strideRef("strideRef", "", 7, 0, 1), stride("stride", "", 7, 0, 1);
+   for (std::size_t i = 0; i < x.size(); i += 3)
+      strideRef.Fill(x[i]);
+   stride.FillN(x.size() / 3 + (x.size() % 3 ? 1 : 0), x.data(), nullptr, 3);
+   ExpectEqualHistos(strideRef, stride);
+   EXPECT_EQ(stride.GetSumw2N(), 0);
+}
+
+TEST(TH2, FillNMatchesFill)
+{
+   const auto x = MakeValues(1000);
+   std::vector<double> y(x.rbegin(), x.rend());
+   TH2D ref("ref", "", 7, 0, 1, 4, 0, 1), h("h", "", 7, 0, 1, 4, 0, 1);
+   for (std::size_t i = 0; i < x.size(); ++i)
+      ref.Fill(x[i], y[i]);
+   h.FillN(x.size(), x.data(), y.data(), nullptr);
+   ExpectEqualHistos(ref, h);
+}
+
+TEST(TH3, FillNMatchesFill)
+{
+   const auto x = MakeValues(1000);
+   std::vector<double> y(x.rbegin(), x.rend());
+   std::vector<double> w(x.size(), 2.);
+   TH3D ref("ref", "", 7, 0, 1, 4, 0, 1, 3, 0, 1), h("h", "", 7, 0, 1, 4, 0, 1, 3, 0, 1);
+   for (std::size_t i = 0; i < x.size(); ++i)
+      ref.Fill(x[i], y[i], x[i] * y[i], w[i]);
+   std::vector<double> z(x.size());
+   for (std::size_t i = 0; i < x.size(); ++i)
+      z[i] = x[i] * y[i];
+   h.FillN(x.size(), x.data(), y.data(), z.data(), w.data());
+   ExpectEqualHistos(ref, h);
+}
+
+TEST(TProfile, FillNMatchesFill)
+{
+   const auto x = MakeValues(1000);
+   std::vector<double> y(x.size());
+   for (std::size_t i = 0; i < y.size(); ++i)
+      y[i] = 0.1 * (i % 7);
+   TProfile ref("ref", "", 7, 0, 1), h("h", "", 7, 0, 1);
+   for (std::size_t i = 0; i < x.size(); ++i)
+      ref.Fill(x[i], y[i]);
+   h.FillN(x.size(), x.data(), y.data(), nullptr);
+   ExpectEqualHistos(ref, h);
+}
@@ -0,0 +1,103 @@
+// test TH2Poly bin lookup through the spatial index of the bins
+
+#include "gtest/gtest.h"
+
+#include "TBufferFile.h"
+#include "TH2Poly.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+namespace {
+// bin number of the first bin containing (x,y), -5 if none, by testing all bins
+Int_t FindBinBruteForce(TH2Poly &h2p, Double_t x, Double_t y)
+{
+   for (Int_t bin = 1; bin <= h2p.GetNumberOfBins(); ++bin) {
+      if (h2p.IsInsideBin(bin, x, y))
+         return bin;
+   }
+   return -5;
+}
+} // namespace
+
+TEST(TH2Poly, FindBinHoneycomb)
+{
+   TH2Poly h2p("h2p", "h2p", 0, 100, 0, 100);
+   h2p.Honeycomb(0, 0, 1, 50, 50);
+   ASSERT_EQ(2500, h2p.GetNumberOfBins());
+
+   TRandom3 rng(1);
+   for (int i = 0; i < 10000; ++i) {
+      const Double_t x = rng.Uniform(0, 100);
+      const Double_t y = rng.Uniform(0, 100);
+      EXPECT_EQ(FindBinBruteForce(h2p, x, y), h2p.FindBin(x, y)) << "x = " << x << ", y = " << y;
+   }
+}
+
+TEST(TH2Poly, FindBinOverlappingBins)
+{
+   TH2Poly h2p("h2p", "h2p", 0, 10, 0, 10);
+   h2p.AddBin(2, 2, 6, 6);
+   h2p.AddBin(0, 0, 4, 4);
+   EXPECT_EQ(2, h2p.FindBin(1, 1));
+   // both bins contain the point: the first one wins
+   EXPECT_EQ(1, h2p.FindBin(3, 3));
+   EXPECT_EQ(-5, h2p.FindBin(8, 8));
+   EXPECT_EQ(-1, h2p.FindBin(-1, 11));
+
+   // adding a bin invalidates the index
+   h2p.AddBin(7, 7, 9, 9);
+   EXPECT_EQ(3, h2p.FindBin(8, 8));
+}
+
+TEST(TH2Poly, FindBinAfterStreamerRead)
+{
+   TH2Poly src("src", "src", 0, 10, 0, 10);
+   src.AddBin(5, 5, 10, 10);
+   TBufferFile buf(TBuffer::kWrite);
+   src.Streamer(buf);
+
+   TH2Poly h2p("h2p", "h2p", 0, 10, 0, 10);
+   h2p.AddBin(0, 0, 5, 5);
+   // builds the index of the current bins
+   EXPECT_EQ(1, h2p.FindBin(1, 1));
+   EXPECT_EQ(-5, h2p.FindBin(8, 8));
+
+   // reading replaces the bins, the index must be rebuilt from the new ones
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   h2p.Streamer(buf);
+   ASSERT_EQ(1, h2p.GetNumberOfBins());
+   EXPECT_EQ(-5, h2p.FindBin(1, 1));
+   EXPECT_EQ(1, h2p.FindBin(8, 8));
+}
+
+TEST(TH2Poly, FillN)
+{
+   TH2Poly h2p("h2p", "h2p", 0, 10, 0, 10);
+   TH2Poly ref("ref", "ref", 0, 10, 0, 10);
+   for (int i = 0; i < 10; ++i) {
+      for (int j = 0; j < 10; ++j) {
+         h2p.AddBin(i, j, i + 1, j + 1);
+         ref.AddBin(i, j, i + 1, j + 1);
+      }
+   }
+
+   TRandom3 rng(2);
+   std::vector<Double_t> xy;
+   for (int i = 0; i < 1000; ++i) {
+      xy.push_back(rng.Uniform(-1, 11));
+      xy.push_back(rng.Uniform(-1, 11));
+   }
+   // x and y interleaved in the same array
+   h2p.FillN(1000, &xy[0], &xy[1], nullptr, 2);
+   for (int i = 0; i < 1000; ++i)
+      ref.Fill(xy[2 * i], xy[2 * i + 1]);
+
+   EXPECT_EQ(ref.GetEntries(), h2p.GetEntries());
+   for (Int_t bin = -9; bin <= ref.GetNumberOfBins(); ++bin) {
+      if (bin == 0)
+         continue;
+      EXPECT_EQ(ref.GetBinContent(bin), h2p.GetBinContent(bin)) << "bin " << bin;
+   }
+}
@@ -16,9 +16,13 @@
 #ifndef ROOT7_RHistImpl
 #define ROOT7_RHistImpl
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <cstddef>
 #include <functional>
+#include <tuple>
+#include <vector>
 #include "ROOT/RSpan.hxx"
 #include "ROOT/RTupleApply.hxx"
 
@@ -680,6 +684,90 @@ struct RFindLocalBins {
    }
 };
 
+/// Find the local bin indices on axis `IAXIS` of a batch of `n` coordinates, writing them to
+/// `localBins[i][IAXIS]`. Generic version, calling `FindBin()` for each coordinate.
+template <class AXIS>
+struct RFindAxisBinsN {
+   template <int IAXIS, typename BINS, typename COORD>
+   void Find(BINS *localBins, const AXIS &axis, const COORD *coords, std::size_t n) const
+   {
+      for (std::size_t i = 0; i < n; ++i)
+         localBins[i][IAXIS] = axis.FindBin(coords[i][IAXIS]);
+   }
+};
+
+/// Equidistant axes: the bin is computed arithmetically, without branches, such that the compiler can
+/// vectorize the loop. Gives the same result as `RAxisEquidistant::FindBin()`; NaN goes to the underflow bin.
+template <>
+struct RFindAxisBinsN<RAxisEquidistant> {
+   template <int IAXIS, typename BINS, typename COORD>
+   void Find(BINS *localBins, const RAxisEquidistant &axis, const COORD *coords, std::size_t n) const
+   {
+      const double low = axis.GetMinimum();
+      const double invBinWidth = axis.GetInverseBinWidth();
+      const double overflow = axis.GetLastBin() + 1;
+      for (std::size_t i = 0; i < n; ++i) {
+         // the 1-based bin, clamped such that the conversion to int is always defined
+         const double rawbin = std::min(std::max(0., (coords[i][IAXIS] - low) * invBinWidth + 1.), overflow);
+         const int bin = static_cast<int>(rawbin);
+         localBins[i][IAXIS] = rawbin < 1. ? RAxisBase::kUnderflowBin
+                               : (rawbin >= overflow ? RAxisBase::kOverflowBin : bin);
+      }
+   }
+};
+
+/// Irregular axes: branch-free binary search in the bin borders. Gives the same result as
+/// `RAxisIrregular::FindBin()`, i.e. that of `std::lower_bound()` on the bin borders.
+template <>
+struct RFindAxisBinsN<RAxisIrregular> {
+   template <int IAXIS, typename BINS, typename COORD>
+   void Find(BINS *localBins, const RAxisIrregular &axis, const COORD *coords, std::size_t n) const
+   {
+      const std::vector<double> &borders = axis.GetBinBorders();
+      if (borders.empty()) {
+         RFindAxisBinsN<RAxisBase>().template Find<IAXIS>(localBins, axis, coords, n);
+         return;
+      }
+      const double *first = borders.data();
+      const int lastBin = axis.GetLastBin();
+      for (std::size_t i = 0; i < n; ++i) {
+         const double x = coords[i][IAXIS];
+         const double *base = first;
+         for (std::size_t len = borders.size(); len > 1;) {
+            const std::size_t half = len / 2;
+            base = base[half] < x ? base + half : base;
+            len -= half;
+         }
+         // number of bin borders smaller than x
+         const int rawbin = (base - first) + (*base < x);
+         localBins[i][IAXIS] =
+            rawbin < 1 ? RAxisBase::kUnderflowBin : (rawbin > lastBin ? RAxisBase::kOverflowBin : rawbin);
+      }
+   }
+};
+
+/// Find the per-axis local bin indices of a batch of `n` coordinates, one axis at a time, such that the
+/// axis type is resolved once per batch and the per-axis kernels of `RFindAxisBinsN` can be used.
+template <int I, int NDIMS, typename BINS, typename COORD, class AXES>
+struct RFindLocalBinsN;
+
+template <int NDIMS, typename BINS, typename COORD, class AXES>
+struct RFindLocalBinsN<-1, NDIMS, BINS, COORD, AXES> {
+   void operator()(BINS * /*localBins*/, const AXES & /*axes*/, const COORD * /*coords*/, std::size_t /*n*/) const
+   {}
+};
+
+template <int I, int NDIMS, typename BINS, typename COORD, class AXES>
+struct RFindLocalBinsN {
+   void operator()(BINS *localBins, const AXES &axes, const COORD *coords, std::size_t n) const
+   {
+      constexpr const int thisAxis = NDIMS - I - 1;
+      using Axis_t = typename std::tuple_element<thisAxis, AXES>::type;
+      RFindAxisBinsN<Axis_t>().template Find<thisAxis>(localBins, std::get<thisAxis>(axes), coords, n);
+      RFindLocalBinsN<I - 1, NDIMS, BINS, COORD, AXES>()(localBins, axes, coords, n);
+   }
+};
+
 /// Recursively converts local axis bins from the standard `kUnderflowBin`/`kOverflowBin` for
 /// under/overflow bin indexing convention, to the corresponding bin coordinates.
 template <int I, int NDIMS, typename BINS, typename COORD, class AXES>
@@ -1058,9 +1146,7 @@ public:
       }
 #endif
 
-      for (size_t i = 0; i < xN.size(); ++i) {
-         Fill(xN[i], weightN[i]);
-      }
+      FillBatches(xN, weightN.data());
    }
 
    /// Fill an array of `weightN` to the bins specified by coordinates `xN`.
@@ -1068,8 +1154,24 @@ public:
    /// at the coordinate `xN[i]`
    void FillN(const std::span<const CoordArray_t> xN) final
    {
-      for (auto &&x: xN) {
-         Fill(x);
+      FillBatches(xN, nullptr);
+   }
+
+   /// Fill the coordinates `xN` with weights `weightN` (or 1 if `nullptr`) in batches: the local bins of
+   /// a whole batch are found axis by axis through `RFindLocalBinsN`, then the weights are added to the
+   /// corresponding global bins. Equivalent to calling `Fill()` for each coordinate.
+   void FillBatches(const std::span<const CoordArray_t> xN, const Weight_t *weightN)
+   {
+      constexpr std::size_t kBatchSize = 256;
+      std::array<BinArray_t, kBatchSize> localBins;
+      for (std::size_t begin = 0; begin < xN.size(); begin += kBatchSize) {
+         const std::size_t n = std::min(kBatchSize, xN.size() - begin);
+         Internal::RFindLocalBinsN<DATA::GetNDim() - 1, DATA::GetNDim(), BinArray_t, CoordArray_t, decltype(fAxes)>()(
+            localBins.data(), fAxes, xN.data() + begin, n);
+         for (std::size_t i = 0; i < n; ++i) {
+            const int bin = ComputeGlobalBin<DATA::GetNDim()>(localBins[i]);
+            this->GetStat().Fill(xN[begin + i], bin, weightN ? weightN[begin + i] : Weight_t(1.));
+         }
       }
    }
 
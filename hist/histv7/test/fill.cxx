@@ -629,3 +629,40 @@ TEST(HistFillTest, FillN3DCoordsWeightsUncertainty)
    EXPECT_FLOAT_EQ(std::sqrt(weight2 * weight2), hist.GetBinUncertainty({0.2222, 4.33, 7.11}));
    EXPECT_FLOAT_EQ(std::sqrt((weight3 * weight3) + (weight2 * weight2)), hist.GetBinUncertainty({0.3333, 4.11, 7.22}));
 }
+
+// Test that FillN(), which finds the bins in batches, fills the same bins as Fill(),
+// including under- and overflows and coordinates on bin borders, for more than one batch
+TEST(HistFillTest, FillNBatchesSameAsFill)
+{
+   using namespace ROOT::Experimental;
+   RH2D hist({{10, 0., 1.}, {{0., 1., 2., 3., 10.}}});
+   RH2D ref({{10, 0., 1.}, {{0., 1., 2., 3., 10.}}});
+   RH2D histW({{10, 0., 1.}, {{0., 1., 2., 3., 10.}}});
+   RH2D refW({{10, 0., 1.}, {{0., 1., 2., 3., 10.}}});
+
+   std::vector<RH2D::CoordArray_t> coords;
+   std::vector<double> weights;
+   for (int i = 0; i < 1000; ++i) {
+      coords.push_back({-0.15 + i * 0.0013, -1. + (i % 13)});
+      weights.push_back(0.5 + i % 3);
+   }
+   coords.push_back({1., 10.});
+   weights.push_back(1.);
+   coords.push_back({0.5, 3.});
+   weights.push_back(1.);
+
+   hist.FillN(coords);
+   histW.FillN(coords, weights);
+   for (std::size_t i = 0; i < coords.size(); ++i) {
+      ref.Fill(coords[i]);
+      refW.Fill(coords[i], weights[i]);
+   }
+
+   EXPECT_EQ(ref.GetEntries(), hist.GetEntries());
+   EXPECT_EQ(refW.GetEntries(), histW.GetEntries());
+   for (const auto &x : coords) {
+      EXPECT_DOUBLE_EQ(ref.GetBinContent(x), hist.GetBinContent(x));
+      EXPECT_DOUBLE_EQ(refW.GetBinContent(x), histW.GetBinContent(x));
+      EXPECT_DOUBLE_EQ(refW.GetBinUncertainty(x), histW.GetBinUncertainty(x));
+   }
+}
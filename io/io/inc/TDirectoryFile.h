@@ -29,6 +29,16 @@
 class TKey;
 class TFile;
 
+class TDirectoryFile;
+
+namespace ROOT {
+namespace Internal {
+class TDirectoryKeyTable;
+/// Number of keys of `dir` that exist as TKey objects (for testing their creation on demand).
+Int_t GetNKeysCreated(const TDirectoryFile &dir);
+}
+}
+
 class TDirectoryFile : public TDirectory {
 
 protected:
@@ -44,12 +54,20 @@ protected:
    Long64_t    fSeekKeys{0};             ///< Location of Keys record on file
    TFile      *fFile{nullptr};           ///< Pointer to current file in memory
    TList      *fKeys{nullptr};           ///< Pointer to keys list in memory
+   ROOT::Internal::TDirectoryKeyTable *fKeyTable{nullptr}; ///<! Keys read from the file whose TKey is not in fKeys yet, if any
 
    void        CleanTargets();
+   void        LoadKeys(const char *name = nullptr) const;
+   TKey       *LookupKey(const char *name, Short_t cycle, Bool_t exactCycle, const char *where) const;
    void        InitDirectoryFile(TClass *cl = nullptr);
    void        BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir);
 
 private:
+   friend class TKey;
+   friend Int_t ROOT::Internal::GetNKeysCreated(const TDirectoryFile &dir);
+
+   void        RemoveKey(TKey *key);
+
    TDirectoryFile(const TDirectoryFile &directory) = delete;  //Directories cannot be copied
    void operator=(const TDirectoryFile &) = delete; //Directories cannot be copied
 
@@ -91,10 +109,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
            TFile      *GetFile() const override { return fFile; }
            TKey       *GetKey(const char *name, Short_t cycle=9999) const override;
-           TList      *GetListOfKeys() const override { return fKeys; }
+           TList      *GetListOfKeys() const override;
    const TDatime      &GetModificationDate() const { return fDatimeM; }
            Int_t       GetNbytesKeys() const override { return fNbytesKeys; }
-           Int_t       GetNkeys() const override { return fKeys->GetSize(); }
+           Int_t       GetNkeys() const override;
            Long64_t    GetSeekDir() const override { return fSeekDir; }
            Long64_t    GetSeekParent() const override { return fSeekParent; }
            Long64_t    GetSeekKeys() const override { return fSeekKeys; }
@@ -109,6 +127,7 @@ public:
            void        ReadAll(Option_t *option="") override;
            Int_t       ReadKeys(Bool_t forceRead=kTRUE) override;
            Int_t       ReadTObject(TObject *obj, const char *keyname) override;
+           TObject    *Remove(TObject *obj) override;
    virtual void        ResetAfterMerge(TFileMergeInfo *);
            void        rmdir(const char *name) override;
            void        Save() override;
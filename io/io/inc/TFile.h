@@ -36,8 +36,10 @@
 
 #ifdef R__USE_IMT
 #include "ROOT/TRWSpinLock.hxx"
-#include <mutex>
 #endif
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 
 class TMap;
@@ -51,9 +53,17 @@ class TProcessID;
 class TStopwatch;
 class TFilePrefetch;
 
+namespace ROOT {
+namespace Internal {
+class TTreeCacheReadAhead;
+}
+}
+
 class TFile : public TDirectoryFile {
   friend class TDirectoryFile;
   friend class TFilePrefetch;
+  friend class TFileCacheWrite;
+  friend class ROOT::Internal::TTreeCacheReadAhead;
 // TODO: We need to make sure only one TBasket is being written at a time
 // if we are writing multiple baskets in parallel.
 #ifdef R__USE_IMT
@@ -111,13 +121,25 @@ protected:
    TUrl             fUrl;                     ///<!URL of file
 
    TList           *fInfoCache{nullptr};      ///<!Cached list of the streamer infos in this file
+   Bool_t           fInfoCacheShared{kFALSE}; ///<!True if fInfoCache is shared with the files having the same StreamerInfo record
+   ROOT::Internal::RConcurrentHashColl::HashValue fInfoHash; ///<!Hash of the StreamerInfo record read by ReadStreamerInfo, if any
    TList           *fOpenPhases{nullptr};     ///<!Time info about open phases
 
    bool             fGlobalRegistration = true; ///<! if true, bypass use of global lists
+   Bool_t           fConcurrentRead{kFALSE};  ///<!True if the file is read by several threads at once (option READ_CONCURRENT)
+   mutable std::recursive_mutex fConcurrentReadMutex; ///<!Lock of the state shared by the threads reading the file concurrently
+
+   /// State of a file read concurrently which is specific to a thread: each
+   /// thread has its own position, used by Seek and ReadBuffer, and its own
+   /// default read cache.
+   struct RConcurrentReadState {
+      Long64_t        fOffset{0};             ///< Position of the next read, including the archive offset
+      TFileCacheRead *fCacheRead{nullptr};    ///< Default read cache
+   };
+   mutable std::unordered_map<std::thread::id, RConcurrentReadState> fConcurrentReadStates; ///<!States of the threads reading the file concurrently, guarded by fConcurrentReadMutex
 
 #ifdef R__USE_IMT
    std::mutex                                 fWriteMutex;  ///<!Lock for writing baskets / keys into the file.
-   static ROOT::Internal::RConcurrentHashColl fgTsSIHashes; ///<!TS Set of hashes built from read streamer infos
 #endif
 
    static TList    *fgAsyncOpenRequests; //List of handles for pending open requests
@@ -138,6 +160,8 @@ protected:
    virtual EAsyncOpenStatus GetAsyncOpenStatus() { return fAsyncOpenStatus; }
    virtual void        Init(Bool_t create);
            Bool_t      FlushWriteCache();
+           RConcurrentReadState &GetConcurrentReadState() const;
+           std::unique_lock<std::recursive_mutex> LockConcurrentRead() const;
            Int_t       ReadBufferViaCache(char *buf, Int_t len);
            Int_t       WriteBufferViaCache(const char *buf, Int_t len);
 
@@ -175,6 +199,7 @@ private:
    void operator=(const TFile &) = delete;
 
    static  void        CpProgress(Long64_t bytesread, Long64_t size, TStopwatch &watch);
+           void        ResetInfoCache();
    static  TFile      *OpenFromCache(const char *name, Option_t * = "",
                                      const char *ftitle = "", Int_t compress = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault,
                                      Int_t netopt = 0);
@@ -242,7 +267,7 @@ public:
    virtual Int_t       GetNbytesInfo() const {return fNbytesInfo;}
    virtual Int_t       GetNbytesFree() const {return fNbytesFree;}
    virtual TString     GetNewUrl() { return ""; }
-           Long64_t    GetRelOffset() const { return fOffset - fArchiveOffset; }
+           Long64_t    GetRelOffset() const;
    virtual Long64_t    GetSeekFree() const {return fSeekFree;}
    virtual Long64_t    GetSeekInfo() const {return fSeekInfo;}
    virtual Long64_t    GetSize() const;
@@ -251,6 +276,7 @@ public:
    virtual void        IncrementProcessIDs() { fNProcessIDs++; }
    virtual Bool_t      IsArchive() const { return fIsArchive; }
            Bool_t      IsBinary() const { return TestBit(kBinaryFile); }
+           Bool_t      IsConcurrentRead() const { return fConcurrentRead; }
            Bool_t      IsRaw() const { return !fIsRootFile; }
    virtual Bool_t      IsOpen() const;
            void        ls(Option_t *option="") const override;
@@ -16,6 +16,12 @@
 
 class TFile;
 
+namespace ROOT {
+namespace Internal {
+class TFileWriteBehind;
+}
+}
+
 class TFileCacheWrite : public TObject {
 
 protected:
@@ -25,6 +31,9 @@ protected:
    TFile        *fFile;           ///< Pointer to file
    char         *fBuffer;         ///< [fBufferSize] buffer of contiguous prefetched blocks
    Bool_t        fRecursive;      ///< flag to avoid recursive calls
+   ROOT::Internal::TFileWriteBehind *fWriteBehind; ///<! Writes the flushed buffers in the background, if enabled
+
+   Bool_t        CheckAsync();
 
 private:
    TFileCacheWrite(const TFileCacheWrite &) = delete;            //cannot be copied
@@ -35,11 +44,15 @@ public:
    TFileCacheWrite(TFile *file, Int_t buffersize);
    ~TFileCacheWrite() override;
    virtual Bool_t      Flush();
-   virtual Int_t       GetBytesInCache() const { return fNtot; }
+   virtual Int_t       GetBytesInCache() const;
+           Long64_t    GetMaxBytesInFlight() const;
+           Bool_t      IsAsync() const { return fWriteBehind != nullptr; }
            void        Print(Option_t *option="") const override;
    virtual Int_t       ReadBuffer(char *buf, Long64_t pos, Int_t len);
    virtual Int_t       WriteBuffer(const char *buf, Long64_t pos, Int_t len);
+           Bool_t      SetAsync(Long64_t maxBytesInFlight);
    virtual void        SetFile(TFile *file);
+           Bool_t      Sync();
 
    ClassDefOverride(TFileCacheWrite,1)  //TFile cache when writing
 };
@@ -56,6 +56,7 @@ protected:
            void     Build(TDirectory* motherDir, const char* classname, Long64_t filepos);
            void     Reset(); // Currently only for the use of TBasket.
    virtual Int_t    WriteFileKeepBuffer(TFile *f = nullptr);
+           Bool_t   ReadFileToBuffer(char *buffer) const;
 
  public:
    TKey();
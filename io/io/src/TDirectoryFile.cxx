@@ -24,9 +24,13 @@ End_Macro
 */
 
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "Strlen.h"
 #include "strlcpy.h"
 #include "TDirectoryFile.h"
+#include "TDirectoryKeyTable.h"
 #include "TFile.h"
 #include "TBufferFile.h"
 #include "TBufferJSON.h"
@@ -177,6 +181,7 @@ void TDirectoryFile::InitDirectoryFile(TClass *cl)
 
 TDirectoryFile::~TDirectoryFile()
 {
+   SafeDelete(fKeyTable);
    if (fKeys) {
       fKeys->Delete("slow");
       SafeDelete(fKeys);
@@ -206,12 +211,19 @@ TDirectoryFile::~TDirectoryFile()
 ///
 /// If replace is true:
 ///   remove any existing objects with the same same (if the name is not ""
+///
+/// For a file read concurrently, the list of objects is updated under the lock
+/// of the file, since the threads add the objects they read to it (e.g. a TTree
+/// read from a key) and remove them when deleting them.
 
 void TDirectoryFile::Append(TObject *obj, Bool_t replace /* = kFALSE */)
 {
    if (!obj || !fList) return;
 
-   TDirectory::Append(obj,replace);
+   {
+      auto lock = fFile ? fFile->LockConcurrentRead() : std::unique_lock<std::recursive_mutex>();
+      TDirectory::Append(obj,replace);
+   }
 
    if (!fMother) return;
    if (fMother->IsA() == TMapFile::Class()) {
@@ -233,6 +245,7 @@ Int_t TDirectoryFile::AppendKey(TKey *key)
    fModified = kTRUE;
 
    key->SetMotherDir(this);
+   LoadKeys();
 
    // This is a fast hash lookup in case the key does not already exist
    TKey *oldkey = (TKey*)fKeys->FindObject(key->GetName());
@@ -266,6 +279,7 @@ void TDirectoryFile::Browse(TBrowser *b)
       TObject *obj = nullptr;
       TIter nextin(fList);
       TKey *key = nullptr, *keyo = nullptr;
+      LoadKeys();
       TIter next(fKeys);
 
       cd();
@@ -588,6 +602,7 @@ void TDirectoryFile::Close(Option_t *option)
    }
 
    // Delete keys from key list (but don't delete the list header)
+   SafeDelete(fKeyTable);
    if (fKeys) {
       fKeys->Delete("slow");
    }
@@ -801,20 +816,9 @@ TKey *TDirectoryFile::FindKeyAny(const char *keyname) const
 
    DecodeNameCycle(keyname, name, cycle, kMaxLen);
 
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
-   if (!listOfKeys) {
-      Error("FindKeyAny", "Unexpected type of TDirectoryFile::fKeys!");
-      return nullptr;
-   }
-
-   if (const TList *keyList = listOfKeys->GetListForObject(name)) {
-      for (auto key: TRangeDynCast<TKey>(*keyList)) {
-         if (key && !strcmp(key->GetName(), name)
-             && (cycle == 9999 || cycle >= key->GetCycle())) {
-            const_cast<TDirectoryFile*>(this)->cd(); // may be we should not make cd ???
-            return key;
-         }
-      }
+   if (TKey *key = LookupKey(name, cycle, kFALSE, "FindKeyAny")) {
+      const_cast<TDirectoryFile*>(this)->cd(); // may be we should not make cd ???
+      return key;
    }
 
    //try with subdirectories
@@ -853,20 +857,8 @@ TObject *TDirectoryFile::FindObjectAny(const char *aname) const
 
    DecodeNameCycle(aname, name, cycle, kMaxLen);
 
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
-   if (!listOfKeys) {
-      Error("FindObjectAny", "Unexpected type of TDirectoryFile::fKeys!");
-      return nullptr;
-   }
-
-   if (const TList *keyList = listOfKeys->GetListForObject(name)) {
-      for (auto key: TRangeDynCast<TKey>(*keyList)) {
-         if (key && !strcmp(key->GetName(), name)
-             && (cycle == 9999 || cycle >= key->GetCycle())) {
-            return key->ReadObj();
-         }
-      }
-   }
+   if (TKey *key = LookupKey(name, cycle, kFALSE, "FindObjectAny"))
+      return key->ReadObj();
 
    //try with subdirectories
    TIter next(GetListOfKeys());
@@ -955,7 +947,11 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 
 //*-*---------------------Case of Object in memory---------------------
 //                        ========================
-   TObject *idcur = fList ? fList->FindObject(namobj) : nullptr;
+   TObject *idcur = nullptr;
+   if (fList) {
+      auto lock = fFile ? fFile->LockConcurrentRead() : std::unique_lock<std::recursive_mutex>();
+      idcur = fList->FindObject(namobj);
+   }
    if (idcur) {
       if (idcur==this && strlen(namobj)!=0) {
          // The object has the same name has the directory and
@@ -974,20 +970,9 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
-   if (!listOfKeys) {
-      Error("Get", "Unexpected type of TDirectoryFile::fKeys!");
-      return nullptr;
-   }
-
-   if (const TList *keyList = listOfKeys->GetListForObject(namobj)) {
-      for (auto key: TRangeDynCast<TKey>(*keyList)) {
-         if (key && !strcmp(key->GetName(), namobj)
-             && (cycle == 9999 || cycle == key->GetCycle())) {
-            TDirectory::TContext ctxt(this);
-            return key->ReadObj();
-         }
-      }
+   if (TKey *key = LookupKey(namobj, cycle, kTRUE, "Get")) {
+      TDirectory::TContext ctxt(this);
+      return key->ReadObj();
    }
 
    return nullptr;
@@ -1075,7 +1060,11 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 //*-*---------------------Case of Object in memory---------------------
 //                        ========================
    if (expectedClass==0 || expectedClass->IsTObject()) {
-      TObject *objcur = fList ? fList->FindObject(namobj) : nullptr;
+      TObject *objcur = nullptr;
+      if (fList) {
+         auto lock = fFile ? fFile->LockConcurrentRead() : std::unique_lock<std::recursive_mutex>();
+         objcur = fList->FindObject(namobj);
+      }
       if (objcur) {
          if (objcur==this && strlen(namobj)!=0) {
             // The object has the same name has the directory and
@@ -1097,20 +1086,9 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
-   if (!listOfKeys) {
-      Error("GetObjectChecked", "Unexpected type of TDirectoryFile::fKeys!");
-      return nullptr;
-   }
-
-   if (const TList *keyList = listOfKeys->GetListForObject(namobj)) {
-      for (auto key: TRangeDynCast<TKey>(*keyList)) {
-         if (key && !strcmp(key->GetName(), namobj)
-             && (cycle == 9999 || cycle == key->GetCycle())) {
-            TDirectory::TContext ctxt(this);
-            return key->ReadObjectAny(expectedClass);
-         }
-      }
+   if (TKey *key = LookupKey(namobj, cycle, kTRUE, "GetObjectChecked")) {
+      TDirectory::TContext ctxt(this);
+      return key->ReadObjectAny(expectedClass);
    }
 
    return nullptr;
@@ -1138,16 +1116,95 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
 {
    if (!fKeys) return nullptr;
 
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   return LookupKey(name, cycle, kFALSE, "GetKey");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of keys of this directory, creating the TKey objects that
+/// were not looked up yet.
+
+TList *TDirectoryFile::GetListOfKeys() const
+{
+   auto lock = fFile ? fFile->LockConcurrentRead() : std::unique_lock<std::recursive_mutex>();
+   LoadKeys();
+   return fKeys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of `dir` whose TKey object exists: all of them,
+/// unless they are created on demand (see TDirectoryFile::LoadKeys).
+
+Int_t ROOT::Internal::GetNKeysCreated(const TDirectoryFile &dir)
+{
+   return dir.fKeys ? dir.fKeys->GetSize() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of this directory, without creating them.
+
+Int_t TDirectoryFile::GetNkeys() const
+{
+   auto lock = fFile ? fFile->LockConcurrentRead() : std::unique_lock<std::recursive_mutex>();
+   return fKeyTable ? fKeyTable->GetNkeys() : fKeys->GetSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the TKey objects of the keys record read by ReadKeys that were not
+/// created yet and add them to fKeys: only the ones with the given name, if any,
+/// otherwise all of them, keeping the order of the record.
+///
+/// The keys record of a directory that can not be modified is only indexed
+/// by ReadKeys, such that opening a file with a large number of keys does not
+/// pay for creating a TKey for each of them.
+
+void TDirectoryFile::LoadKeys(const char *name) const
+{
+   if (!fKeyTable)
+      return;
+
+   auto self = const_cast<TDirectoryFile *>(this);
+   std::vector<TKey *> keys;
+   if (name) {
+      fKeyTable->FindKeys(name, self, keys);
+      for (auto key : keys)
+         fKeys->Add(key);
+      if (fKeyTable->GetNCreated() < fKeyTable->GetNkeys())
+         return;
+      keys.clear();
+   }
+   // Put all the keys in the order of the record.
+   fKeyTable->CreateKeys(self, keys);
+   fKeys->Clear("nodelete");
+   for (auto key : keys)
+      fKeys->Add(key);
+   SafeDelete(self->fKeyTable);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the key named `name`, creating it if it was not looked up yet: the
+/// one with the given cycle, the one with the highest cycle if cycle is 9999
+/// or, unless exactCycle, the one with the highest cycle not above cycle.
+/// `where` is the name of the calling method, for the error messages.
+///
+/// The keys of a file read concurrently (option READ_CONCURRENT) are looked up
+/// under the lock of the file, such that several threads can look up keys of
+/// the same directory. The object of the key is read by the caller, after the
+/// lock is released.
+
+TKey *TDirectoryFile::LookupKey(const char *name, Short_t cycle, Bool_t exactCycle, const char *where) const
+{
+   auto lock = fFile ? fFile->LockConcurrentRead() : std::unique_lock<std::recursive_mutex>();
+   LoadKeys(name);
+   auto listOfKeys = dynamic_cast<THashList *>(fKeys);
    if (!listOfKeys) {
-      Error("GetKey", "Unexpected type of TDirectoryFile::fKeys!");
+      Error(where, "Unexpected type of TDirectoryFile::fKeys!");
       return nullptr;
    }
 
    if (const TList *keyList = listOfKeys->GetListForObject(name)) {
       for (auto key: TRangeDynCast<TKey>(*keyList)) {
          if (key && !strcmp(key->GetName(), name)
-             && (cycle == 9999 || cycle >= key->GetCycle())) {
+             && (cycle == 9999 || (exactCycle ? cycle == key->GetCycle() : cycle >= key->GetCycle()))) {
             return key;
          }
       }
@@ -1156,6 +1213,18 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
    return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove a key being deleted from the list of keys, without creating the
+/// keys not looked up yet.
+
+void TDirectoryFile::RemoveKey(TKey *key)
+{
+   if (fKeyTable)
+      fKeyTable->Forget(key);
+   if (fKeys)
+      fKeys->Remove(key);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// List Directory contents
 ///
@@ -1204,6 +1273,7 @@ void TDirectoryFile::ls(Option_t *option) const
    }
 
    if (diskobj && fKeys) {
+      LoadKeys();
       //*-* Loop on all the keys
       TObjLink *lnk = fKeys->FirstLink();
       while (lnk) {
@@ -1385,6 +1455,7 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
    char *buffer;
    if (forceRead) {
+      SafeDelete(fKeyTable);
       fKeys->Delete();
       //In case directory was updated by another process, read new
       //position for the keys
@@ -1419,7 +1490,23 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
    Int_t nkeys = 0;
    Long64_t fsize = fFile->GetSize();
-   if ( fSeekKeys >  0) {
+   if (fSeekKeys > 0 && !fFile->IsWritable()) {
+      // The directory can not be modified: only index the keys record, the TKey
+      // objects are created when they are looked up (see LoadKeys).
+      std::unique_ptr<char[]> record(new char[fNbytesKeys]);
+      fFile->Seek(fSeekKeys);
+      if (fFile->ReadBuffer(record.get(), fNbytesKeys)) {
+         // ReadBuffer return kTRUE in case of failure.
+         Error("ReadKeys", "Failed to read the keys record");
+         return 0;
+      }
+      Int_t firstIllegal;
+      SafeDelete(fKeyTable);
+      fKeyTable = new ROOT::Internal::TDirectoryKeyTable(std::move(record), fNbytesKeys, fsize, firstIllegal);
+      if (firstIllegal >= 0)
+         Error("ReadKeys","reading illegal key, exiting after %d keys",firstIllegal);
+      nkeys = fKeyTable->GetNkeys();
+   } else if ( fSeekKeys >  0) {
       TKey *headerkey    = new TKey(fSeekKeys, fNbytesKeys, this);
       headerkey->ReadFile();
       buffer = headerkey->GetBuffer();
@@ -1463,24 +1550,23 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 Int_t TDirectoryFile::ReadTObject(TObject *obj, const char *keyname)
 {
    if (!fFile) { Error("ReadTObject","No file open"); return 0; }
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
-   if (!listOfKeys) {
-      Error("ReadTObject", "Unexpected type of TDirectoryFile::fKeys!");
-      return 0;
-   }
-
-   if (const TList *keyList = listOfKeys->GetListForObject(keyname)) {
-      for (auto key: TRangeDynCast<TKey>(*keyList)) {
-         if (key && !strcmp(key->GetName(), keyname) ) {
-            return key->Read(obj);
-         }
-      }
-   }
+   if (TKey *key = LookupKey(keyname, 9999, kFALSE, "ReadTObject"))
+      return key->Read(obj);
 
    Error("ReadTObject","Key not found");
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove an object from the list of objects of this directory, under the lock
+/// of the file if it is read concurrently (see TDirectoryFile::Append).
+
+TObject *TDirectoryFile::Remove(TObject *obj)
+{
+   auto lock = fFile ? fFile->LockConcurrentRead() : std::unique_lock<std::recursive_mutex>();
+   return TDirectory::Remove(obj);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset the TDirectory after its content has been merged into another
 /// Directory.
@@ -1504,6 +1590,7 @@ void TDirectoryFile::ResetAfterMerge(TFileMergeInfo *info)
    fSeekParent = 0; // updated by Init
    fSeekKeys = 0;   // updated by Init
    // Does not change: fFile
+   LoadKeys(fName);
    TKey *key = fKeys ? (TKey*)fKeys->FindObject(fName) : nullptr;
    TClass *cl = IsA();
    if (key) {
@@ -1511,6 +1598,7 @@ void TDirectoryFile::ResetAfterMerge(TFileMergeInfo *info)
    }
    // NOTE: We should check that the content is really mergeable and in
    // the in-mmeory list, before deleting the keys.
+   SafeDelete(fKeyTable);
    if (fKeys) {
       fKeys->Delete("slow");
    }
@@ -1681,6 +1769,8 @@ void TDirectoryFile::SetWritable(Bool_t writable)
    TDirectory::TContext ctxt(this);
 
    fWritable = writable;
+   if (writable)
+      LoadKeys();
 
    // recursively set all sub-directories
    if (fList) {
@@ -2177,6 +2267,7 @@ void TDirectoryFile::WriteKeys()
       f->MakeFree(fSeekKeys, fSeekKeys + fNbytesKeys -1);
    }
 //*-* Write new keys record
+   LoadKeys();
    TIter next(fKeys);
    TKey *key;
    Int_t nkeys  = fKeys->GetSize();
@@ -0,0 +1,208 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TDirectoryKeyTable.h"
+
+#include "Bytes.h"
+#include "TKey.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+/// Skip the TString at `pos` of a buffer of `size` bytes, as written by
+/// TString::FillBuffer; return the position and length of its characters.
+/// Return false if it does not fit in the buffer.
+bool SkipString(char *buffer, Int_t size, Int_t &pos, Int_t &start, Int_t &len)
+{
+   if (pos + 1 > size)
+      return false;
+   char *cur = buffer + pos;
+   UChar_t nwh;
+   frombuf(cur, &nwh);
+   if (nwh == 255) {
+      if (pos + 5 > size)
+         return false;
+      frombuf(cur, &len);
+   } else {
+      len = nwh;
+   }
+   start = cur - buffer;
+   if (len < 0 || start + len > size)
+      return false;
+   pos = start + len;
+   return true;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Index the keys record of `size` bytes in `buffer`, as read from the position
+/// TDirectoryFile::fSeekKeys of a file of `fileSize` bytes. The entries up to
+/// the first illegal one are kept; `firstIllegal` is set to its index, to -1 if
+/// there is none.
+
+ROOT::Internal::TDirectoryKeyTable::TDirectoryKeyTable(std::unique_ptr<char[]> buffer, Int_t size, Long64_t fileSize,
+                                                       Int_t &firstIllegal)
+   : fBuffer(std::move(buffer))
+{
+   firstIllegal = -1;
+   char *base = fBuffer.get();
+
+   // The record starts with the header of its own key.
+   const Int_t kKeylenPos = sizeof(Int_t) + sizeof(Version_t) + sizeof(Int_t) + sizeof(UInt_t);
+   if (size < kKeylenPos + (Int_t)sizeof(Short_t))
+      return;
+   char *cur = base + kKeylenPos;
+   Short_t keylen;
+   frombuf(cur, &keylen);
+   if (keylen < 0 || keylen + (Int_t)sizeof(Int_t) > size)
+      return;
+   cur = base + keylen;
+   Int_t nkeys;
+   frombuf(cur, &nkeys);
+   if (nkeys <= 0)
+      return;
+
+   fEntries.reserve(nkeys);
+   Int_t pos = cur - base;
+   for (Int_t i = 0; i < nkeys; ++i) {
+      REntry entry;
+      entry.fOffset = pos;
+      // fNbytes, fVersion, fObjlen, fDatime, fKeylen and fCycle
+      const Int_t kFixedLen = kKeylenPos + 2 * sizeof(Short_t);
+      if (pos + kFixedLen > size) {
+         firstIllegal = i;
+         break;
+      }
+      cur = base + pos + sizeof(Int_t);
+      Version_t version;
+      frombuf(cur, &version);
+      cur = base + pos + kFixedLen;
+      Long64_t seekKey, seekPdir;
+      if (version > 1000) {
+         if (pos + kFixedLen + 2 * (Int_t)sizeof(Long64_t) > size) {
+            firstIllegal = i;
+            break;
+         }
+         frombuf(cur, &seekKey);
+         frombuf(cur, &seekPdir);
+         seekPdir &= 0xffffffffffffLL; // without the pid offset, see TKey::ReadKeyBuffer
+      } else {
+         if (pos + kFixedLen + 2 * (Int_t)sizeof(UInt_t) > size) {
+            firstIllegal = i;
+            break;
+         }
+         UInt_t seekkey, seekdir;
+         frombuf(cur, &seekkey);
+         frombuf(cur, &seekdir);
+         seekKey = seekkey;
+         seekPdir = seekdir;
+      }
+      if (seekKey < 64 || seekKey > fileSize || seekPdir < 64 || seekPdir > fileSize) {
+         firstIllegal = i;
+         break;
+      }
+      pos = cur - base;
+      Int_t title, titleLen;
+      if (!SkipString(base, size, pos, entry.fClassName, entry.fClassLen) ||
+          !SkipString(base, size, pos, entry.fName, entry.fNameLen) || !SkipString(base, size, pos, title, titleLen)) {
+         firstIllegal = i;
+         break;
+      }
+      fEntries.push_back(entry);
+   }
+
+   fByName.resize(fEntries.size());
+   for (UInt_t i = 0; i < fByName.size(); ++i)
+      fByName[i] = i;
+   std::stable_sort(fByName.begin(), fByName.end(),
+                    [this](UInt_t a, UInt_t b) { return GetName(fEntries[a]) < GetName(fEntries[b]); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the TKey of an entry, belonging to the directory `dir`.
+
+TKey *ROOT::Internal::TDirectoryKeyTable::CreateKey(REntry &entry, TDirectory *dir)
+{
+   entry.fKey = new TKey(dir);
+   char *buffer = fBuffer.get() + entry.fOffset;
+   entry.fKey->ReadKeyBuffer(buffer);
+   ++fNCreated;
+   return entry.fKey;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of the given class, without creating them.
+
+Int_t ROOT::Internal::TDirectoryKeyTable::CountClass(const char *classname) const
+{
+   const std::string_view name(classname);
+   Int_t n = 0;
+   for (const auto &entry : fEntries) {
+      if (!entry.fRemoved && name == std::string_view(fBuffer.get() + entry.fClassName, entry.fClassLen))
+         ++n;
+   }
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the TKeys named `name` which were not created yet and append them to
+/// `created`, in the order of the record. Return kFALSE if there is no such key.
+
+Bool_t ROOT::Internal::TDirectoryKeyTable::FindKeys(const char *name, TDirectory *dir, std::vector<TKey *> &created)
+{
+   const std::string_view key(name);
+   auto it = std::lower_bound(fByName.begin(), fByName.end(), key,
+                              [this](UInt_t i, std::string_view n) { return GetName(fEntries[i]) < n; });
+   Bool_t found = kFALSE;
+   for (; it != fByName.end() && GetName(fEntries[*it]) == key; ++it) {
+      if (fEntries[*it].fRemoved)
+         continue;
+      found = kTRUE;
+      if (!fEntries[*it].fKey)
+         created.push_back(CreateKey(fEntries[*it], dir));
+   }
+   return found;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget a key being deleted, which is no longer part of the directory, as if
+/// it was removed from its list of keys.
+
+void ROOT::Internal::TDirectoryKeyTable::Forget(TKey *key)
+{
+   const std::string_view name(key->GetName());
+   auto it = std::lower_bound(fByName.begin(), fByName.end(), name,
+                              [this](UInt_t i, std::string_view n) { return GetName(fEntries[i]) < n; });
+   for (; it != fByName.end() && GetName(fEntries[*it]) == name; ++it) {
+      if (fEntries[*it].fKey == key) {
+         fEntries[*it].fKey = nullptr;
+         fEntries[*it].fRemoved = kTRUE;
+         --fNCreated;
+         ++fNRemoved;
+         return;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill `keys` with the TKeys of the entries not removed, in the order of the record,
+/// creating the ones which were not created yet.
+
+void ROOT::Internal::TDirectoryKeyTable::CreateKeys(TDirectory *dir, std::vector<TKey *> &keys)
+{
+   keys.reserve(keys.size() + fEntries.size());
+   for (auto &entry : fEntries) {
+      if (!entry.fRemoved)
+         keys.push_back(entry.fKey ? entry.fKey : CreateKey(entry, dir));
+   }
+}
@@ -0,0 +1,72 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TDirectoryKeyTable
+#define ROOT_TDirectoryKeyTable
+
+#include "RtypesCore.h"
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+class TDirectory;
+class TKey;
+
+namespace ROOT {
+namespace Internal {
+
+/** \class ROOT::Internal::TDirectoryKeyTable
+ Keys record of a TDirectoryFile whose TKey objects are created on demand.
+
+The record, as written by TDirectoryFile::WriteKeys, is kept in a single buffer. Only
+the positions of the class name and of the name of each key are decoded when the table
+is created; the entries are indexed by name. A TKey object is created for an entry the
+first time it is looked up and is then owned by the list of keys of the directory.
+*/
+
+class TDirectoryKeyTable {
+private:
+   struct REntry {
+      Int_t fOffset = 0;     ///< Position of the key header in fBuffer
+      Int_t fClassName = 0;  ///< Position of the class name in fBuffer
+      Int_t fClassLen = 0;   ///< Length of the class name
+      Int_t fName = 0;       ///< Position of the name in fBuffer
+      Int_t fNameLen = 0;    ///< Length of the name
+      TKey *fKey = nullptr;  ///< Key created for the entry, if any
+      Bool_t fRemoved = kFALSE; ///< The key was created and deleted
+   };
+
+   std::unique_ptr<char[]> fBuffer; ///< Keys record
+   std::vector<REntry> fEntries;    ///< Entries, in the order of the record
+   std::vector<UInt_t> fByName;     ///< Indices of fEntries sorted by name, then by position
+   UInt_t fNCreated = 0;            ///< Number of entries whose TKey exists
+   UInt_t fNRemoved = 0;            ///< Number of entries whose TKey was deleted
+
+   std::string_view GetName(const REntry &entry) const { return {fBuffer.get() + entry.fName, (size_t)entry.fNameLen}; }
+   TKey *CreateKey(REntry &entry, TDirectory *dir);
+
+public:
+   TDirectoryKeyTable(std::unique_ptr<char[]> buffer, Int_t size, Long64_t fileSize, Int_t &firstIllegal);
+   TDirectoryKeyTable(const TDirectoryKeyTable &) = delete;
+   TDirectoryKeyTable &operator=(const TDirectoryKeyTable &) = delete;
+
+   Int_t CountClass(const char *classname) const;
+   Bool_t FindKeys(const char *name, TDirectory *dir, std::vector<TKey *> &created);
+   void CreateKeys(TDirectory *dir, std::vector<TKey *> &keys);
+   void Forget(TKey *key);
+   Int_t GetNkeys() const { return fEntries.size() - fNRemoved; }
+   Int_t GetNCreated() const { return fNCreated; }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -106,6 +106,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TClassEdit.h"
 #include "TClassTable.h"
 #include "TDatime.h"
+#include "TDirectoryKeyTable.h"
 #include "TError.h"
 #include "TFile.h"
 #include "TFileCacheRead.h"
@@ -133,8 +134,10 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TObjString.h"
 #include "TStopwatch.h"
 #include "compiledata.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <map>
 #include <set>
 #include "TSchemaRule.h"
 #include "TSchemaRuleSet.h"
@@ -142,6 +145,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TGlobal.h"
 #include "ROOT/RConcurrentHashColl.hxx"
 #include <memory>
+#include <vector>
 
 #ifdef R__FBSD
 #include <sys/extattr.h>
@@ -161,9 +165,6 @@ Bool_t   TFile::fgCacheFileForce = kFALSE;
 Bool_t   TFile::fgCacheFileDisconnected = kTRUE;
 UInt_t   TFile::fgOpenTimeout = TFile::kEternalTimeout;
 Bool_t   TFile::fgOnlyStaged = kFALSE;
-#ifdef R__USE_IMT
-ROOT::Internal::RConcurrentHashColl TFile::fgTsSIHashes;
-#endif
 
 #ifdef R__MACOSX
 /* On macOS getxattr takes two extra arguments that should be set to 0 */
@@ -188,6 +189,113 @@ AddPseudoGlobals() {
 }
 } gAddPseudoGlobals;
 }
+
+namespace {
+
+/// Read len bytes at position pos without moving the file pointer, such that
+/// several threads can read the same descriptor. Return the number of bytes
+/// read, short only at the end of the file, or -1 in case of error (see errno).
+ssize_t ReadAt(Int_t fd, char *buf, Long64_t pos, Int_t len)
+{
+#ifndef WIN32
+   ssize_t nread = 0;
+   while (nread < len) {
+      ssize_t siz = ::pread(fd, buf + nread, len - nread, pos + nread);
+      if (siz < 0) {
+         if (errno == EINTR)
+            continue;
+         return -1;
+      }
+      if (siz == 0)
+         break;
+      nread += siz;
+   }
+   return nread;
+#else
+   (void)fd;
+   (void)buf;
+   (void)pos;
+   (void)len;
+   errno = ENOSYS;
+   return -1;
+#endif
+}
+
+/// Return true if the hash was computed, i.e. if it is not the default one.
+bool IsSet(const ROOT::Internal::RConcurrentHashColl::HashValue &hash)
+{
+   const ULong64_t *digest = hash.Get();
+   return digest[0] || digest[1] || digest[2] || digest[3];
+}
+
+/// StreamerInfo records already read by TFile::ReadStreamerInfo, by hash of their
+/// content. The files with the same schema, like the files of a TChain or the
+/// inputs of hadd, have the same record: it is decoded and its StreamerInfos are
+/// checked against the classes in memory (TStreamerInfo::BuildCheck) for the first
+/// of them only. The following ones set the same slots of their class index and
+/// use the StreamerInfos, and their compiled actions, already registered in the
+/// classes. The list returned by TFile::GetStreamerInfoCache is shared the same way.
+class RStreamerInfoRecords {
+   using HashValue = ROOT::Internal::RConcurrentHashColl::HashValue;
+
+   struct REntry {
+      std::vector<Int_t> fClassIndex; ///< Slots of TFile::fClassIndex set for the record
+      TList *fInfoList = nullptr;     ///< StreamerInfos of the record, decoded on demand
+   };
+
+   std::mutex fMutex;
+   std::map<HashValue, REntry> fEntries; ///< Entries are never removed
+
+public:
+   /// Return the slots of the class index set for the record, or nullptr if it was not read yet.
+   const std::vector<Int_t> *FindClassIndex(const HashValue &hash)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      auto it = fEntries.find(hash);
+      return it == fEntries.end() ? nullptr : &it->second.fClassIndex;
+   }
+
+   /// Record that the record was read, setting the given slots of the class index.
+   void Insert(const HashValue &hash, std::vector<Int_t> &&classIndex)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fEntries.emplace(hash, REntry{std::move(classIndex), nullptr});
+   }
+
+   /// Return the decoded StreamerInfos of the record, or nullptr if they were not decoded yet.
+   TList *GetInfoList(const HashValue &hash)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      auto it = fEntries.find(hash);
+      return it == fEntries.end() ? nullptr : it->second.fInfoList;
+   }
+
+   /// Share the decoded StreamerInfos of the record, taking ownership of the list.
+   /// Return the shared list, which may have been decoded by another thread, or
+   /// nullptr if the record was not read yet: the list then stays with the caller.
+   TList *ShareInfoList(const HashValue &hash, TList *list)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      auto it = fEntries.find(hash);
+      if (it == fEntries.end())
+         return nullptr;
+      if (it->second.fInfoList)
+         delete list;
+      else
+         it->second.fInfoList = list;
+      return it->second.fInfoList;
+   }
+};
+
+/// Return the StreamerInfo records read so far. They are never deleted, the
+/// StreamerInfos of the lists refer to classes which may be deleted first at exit.
+RStreamerInfoRecords &GetStreamerInfoRecords()
+{
+   static auto records = new RStreamerInfoRecords;
+   return *records;
+}
+
+} // anonymous namespace
 ////////////////////////////////////////////////////////////////////////////////
 /// File default Constructor.
 
@@ -225,6 +333,7 @@ TFile::TFile() : TDirectoryFile(), fCompress(ROOT::RCompressionSetting::EAlgorit
 /// NET                               | Used by derived remote file access classes, not a user callable option.
 /// WEB                               | Used by derived remote http access class, not a user callable option.
 /// READ_WITHOUT_GLOBALREGISTRATION   | Used by TTreeProcessorMT, not a user callable option.
+/// READ_CONCURRENT                   | Open an existing file for reading by several threads at once (see below).
 ///
 /// If option = "" (default), READ is assumed.
 /// The file can be specified as a URL of the form:
@@ -246,6 +355,17 @@ TFile::TFile() : TDirectoryFile(), fCompress(ROOT::RCompressionSetting::EAlgorit
 ///
 /// This is convenient because the many remote file access plugins allow
 /// easy access to/from the many different mass storage systems.
+/// A local file opened with READ_CONCURRENT can be shared by threads reading
+/// it at the same time, instead of each of them opening the file: the threads
+/// read with positional reads, each from its own position, they look up the
+/// keys of the directories under a lock and they each have their own default
+/// read cache. Each thread must still read its own copy of the objects, for
+/// instance of a TTree with `file->GetKey("tree")->ReadObject<TTree>()`, such
+/// that the TTreeCache of each copy belongs to one thread: unlike
+/// TDirectoryFile::Get, which returns the object already in memory if any, the
+/// key reads a new copy, into a buffer of its own. The copies are added to and
+/// removed from the list of objects of their directory under the lock of the
+/// file. The file and the StreamerInfo record are read only once.
 /// The title of the file (ftitle) will be shown by the ROOT browsers.
 /// A ROOT file (like a Unix file system) may contain objects and
 /// directories. There are no restrictions for the number of levels
@@ -414,6 +534,19 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
       }
    }
 
+   if (fOption.Contains("_CONCURRENT")) {
+      fOption = fOption.ReplaceAll("_CONCURRENT", "");
+      if (fOption != "READ") {
+         Warning("TFile", "option _CONCURRENT only applies to READ, ignored for %s", fOption.Data());
+      } else {
+#ifndef WIN32
+         fConcurrentRead = kTRUE;
+#else
+         Warning("TFile", "concurrent reading is not supported on this platform, file %s is read serially", fname1);
+#endif
+      }
+   }
+
    if (fOption == "NET")
       return;
 
@@ -573,12 +706,13 @@ TFile::~TFile()
 
    SafeDelete(fAsyncHandle);
    SafeDelete(fCacheRead);
+   fConcurrentReadStates.clear();
    SafeDelete(fCacheReadMap);
    SafeDelete(fCacheWrite);
    SafeDelete(fProcessIDs);
    SafeDelete(fFree);
    SafeDelete(fArchive);
-   SafeDelete(fInfoCache);
+   ResetInfoCache();
    SafeDelete(fOpenPhases);
 
    if (fGlobalRegistration) {
@@ -887,7 +1021,7 @@ void TFile::Init(Bool_t create)
             }
          } else if (fVersion != gROOT->GetVersionInt() && fVersion > 30000) {
             // Don't complain about missing streamer info for empty files.
-            if (fKeys->GetSize()) {
+            if (GetNkeys()) {
                Warning("Init","no StreamerInfo found in %s therefore preventing schema evolution when reading this file."
                               " The file was produced with version %d.%02d/%02d of ROOT.",
                               GetName(),  fVersion / 10000, (fVersion / 100) % (100), fVersion  % 100);
@@ -897,7 +1031,10 @@ void TFile::Init(Bool_t create)
    }
 
    // Count number of TProcessIDs in this file
-   {
+   if (fKeyTable) {
+      fNProcessIDs += fKeyTable->CountClass("TProcessID");
+      fProcessIDs = new TObjArray(fNProcessIDs+1);
+   } else {
       TIter next(fKeys);
       TKey *key;
       while ((key = (TKey*)next())) {
@@ -957,6 +1094,14 @@ void TFile::Close(Option_t *option)
    // Finish any concurrent I/O operations before we close the file handles.
    if (fCacheRead) fCacheRead->Close();
    {
+      auto lock = LockConcurrentRead();
+      // The states of all the threads which read the file concurrently are
+      // dropped, such that none keeps a cache which may be deleted with its tree.
+      for (auto &state : fConcurrentReadStates) {
+         if (state.second.fCacheRead)
+            state.second.fCacheRead->Close();
+      }
+      fConcurrentReadStates.clear();
       TIter iter(fCacheReadMap);
       TObject *key = nullptr;
       while ((key = iter()) != nullptr) {
@@ -1135,14 +1280,17 @@ void TFile::Flush()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Flush the write cache if active.
+/// Flush the write cache if active. If the write cache writes asynchronously,
+/// wait for all its buffers to be written.
 ///
 /// Return kTRUE in case of error
 
 Bool_t TFile::FlushWriteCache()
 {
-   if (fCacheWrite && IsOpen() && fWritable)
-      return fCacheWrite->Flush();
+   if (fCacheWrite && IsOpen() && fWritable) {
+      Bool_t status = fCacheWrite->Flush();
+      return fCacheWrite->Sync() || status;
+   }
    return kFALSE;
 }
 
@@ -1242,18 +1390,24 @@ void TFile::ResetErrno() const
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Return a pointer to the current read cache.
+///
+/// For a file read concurrently, the current read cache is the one of the
+/// calling thread.
 
 TFileCacheRead *TFile::GetCacheRead(const TObject* tree) const
 {
+   TFileCacheRead *cacheRead = fConcurrentRead ? GetConcurrentReadState().fCacheRead : fCacheRead;
+   auto lock = LockConcurrentRead();
    if (!tree) {
-      if (!fCacheRead && fCacheReadMap->GetSize() == 1) {
+      // The only cache of a file read concurrently may belong to another thread.
+      if (!cacheRead && !fConcurrentRead && fCacheReadMap->GetSize() == 1) {
          TIter next(fCacheReadMap);
          return (TFileCacheRead *)fCacheReadMap->GetValue(next());
       }
-      return fCacheRead;
+      return cacheRead;
    }
    TFileCacheRead *cache = (TFileCacheRead *)fCacheReadMap->GetValue(tree);
-   if (!cache) return fCacheRead;
+   if (!cache) return cacheRead;
    return cache;
 }
 
@@ -1349,7 +1503,32 @@ Long64_t TFile::GetSize() const
 
 const TList *TFile::GetStreamerInfoCache()
 {
-   return fInfoCache ?  fInfoCache : (fInfoCache=GetStreamerInfoList());
+   if (fInfoCache)
+      return fInfoCache;
+   // The read-only files with the same StreamerInfo record share the decoded list.
+   const bool share = !fWritable && IsSet(fInfoHash);
+   if (share && (fInfoCache = GetStreamerInfoRecords().GetInfoList(fInfoHash))) {
+      fInfoCacheShared = kTRUE;
+      return fInfoCache;
+   }
+   TList *list = GetStreamerInfoList();
+   if (share && list && (fInfoCache = GetStreamerInfoRecords().ShareInfoList(fInfoHash, list))) {
+      fInfoCacheShared = kTRUE;
+      return fInfoCache;
+   }
+   return (fInfoCache = list);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the cached list of the streamer infos, deleting it unless it is
+/// shared with other files.
+
+void TFile::ResetInfoCache()
+{
+   if (!fInfoCacheShared)
+      delete fInfoCache;
+   fInfoCache = nullptr;
+   fInfoCacheShared = kFALSE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1377,19 +1556,15 @@ TFile::InfoListRet TFile::GetStreamerInfoListImpl(bool lookupSICache)
          return {nullptr, 1, hash};
       }
 
-#ifdef R__USE_IMT
       if (lookupSICache) {
          // key data must be excluded from the hash, otherwise the timestamp will
          // always lead to unique hashes for each file
-         hash = fgTsSIHashes.Hash(buf + key->GetKeylen(), fNbytesInfo - key->GetKeylen());
-         if (fgTsSIHashes.Find(hash)) {
+         hash = ROOT::Internal::RConcurrentHashColl::Hash(buf + key->GetKeylen(), fNbytesInfo - key->GetKeylen());
+         if (GetStreamerInfoRecords().FindClassIndex(hash)) {
             if (gDebug > 0) Info("GetStreamerInfo", "The streamer info record for file %s has already been treated, skipping it.", GetName());
             return {nullptr, 0, hash};
          }
       }
-#else
-      (void) lookupSICache;
-#endif
       key->ReadKeyBuffer(buf);
       list = dynamic_cast<TList*>(key->ReadObjWithBuffer(buffer.data()));
       if (list) list->SetOwner();
@@ -1693,6 +1868,37 @@ void TFile::Print(Option_t *option) const
    GetList()->R__FOR_EACH(TObject,Print)(option);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the position of the next read or write relative to the start of the
+/// file, which for a file read concurrently is the one of the calling thread.
+
+Long64_t TFile::GetRelOffset() const
+{
+   return (fConcurrentRead ? GetConcurrentReadState().fOffset : fOffset) - fArchiveOffset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the state of the calling thread for a file read concurrently (option
+/// READ_CONCURRENT), created on first use. The reference stays valid until the
+/// file is closed, since only Close drops the states.
+
+TFile::RConcurrentReadState &TFile::GetConcurrentReadState() const
+{
+   std::lock_guard<std::recursive_mutex> lock(fConcurrentReadMutex);
+   return fConcurrentReadStates[std::this_thread::get_id()];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a lock of the state shared by the threads reading the file, which
+/// owns no mutex unless the file is read concurrently (option READ_CONCURRENT).
+
+std::unique_lock<std::recursive_mutex> TFile::LockConcurrentRead() const
+{
+   if (!fConcurrentRead)
+      return {};
+   return std::unique_lock<std::recursive_mutex>(fConcurrentReadMutex);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read a buffer from the file at the offset 'pos' in the file.
 ///
@@ -1720,8 +1926,14 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
       Seek(pos);
       ssize_t siz;
 
-      while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
-         ResetErrno();
+      if (fConcurrentRead) {
+         Long64_t &offset = GetConcurrentReadState().fOffset;
+         if ((siz = ReadAt(fD, buf, offset, len)) > 0)
+            offset += siz;
+      } else {
+         while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
+            ResetErrno();
+      }
 
       if (siz < 0) {
          SysError("ReadBuffer", "error reading from file %s", GetName());
@@ -1732,9 +1944,12 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
                GetName(), (Long_t)siz, len);
          return kTRUE;
       }
-      fBytesRead  += siz;
+      {
+         auto lock = LockConcurrentRead();
+         fBytesRead += siz;
+         fReadCalls++;
+      }
       fgBytesRead += siz;
-      fReadCalls++;
       fgReadCalls++;
 
       if (gMonitoringWriter)
@@ -1767,8 +1982,14 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
 
       if (gPerfStats) start = TTimeStamp();
 
-      while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
-         ResetErrno();
+      if (fConcurrentRead) {
+         Long64_t &offset = GetConcurrentReadState().fOffset;
+         if ((siz = ReadAt(fD, buf, offset, len)) > 0)
+            offset += siz;
+      } else {
+         while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
+            ResetErrno();
+      }
 
       if (siz < 0) {
          SysError("ReadBuffer", "error reading from file %s", GetName());
@@ -1779,9 +2000,12 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
                GetName(), (Long_t)siz, len);
          return kTRUE;
       }
-      fBytesRead  += siz;
+      {
+         auto lock = LockConcurrentRead();
+         fBytesRead += siz;
+         fReadCalls++;
+      }
       fgBytesRead += siz;
-      fReadCalls++;
       fgReadCalls++;
 
       if (gMonitoringWriter)
@@ -1816,8 +2040,9 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 
    Int_t k = 0;
    Bool_t result = kTRUE;
-   TFileCacheRead *old = fCacheRead;
-   fCacheRead = nullptr;
+   TFileCacheRead *&cacheRead = fConcurrentRead ? GetConcurrentReadState().fCacheRead : fCacheRead;
+   TFileCacheRead *old = cacheRead;
+   cacheRead = nullptr;
    Long64_t curbegin = pos[0];
    Long64_t cur;
    char *buf2 = nullptr;
@@ -1851,8 +2076,11 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
             }
             Int_t nok = k-kold;
             Long64_t extra = nahead-nok;
-            fBytesReadExtra += extra;
-            fBytesRead      -= extra;
+            {
+               auto lock = LockConcurrentRead();
+               fBytesReadExtra += extra;
+               fBytesRead      -= extra;
+            }
             fgBytesRead     -= extra;
             n = 0;
          }
@@ -1860,7 +2088,7 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       }
    }
    if (buf2) delete [] buf2;
-   fCacheRead = old;
+   cacheRead = old;
    return result;
 }
 
@@ -1873,8 +2101,9 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 Int_t TFile::ReadBufferViaCache(char *buf, Int_t len)
 {
    Long64_t off = GetRelOffset();
-   if (fCacheRead) {
-      Int_t st = fCacheRead->ReadBuffer(buf, off, len);
+   TFileCacheRead *cacheRead = fConcurrentRead ? GetConcurrentReadState().fCacheRead : fCacheRead;
+   if (cacheRead) {
+      Int_t st = cacheRead->ReadBuffer(buf, off, len);
       if (st < 0)
          return 2;  // failure reading
       else if (st == 1) {
@@ -1884,6 +2113,9 @@ Int_t TFile::ReadBufferViaCache(char *buf, Int_t len)
       }
       // fOffset might have been changed via TFileCacheRead::ReadBuffer(), reset it
       Seek(off);
+      // the data written asynchronously must be on the file before reading it
+      if (fWritable && fCacheWrite)
+         fCacheWrite->Sync();
    } else {
       // if write cache is active check if data still in write cache
       if (fWritable && fCacheWrite) {
@@ -2106,7 +2338,7 @@ Int_t TFile::Recover()
          key->ReadKeyBuffer(bufread);
          if (!strcmp(key->GetName(),"StreamerInfo")) {
             fSeekInfo = seekkey;
-            SafeDelete(fInfoCache);
+            ResetInfoCache();
             fNbytesInfo = nbytes;
          } else {
             AppendKey(key);
@@ -2236,27 +2468,35 @@ Int_t TFile::ReOpen(Option_t *mode)
 
 void TFile::SetOffset(Long64_t offset, ERelativeTo pos)
 {
+   Long64_t &curOffset = fConcurrentRead ? GetConcurrentReadState().fOffset : fOffset;
    switch (pos) {
       case kBeg:
-         fOffset = offset + fArchiveOffset;
+         curOffset = offset + fArchiveOffset;
          break;
       case kCur:
-         fOffset += offset;
+         curOffset += offset;
          break;
       case kEnd:
          // this option is not used currently in the ROOT code
          if (fArchiveOffset)
             Error("SetOffset", "seeking from end in archive is not (yet) supported");
-         fOffset = fEND + offset;  // is fEND really EOF or logical EOF?
+         curOffset = fEND + offset;  // is fEND really EOF or logical EOF?
          break;
    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Seek to a specific position in the file. Pos it either kBeg, kCur or kEnd.
+///
+/// A file read concurrently is read with positional reads: only the position
+/// of the calling thread is moved.
 
 void TFile::Seek(Long64_t offset, ERelativeTo pos)
 {
+   if (fConcurrentRead) {
+      SetOffset(offset, pos);
+      return;
+   }
    int whence = 0;
    switch (pos) {
       case kBeg:
@@ -2348,20 +2588,26 @@ void TFile::SetCompressionSettings(Int_t settings)
 
 void TFile::SetCacheRead(TFileCacheRead *cache, TObject* tree, ECacheAction action)
 {
+   TFileCacheRead *&cacheRead = fConcurrentRead ? GetConcurrentReadState().fCacheRead : fCacheRead;
    if (tree) {
-      if (cache) fCacheReadMap->Add(tree, cache);
-      else {
-         // The only addition to fCacheReadMap is via an interface that takes
-         // a TFileCacheRead* so the C-cast is safe.
-         TFileCacheRead* tpf = (TFileCacheRead *)fCacheReadMap->GetValue(tree);
-         fCacheReadMap->Remove(tree);
-         if (tpf && (tpf->GetFile() == this) && (action != kDoNotDisconnect)) tpf->SetFile(0, action);
+      TFileCacheRead *tpf = nullptr;
+      {
+         auto lock = LockConcurrentRead();
+         if (cache) fCacheReadMap->Add(tree, cache);
+         else {
+            // The only addition to fCacheReadMap is via an interface that takes
+            // a TFileCacheRead* so the C-cast is safe.
+            tpf = (TFileCacheRead *)fCacheReadMap->GetValue(tree);
+            fCacheReadMap->Remove(tree);
+         }
       }
+      if (tpf && (tpf->GetFile() == this) && (action != kDoNotDisconnect)) tpf->SetFile(0, action);
    }
    if (cache) cache->SetFile(this, action);
-   else if (!tree && fCacheRead && (action != kDoNotDisconnect)) fCacheRead->SetFile(0, action);
-   // For backward compatibility the last Cache set is the default cache.
-   fCacheRead = cache;
+   else if (!tree && cacheRead && (action != kDoNotDisconnect)) cacheRead->SetFile(0, action);
+   // For backward compatibility the last Cache set is the default cache
+   // (of the calling thread for a file read concurrently).
+   cacheRead = cache;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2598,7 +2844,7 @@ void TFile::WriteFree()
 
 void TFile::WriteHeader()
 {
-   SafeDelete(fInfoCache);
+   ResetInfoCache();
    TFree *lastfree = (TFree*)fFree->Last();
    if (lastfree) fEND  = lastfree->GetFirst();
    const char *root = "root";
@@ -3591,8 +3837,20 @@ void TFile::ReadStreamerInfo()
    auto listRetcode = GetStreamerInfoListImpl(/*lookupSICache*/ true);  // NOLINT: silence clang-tidy warnings
    TList *list = listRetcode.fList;
    auto retcode = listRetcode.fReturnCode;
+   fInfoHash = listRetcode.fHash;
    if (!list) {
-      if (retcode) MakeZombie();
+      if (retcode) {
+         MakeZombie();
+      } else if (auto classIndex = GetStreamerInfoRecords().FindClassIndex(fInfoHash)) {
+         // The same record was already read from another file: its StreamerInfos
+         // are registered, only the class index of this file is missing.
+         for (Int_t uid : *classIndex) {
+            if (uid >= fClassIndex->GetSize())
+               fClassIndex->Set(std::max(2 * fClassIndex->GetSize(), uid + 1));
+            fClassIndex->fArray[uid] = 1;
+         }
+         fClassIndex->fArray[0] = 0;
+      }
       return;
    }
 
@@ -3631,6 +3889,7 @@ void TFile::ReadStreamerInfo()
    }
 
    // loop on all TStreamerInfo classes
+   std::vector<Int_t> classIndex;
    for (int mode=0;mode<2; ++mode) {
       // In order for the collection proxy to be initialized properly, we need
       // to setup the TStreamerInfo for non-stl class before the stl classes.
@@ -3680,8 +3939,10 @@ void TFile::ReadStreamerInfo()
             Int_t uid = info->GetNumber();
             Int_t asize = fClassIndex->GetSize();
             if (uid >= asize && uid <100000) fClassIndex->Set(2*asize);
-            if (uid >= 0 && uid < fClassIndex->GetSize()) fClassIndex->fArray[uid] = 1;
-            else if (!isstl && !info->GetClass()->IsSyntheticPair()) {
+            if (uid >= 0 && uid < fClassIndex->GetSize()) {
+               fClassIndex->fArray[uid] = 1;
+               classIndex.push_back(uid);
+            } else if (!isstl && !info->GetClass()->IsSyntheticPair()) {
                printf("ReadStreamerInfo, class:%s, illegal uid=%d\n",info->GetName(),uid);
             }
             if (gDebug > 0) printf(" -class: %s version: %d info read at slot %d\n",info->GetName(), info->GetClassVersion(),uid);
@@ -3693,11 +3954,10 @@ void TFile::ReadStreamerInfo()
    list->Clear();  //this will delete all TStreamerInfo objects with kCanDelete bit set
    delete list;
 
-#ifdef R__USE_IMT
-   // We are done processing the record, let future calls and other threads that it
-   // has been done.
-   fgTsSIHashes.Insert(listRetcode.fHash);
-#endif
+   // We are done processing the record, let future calls and other threads know
+   // that it has been done.
+   if (IsSet(fInfoHash))
+      GetStreamerInfoRecords().Insert(fInfoHash, std::move(classIndex));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3786,7 +4046,7 @@ void TFile::WriteStreamerInfo()
    }
    if (gDebug > 0) Info("WriteStreamerInfo", "called for file %s",GetName());
 
-   SafeDelete(fInfoCache);
+   ResetInfoCache();
 
    // build a temporary list with the marked files
    TIter next(gROOT->GetListOfStreamerInfo());
@@ -4299,6 +4559,16 @@ TFile *TFile::Open(const char *url, Option_t *options, const char *ftitle,
       new TFileCacheWrite(f, 1);
    }
 
+   // if requested, the buffers of a local file are written asynchronously
+   if ((type == kLocal || type == kFile) && f && f->IsWritable() && !f->IsRaw() && f->IsA() == TFile::Class()) {
+      Long64_t asyncBytes = gEnv->GetValue("TFile.AsyncWriting", 0);
+      if (asyncBytes > 0) {
+         auto cache = new TFileCacheWrite(f, 1);
+         if (cache->SetAsync(asyncBytes))
+            f->SetCacheWrite(nullptr);
+      }
+   }
+
    return f;
 }
 
@@ -23,11 +23,25 @@ TXNetFile and TWebFile (via TFile::WriteBuffers()).
 
 The write cache is automatically created when writing a remote file
 (created in TFile::Open()).
+
+With SetAsync(), the flushed buffers of a local file are written by a
+dedicated thread ("write-behind"), such that the thread filling the
+file does not wait for the file system. The size of the buffers not yet
+written is bounded by the value given to SetAsync(); the filling thread
+waits when it is reached. TFile::Flush(), and therefore TFile::Write()
+and TFile::Close(), wait for all the buffers to be written. The
+write-behind is enabled for the local files opened for writing with
+TFile::Open() if the rootrc variable `TFile.AsyncWriting` is set to
+the bound in bytes.
 */
 
 
 #include "TFile.h"
 #include "TFileCacheWrite.h"
+#include "TFileWriteBehind.h"
+
+#include <cstring>
+#include <system_error>
 
 ClassImp(TFileCacheWrite);
 
@@ -42,6 +56,7 @@ TFileCacheWrite::TFileCacheWrite() : TObject()
    fFile        = 0;
    fBuffer      = 0;
    fRecursive   = kFALSE;
+   fWriteBehind = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -59,6 +74,7 @@ TFileCacheWrite::TFileCacheWrite(TFile *file, Int_t buffersize)
    fNtot        = 0;
    fFile        = file;
    fRecursive   = kFALSE;
+   fWriteBehind = nullptr;
    fBuffer      = new char[fBufferSize];
    if (file) file->SetCacheWrite(this);
    if (gDebug > 0) Info("TFileCacheWrite","Creating a write cache with buffersize=%d bytes",buffersize);
@@ -69,6 +85,7 @@ TFileCacheWrite::TFileCacheWrite(TFile *file, Int_t buffersize)
 
 TFileCacheWrite::~TFileCacheWrite()
 {
+   delete fWriteBehind;
    delete [] fBuffer;
 }
 
@@ -78,6 +95,13 @@ TFileCacheWrite::~TFileCacheWrite()
 
 Bool_t TFileCacheWrite::Flush()
 {
+   if (fWriteBehind) {
+      if (!fNtot) return CheckAsync();
+      // Hand the buffer to the writing thread and continue with a free one
+      fBuffer = fWriteBehind->Submit(fFile->GetFd(), fBuffer, fBufferSize, fSeekStart, fNtot);
+      fNtot = 0;
+      return CheckAsync();
+   }
    if (!fNtot) return kFALSE;
    fFile->Seek(fSeekStart);
    //printf("Flushing buffer at fSeekStart=%lld, fNtot=%d\n",fSeekStart,fNtot);
@@ -96,6 +120,9 @@ void TFileCacheWrite::Print(Option_t *option) const
    TString opt = option;
    printf("Write cache for file %s\n",fFile->GetName());
    printf("Size of write cache: %d bytes to be written at %lld\n",fNtot,fSeekStart);
+   if (fWriteBehind)
+      printf("Written asynchronously: %lld bytes in flight (max %lld)\n", fWriteBehind->GetBytesInFlight(),
+             fWriteBehind->GetMaxBytesInFlight());
    opt.ToLower();
 }
 
@@ -107,6 +134,9 @@ void TFileCacheWrite::Print(Option_t *option) const
 
 Int_t TFileCacheWrite::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
+   // The data must be on the file before being read from it
+   if (fWriteBehind && fWriteBehind->Overlaps(pos, len))
+      Sync();
    if (pos < fSeekStart || pos+len > fSeekStart+fNtot) return -1;
    memcpy(buf,fBuffer+pos-fSeekStart,len);
    return 0;
@@ -131,6 +161,10 @@ Int_t TFileCacheWrite::WriteBuffer(const char *buf, Long64_t pos, Int_t len)
    if (fNtot + len >= fBufferSize) {
       if (Flush()) return -1; //failure
       if (len >= fBufferSize) {
+         if (fWriteBehind) {
+            if (fWriteBehind->Write(fFile->GetFd(), buf, pos, len)) return -1;  // failure
+            return 1;
+         }
          //buffer larger than the cache itself: direct write to file
          fRecursive = kTRUE;
          fFile->Seek(pos); // Flush may have changed this
@@ -152,5 +186,107 @@ Int_t TFileCacheWrite::WriteBuffer(const char *buf, Long64_t pos, Int_t len)
 
 void TFileCacheWrite::SetFile(TFile *file)
 {
+   if (fWriteBehind) {
+      // The buffers already handed to the writing thread are written to the previous file
+      fWriteBehind->Wait();
+      delete fWriteBehind;
+      fWriteBehind = nullptr;
+   }
    fFile = file;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes not yet written to the file.
+
+Int_t TFileCacheWrite::GetBytesInCache() const
+{
+   if (fWriteBehind)
+      return fNtot + (Int_t)fWriteBehind->GetBytesPending();
+   return fNtot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the maximum number of bytes written asynchronously at any time,
+/// 0 if the flushed buffers are written synchronously.
+
+Long64_t TFileCacheWrite::GetMaxBytesInFlight() const
+{
+   return fWriteBehind ? fWriteBehind->GetMaxBytesInFlight() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the flushed buffers with a dedicated thread, with at most
+/// maxBytesInFlight bytes not yet written; Flush() waits when this is reached.
+/// A value <= 0 writes the buffers synchronously again.
+/// This is only supported for local files, as it writes on the descriptor
+/// returned by TFile::GetFd().
+/// Returns kTRUE in case of error.
+
+Bool_t TFileCacheWrite::SetAsync(Long64_t maxBytesInFlight)
+{
+   if (fWriteBehind) {
+      Bool_t status = Sync();
+      delete fWriteBehind;
+      fWriteBehind = nullptr;
+      if (status) return kTRUE;
+   }
+   if (maxBytesInFlight <= 0) return kFALSE;
+
+#ifdef WIN32
+   Error("SetAsync", "Asynchronous writing is not supported on this platform");
+   return kTRUE;
+#else
+   if (!fFile || fFile->IsA() != TFile::Class() || fFile->GetFd() < 0) {
+      Error("SetAsync", "Asynchronous writing is only supported for local files");
+      return kTRUE;
+   }
+   // Data still in the cache was meant to be written synchronously
+   if (Flush()) return kTRUE;
+   try {
+      fWriteBehind = new ROOT::Internal::TFileWriteBehind(maxBytesInFlight);
+   } catch (const std::system_error &e) {
+      Error("SetAsync", "Cannot start the writing thread: %s", e.what());
+      return kTRUE;
+   }
+   if (gDebug > 0)
+      Info("SetAsync", "Writing %s asynchronously with at most %lld bytes in flight", fFile->GetName(),
+           maxBytesInFlight);
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for the flushed buffers to be written to the file. This does not
+/// flush the current buffer, see Flush().
+/// Returns kTRUE in case of error.
+
+Bool_t TFileCacheWrite::Sync()
+{
+   if (!fWriteBehind) return kFALSE;
+   fWriteBehind->Wait();
+   return CheckAsync();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Account for the bytes written by the writing thread and report its failures.
+/// Returns kTRUE if a write failed.
+
+Bool_t TFileCacheWrite::CheckAsync()
+{
+   Long64_t written = fWriteBehind->TakeBytesWritten();
+   fFile->fBytesWrite += written;
+   TFile::fgBytesWrite += written;
+
+   Int_t err = fWriteBehind->GetErrno();
+   if (!err) return kFALSE;
+   // Report the system error only once for this file
+   if (!fFile->TestBit(TFile::kWriteError)) {
+      fFile->SetBit(TFile::kWriteError);
+      fFile->SetWritable(kFALSE);
+      if (err > 0)
+         Error("Flush", "error writing to file %s: %s", fFile->GetName(), strerror(err));
+      else
+         Error("Flush", "error writing all requested bytes to file %s", fFile->GetName());
+   }
+   return kTRUE;
+}
@@ -839,8 +839,12 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
    TFileMergeInfo info(target);
    info.fIOFeatures = fIOFeatures;
    info.fOptions = fMergeOptions;
-   if (fFastMethod && ((type&kKeepCompression) || !fCompressionChange) ) {
+   if (fFastMethod) {
       info.fOptions.Append(" fast");
+      // The baskets are copied without unstreaming them but need to be compressed
+      // again (in parallel when the implicit multi-threading is enabled).
+      if (fCompressionChange && !(type&kKeepCompression))
+         info.fOptions.Append(" recompress");
    }
 
    TFile      *current_file;
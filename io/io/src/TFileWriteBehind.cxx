@@ -0,0 +1,251 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TFileWriteBehind.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// Number of written buffers kept to be reused by Submit().
+constexpr std::size_t kMaxFreeBlocks = 2;
+
+/// Write len bytes of buf at position pos; return 0 or the errno of the failure (-1 for a short write).
+Int_t WriteAt(Int_t fd, const char *buf, Long64_t pos, Int_t len)
+{
+#ifndef WIN32
+   while (len > 0) {
+      ssize_t siz = ::pwrite(fd, buf, len, pos);
+      if (siz < 0) {
+         if (errno == EINTR)
+            continue;
+         return errno;
+      }
+      if (siz == 0)
+         return -1;
+      buf += siz;
+      pos += siz;
+      len -= siz;
+   }
+   return 0;
+#else
+   (void)fd;
+   (void)buf;
+   (void)pos;
+   (void)len;
+   return ENOSYS;
+#endif
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start the thread writing the blocks. Throws std::system_error if it cannot be
+/// created.
+
+ROOT::Internal::TFileWriteBehind::TFileWriteBehind(Long64_t maxBytesInFlight) : fMaxBytesInFlight(maxBytesInFlight)
+{
+   fThread = std::thread([this]() { Run(); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the pending blocks and stop the thread.
+
+ROOT::Internal::TFileWriteBehind::~TFileWriteBehind()
+{
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fStop = kTRUE;
+   }
+   fCondition.notify_all();
+   fThread.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Execution loop of the writing thread.
+
+void ROOT::Internal::TFileWriteBehind::Run()
+{
+   std::unique_lock<std::mutex> lock(fMutex);
+   while (true) {
+      fCondition.wait(lock, [this]() { return fStop || !fQueue.empty(); });
+      if (fQueue.empty())
+         return;
+
+      // The block stays in the queue while it is written, such that Overlaps() sees it.
+      const RBlock &block = fQueue.front();
+      const char *buf = block.fBuffer.get();
+      const Int_t fd = block.fFd;
+      const Long64_t pos = block.fPos;
+      const Int_t len = block.fLen;
+      lock.unlock();
+      const Int_t err = WriteAt(fd, buf, pos, len);
+      lock.lock();
+
+      RBlock done = std::move(fQueue.front());
+      fQueue.pop_front();
+      fBytesInFlight -= len;
+      if (err) {
+         fErrno = err;
+         // The file is broken, writing the following blocks is pointless.
+         fQueue.clear();
+         fBytesInFlight = 0;
+      } else {
+         fBytesWritten += len;
+      }
+      if (fFree.size() < kMaxFreeBlocks)
+         fFree.push_back(std::move(done));
+      fCondition.notify_all();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Queue the block, waiting while the bound on the bytes in flight would be
+/// exceeded. Returns kTRUE if a write failed, in which case the block is dropped.
+
+Bool_t ROOT::Internal::TFileWriteBehind::Enqueue(RBlock &&block, std::unique_lock<std::mutex> &lock)
+{
+   fCondition.wait(lock, [this, &block]() {
+      return fErrno || fBytesInFlight == 0 || fBytesInFlight + block.fLen <= fMaxBytesInFlight;
+   });
+   if (fErrno)
+      return kTRUE;
+
+   fBytesInFlight += block.fLen;
+   fQueue.push_back(std::move(block));
+   fCondition.notify_all();
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write len bytes of buffer at position pos of the file fd. The buffer, of
+/// capacity bytes and allocated with new[], is owned by this object from now on.
+/// Returns a buffer of at least capacity bytes to be used by the caller instead.
+
+char *ROOT::Internal::TFileWriteBehind::Submit(Int_t fd, char *buffer, Int_t capacity, Long64_t pos, Int_t len)
+{
+   RBlock block;
+   block.fBuffer.reset(buffer);
+   block.fCapacity = capacity;
+   block.fFd = fd;
+   block.fPos = pos;
+   block.fLen = len;
+
+   std::unique_lock<std::mutex> lock(fMutex);
+   if (Enqueue(std::move(block), lock)) {
+      // Dropped: the buffer was not moved away
+      return block.fBuffer.release();
+   }
+
+   for (auto it = fFree.begin(); it != fFree.end(); ++it) {
+      if (it->fCapacity >= capacity) {
+         char *reused = it->fBuffer.release();
+         fFree.erase(it);
+         return reused;
+      }
+   }
+   lock.unlock();
+   return new char[capacity];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write a copy of the len bytes of buf at position pos of the file fd.
+/// Returns kTRUE if a write failed.
+
+Bool_t ROOT::Internal::TFileWriteBehind::Write(Int_t fd, const char *buf, Long64_t pos, Int_t len)
+{
+   RBlock block;
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      for (auto it = fFree.begin(); it != fFree.end(); ++it) {
+         if (it->fCapacity >= len) {
+            block = std::move(*it);
+            fFree.erase(it);
+            break;
+         }
+      }
+   }
+   if (!block.fBuffer) {
+      block.fBuffer.reset(new char[len]);
+      block.fCapacity = len;
+   }
+   memcpy(block.fBuffer.get(), buf, len);
+   block.fFd = fd;
+   block.fPos = pos;
+   block.fLen = len;
+
+   std::unique_lock<std::mutex> lock(fMutex);
+   return Enqueue(std::move(block), lock);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if a block not yet written overlaps the bytes [pos, pos+len[.
+
+Bool_t ROOT::Internal::TFileWriteBehind::Overlaps(Long64_t pos, Int_t len)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   for (const auto &block : fQueue) {
+      if (pos < block.fPos + block.fLen && block.fPos < pos + len)
+         return kTRUE;
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for all the blocks to be written. Returns kTRUE if a write failed.
+
+Bool_t ROOT::Internal::TFileWriteBehind::Wait()
+{
+   std::unique_lock<std::mutex> lock(fMutex);
+   fCondition.wait(lock, [this]() { return fQueue.empty(); });
+   return fErrno != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Long64_t ROOT::Internal::TFileWriteBehind::GetBytesInFlight()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fBytesInFlight;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes submitted that were not yet returned by TakeBytesWritten().
+
+Long64_t ROOT::Internal::TFileWriteBehind::GetBytesPending()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fBytesInFlight + fBytesWritten;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the errno of the first failed write, -1 for a short write, 0 if none failed.
+
+Int_t ROOT::Internal::TFileWriteBehind::GetErrno()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fErrno;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes written since the previous call.
+
+Long64_t ROOT::Internal::TFileWriteBehind::TakeBytesWritten()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   Long64_t written = fBytesWritten;
+   fBytesWritten = 0;
+   return written;
+}
@@ -0,0 +1,80 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFileWriteBehind
+#define ROOT_TFileWriteBehind
+
+#include "RtypesCore.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/** \class ROOT::Internal::TFileWriteBehind
+ Writes the buffers flushed by a TFileCacheWrite on a dedicated thread.
+
+The blocks are written with positional writes, in the order they are submitted, such
+that they do not interfere with the file offset used by the TFile for reading. The
+summed size of the blocks not yet written is bounded: Submit() blocks while it would be
+exceeded. The first failed write is remembered; the following blocks are dropped.
+*/
+
+class TFileWriteBehind {
+private:
+   struct RBlock {
+      std::unique_ptr<char[]> fBuffer;
+      Int_t fCapacity = 0; ///< Allocated size of fBuffer
+      Int_t fFd = -1;      ///< File descriptor to write to
+      Long64_t fPos = 0;   ///< Position on file
+      Int_t fLen = 0;      ///< Number of bytes to write
+   };
+
+   Long64_t fMaxBytesInFlight;    ///< Bound on the summed size of the blocks in fQueue
+   std::mutex fMutex;
+   std::condition_variable fCondition; ///< Signals a new block or the completion of one
+   std::deque<RBlock> fQueue;     ///< Blocks to write; the front one is being written
+   std::vector<RBlock> fFree;     ///< Written blocks whose buffers can be reused
+   Long64_t fBytesInFlight = 0;   ///< Summed size of the blocks in fQueue
+   Long64_t fBytesWritten = 0;    ///< Bytes written since the last call to TakeBytesWritten()
+   Int_t fErrno = 0;              ///< errno of the first failed write, -1 for a short write
+   Bool_t fStop = kFALSE;
+   std::thread fThread;
+
+   void Run();
+   Bool_t Enqueue(RBlock &&block, std::unique_lock<std::mutex> &lock);
+
+public:
+   explicit TFileWriteBehind(Long64_t maxBytesInFlight);
+   TFileWriteBehind(const TFileWriteBehind &) = delete;
+   TFileWriteBehind &operator=(const TFileWriteBehind &) = delete;
+   ~TFileWriteBehind();
+
+   char *Submit(Int_t fd, char *buffer, Int_t capacity, Long64_t pos, Int_t len);
+   Bool_t Write(Int_t fd, const char *buf, Long64_t pos, Int_t len);
+   Bool_t Overlaps(Long64_t pos, Int_t len);
+   Bool_t Wait();
+
+   Long64_t GetBytesInFlight();
+   Long64_t GetBytesPending();
+   Long64_t GetMaxBytesInFlight() const { return fMaxBytesInFlight; }
+   Int_t GetErrno();
+   Long64_t TakeBytesWritten();
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -524,7 +524,10 @@ void TKey::Create(Int_t nbytes, TFile* externFile)
 
 TKey::~TKey()
 {
-   if (fMotherDir && fMotherDir->GetListOfKeys())
+   // GetListOfKeys() would create all the keys of a TDirectoryFile not looked up yet.
+   if (auto dir = dynamic_cast<TDirectoryFile *>(fMotherDir))
+      dir->RemoveKey(this);
+   else if (fMotherDir && fMotherDir->GetListOfKeys())
       fMotherDir->GetListOfKeys()->Remove(this);
    TKey::DeleteBuffer();
 }
@@ -776,26 +779,19 @@ TObject *TKey::ReadObj()
    bufferRef.SetParent(GetFile());
    bufferRef.SetPidOffset(fPidOffset);
 
+   // The object is read into a local buffer rather than into fBuffer, such
+   // that several threads can read the same key of a file opened with the
+   // option READ_CONCURRENT.
    std::unique_ptr<char []> compressedBuffer;
-   auto storeBuffer = fBuffer;
    if (fObjlen > fNbytes-fKeylen) {
       compressedBuffer.reset(new char[fNbytes]);
-      fBuffer = compressedBuffer.get();
-      if( !ReadFile() )                    //Read object structure from file
-      {
-        fBuffer = 0;
-        return 0;
-      }
-      memcpy(bufferRef.Buffer(),fBuffer,fKeylen);
+      if( !ReadFileToBuffer(compressedBuffer.get()) )  //Read object structure from file
+         return 0;
+      memcpy(bufferRef.Buffer(),compressedBuffer.get(),fKeylen);
    } else {
-      fBuffer = bufferRef.Buffer();
-      if( !ReadFile() ) {                   //Read object structure from file
-
-         fBuffer = 0;
+      if( !ReadFileToBuffer(bufferRef.Buffer()) )      //Read object structure from file
          return 0;
-      }
    }
-   fBuffer = storeBuffer;
 
    // get version of key
    bufferRef.SetBufferOffset(sizeof(fNbytes));
@@ -911,15 +907,11 @@ TObject *TKey::ReadObjWithBuffer(char *bufferRead)
    bufferRef.SetParent(GetFile());
    bufferRef.SetPidOffset(fPidOffset);
 
-   auto storeBuffer = fBuffer;
    if (fObjlen > fNbytes-fKeylen) {
-      fBuffer = bufferRead;
-      memcpy(bufferRef.Buffer(),fBuffer,fKeylen);
+      memcpy(bufferRef.Buffer(),bufferRead,fKeylen);
    } else {
-      fBuffer = bufferRef.Buffer();
-      ReadFile();                    //Read object structure from file
+      ReadFileToBuffer(bufferRef.Buffer());            //Read object structure from file
    }
-   fBuffer = storeBuffer;
 
    // get version of key
    bufferRef.SetBufferOffset(sizeof(fNbytes));
@@ -1032,17 +1024,13 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
    bufferRef.SetPidOffset(fPidOffset);
 
    std::unique_ptr<char []> compressedBuffer;
-   auto storeBuffer = fBuffer;
    if (fObjlen > fNbytes-fKeylen) {
       compressedBuffer.reset(new char[fNbytes]);
-      fBuffer = compressedBuffer.get();
-      ReadFile();                    //Read object structure from file
-      memcpy(bufferRef.Buffer(),fBuffer,fKeylen);
+      ReadFileToBuffer(compressedBuffer.get());        //Read object structure from file
+      memcpy(bufferRef.Buffer(),compressedBuffer.get(),fKeylen);
    } else {
-      fBuffer = bufferRef.Buffer();
-      ReadFile();                    //Read object structure from file
+      ReadFileToBuffer(bufferRef.Buffer());            //Read object structure from file
    }
-   fBuffer = storeBuffer;
 
    // get version of key
    bufferRef.SetBufferOffset(sizeof(fNbytes));
@@ -1166,17 +1154,13 @@ Int_t TKey::Read(TObject *obj)
       bufferRef.MapObject(obj);  //register obj in map to handle self reference
 
    std::unique_ptr<char []> compressedBuffer;
-   auto storeBuffer = fBuffer;
    if (fObjlen > fNbytes-fKeylen) {
       compressedBuffer.reset(new char[fNbytes]);
-      fBuffer = compressedBuffer.get();
-      ReadFile();                    //Read object structure from file
-      memcpy(bufferRef.Buffer(),fBuffer,fKeylen);
+      ReadFileToBuffer(compressedBuffer.get());        //Read object structure from file
+      memcpy(bufferRef.Buffer(),compressedBuffer.get(),fKeylen);
    } else {
-      fBuffer = bufferRef.Buffer();
-      ReadFile();                    //Read object structure from file
+      ReadFileToBuffer(bufferRef.Buffer());            //Read object structure from file
    }
-   fBuffer = storeBuffer;
 
    bufferRef.SetBufferOffset(fKeylen);
    if (fObjlen > fNbytes-fKeylen) {
@@ -1271,6 +1255,15 @@ void TKey::ReadKeyBuffer(char *&buffer)
 /// Read the key structure from the file
 
 Bool_t TKey::ReadFile()
+{
+   return ReadFileToBuffer(fBuffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the key structure from the file into buffer, which must hold fNbytes
+/// bytes, leaving the state of the key untouched.
+
+Bool_t TKey::ReadFileToBuffer(char *buffer) const
 {
    TFile* f = GetFile();
    if (f==0) return kFALSE;
@@ -1281,10 +1274,10 @@ Bool_t TKey::ReadFile()
    for (Int_t i = 0; i < nsize; i += kMAXFILEBUFFER) {
       int nb = kMAXFILEBUFFER;
       if (i+nb > nsize) nb = nsize - i;
-      f->ReadBuffer(fBuffer+i,nb);
+      f->ReadBuffer(buffer+i,nb);
    }
 #else
-   if( f->ReadBuffer(fBuffer,nsize) )
+   if( f->ReadBuffer(buffer,nsize) )
    {
       Error("ReadFile", "Failed to read data.");
       return kFALSE;
@@ -0,0 +1,113 @@
+#include "TFile.h"
+#include "TKey.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr Long64_t kNEntries = 20000;
+constexpr int kNThreads = 4;
+
+// Write a tree of one branch, with a cluster every 500 entries such that the
+// threads read different baskets at once.
+void WriteTree(const char *fileName)
+{
+   TFile file(fileName, "RECREATE");
+   TTree tree("tree", "tree");
+   tree.SetAutoFlush(500);
+   Long64_t x = 0;
+   tree.Branch("x", &x);
+   for (x = 0; x < kNEntries; ++x)
+      tree.Fill();
+   file.Write();
+}
+} // namespace
+
+TEST(TFile, ConcurrentReadTrees)
+{
+   auto fileName = "tfile_concurrentread_trees.root";
+   WriteTree(fileName);
+   ROOT::EnableThreadSafety();
+   std::unique_ptr<TFile> file{TFile::Open(fileName, "READ_CONCURRENT")};
+   ASSERT_NE(file, nullptr);
+   ASSERT_TRUE(file->IsConcurrentRead());
+
+   // Each thread reads its own copy of the tree from the same key, with its own
+   // cache, and deletes it, such that the threads read the key and update the
+   // list of objects of the file at the same time.
+   std::atomic<int> nErrors{0};
+   std::vector<std::thread> threads;
+   for (int t = 0; t < kNThreads; ++t) {
+      threads.emplace_back([&file, &nErrors, t]() {
+         auto key = file->GetKey("tree");
+         std::unique_ptr<TTree> tree{key ? key->ReadObject<TTree>() : nullptr};
+         if (!tree || tree->GetDirectory() != file.get()) {
+            ++nErrors;
+            return;
+         }
+         tree->SetCacheSize(100000);
+         Long64_t x = -1;
+         tree->SetBranchAddress("x", &x);
+         // Start from different clusters, such that the threads read different parts of the file.
+         for (Long64_t n = 0; n < kNEntries; ++n) {
+            const Long64_t i = (n + t * kNEntries / kNThreads) % kNEntries;
+            if (tree->GetEntry(i) <= 0 || x != i) {
+               ++nErrors;
+               return;
+            }
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+
+   EXPECT_EQ(nErrors, 0);
+   // The trees removed themselves from the file when deleted.
+   EXPECT_EQ(file->GetList()->GetSize(), 0);
+   file->Close();
+   gSystem->Unlink(fileName);
+}
+
+TEST(TFile, ConcurrentReadClose)
+{
+   auto fileName = "tfile_concurrentread_close.root";
+   WriteTree(fileName);
+   ROOT::EnableThreadSafety();
+   std::unique_ptr<TFile> file{TFile::Open(fileName, "READ_CONCURRENT")};
+   ASSERT_NE(file, nullptr);
+
+   // The trees, owned by the file, and the default read cache of each thread are
+   // still alive when the file is closed: the file drops the state of every
+   // thread, and then deletes the trees with their caches.
+   std::vector<TTree *> trees(kNThreads, nullptr);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < kNThreads; ++t) {
+      threads.emplace_back([&file, &trees, t]() {
+         auto key = file->GetKey("tree");
+         trees[t] = key ? key->ReadObject<TTree>() : nullptr;
+         if (trees[t]) {
+            trees[t]->SetCacheSize(100000);
+            trees[t]->GetEntry(0);
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+
+   for (auto tree : trees) {
+      ASSERT_NE(tree, nullptr);
+      EXPECT_NE(file->GetCacheRead(tree), nullptr);
+   }
+   EXPECT_EQ(file->GetList()->GetSize(), kNThreads);
+   file->Close();
+   EXPECT_EQ(file->GetList()->GetSize(), 0);
+   EXPECT_EQ(file->GetCacheRead(), nullptr);
+   gSystem->Unlink(fileName);
+}
@@ -1,8 +1,12 @@
 #include "ROOT/TestSupport.hxx"
+#include "RConfigure.h"
 
 #include "TFileMerger.h"
 
+#include "TFile.h"
 #include "TMemFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
 #include "TTree.h"
 
 static void CreateATuple(TMemFile &file, const char *name, double value)
@@ -68,3 +72,59 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    ROOT_EXPECT_ERROR(merger.OutputFile(std::move(output)), "TFileMerger::OutputFile",
                      "output file output.root is not writable");
 }
+
+static void MergeWithRecompression()
+{
+   const char *inputs[] = {"recompress_a.root", "recompress_b.root"};
+   for (auto name : inputs) {
+      TFile file(name, "RECREATE", "", ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose);
+      TTree tree("tree", "A tree");
+      tree.SetImplicitMT(false);
+      Long64_t x = 0;
+      tree.Branch("x", &x);
+      for (x = 0; x < 100000; ++x)
+         tree.Fill();
+      file.Write();
+   }
+
+   {
+      TFileMerger merger(kFALSE, kFALSE);
+      ASSERT_TRUE(merger.OutputFile("recompress_out.root", "RECREATE", ROOT::RCompressionSetting::EDefaults::kUseAnalysis));
+      for (auto name : inputs)
+         merger.AddFile(name, kFALSE);
+      EXPECT_TRUE(merger.HasCompressionChange());
+      ASSERT_TRUE(merger.Merge());
+   }
+
+   TFile file("recompress_out.root");
+   auto tree = file.Get<TTree>("tree");
+   ASSERT_NE(tree, nullptr);
+   ASSERT_EQ(tree->GetEntries(), 200000);
+   EXPECT_EQ(tree->GetBranch("x")->GetCompressionSettings(), ROOT::RCompressionSetting::EDefaults::kUseAnalysis);
+   Long64_t x = -1;
+   tree->SetBranchAddress("x", &x);
+   for (Long64_t i = 0; i < tree->GetEntries(); ++i) {
+      tree->GetEntry(i);
+      ASSERT_EQ(x, i % 100000);
+   }
+   tree->ResetBranchAddresses();
+
+   for (auto name : inputs)
+      gSystem->Unlink(name);
+   gSystem->Unlink("recompress_out.root");
+}
+
+TEST(TFileMerger, RecompressBaskets)
+{
+   MergeWithRecompression();
+}
+
+#ifdef R__USE_IMT
+TEST(TFileMerger, RecompressBasketsIMT)
+{
+   // The baskets are compressed again by concurrent tasks
+   ROOT::EnableImplicitMT(4);
+   MergeWithRecompression();
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -1,9 +1,13 @@
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
 
+#include "TArrayC.h"
 #include "TFile.h"
+#include "TFileCacheWrite.h"
 #include "TKey.h"
 #include "TNamed.h"
 #include "TPluginManager.h"
@@ -135,3 +139,144 @@ TEST(TFile, ReadWithoutGlobalRegistrationNet)
    const auto netFile = "root://eospublic.cern.ch//eos/root-eos/h1/dstarmb.root";
    TestReadWithoutGlobalRegistrationIfPossible(netFile);
 }
+
+TEST(TFile, AsyncWriting)
+{
+   auto filename{"tfile_asyncwriting.root"};
+   {
+      // uncompressed, such that more than the bound on the bytes in flight is written
+      std::unique_ptr<TFile> f{TFile::Open(filename, "RECREATE", "", 0)};
+      auto cache = new TFileCacheWrite(f.get(), 1);
+      ASSERT_FALSE(cache->SetAsync(1000000));
+      EXPECT_TRUE(cache->IsAsync());
+      for (int i = 0; i < 100; ++i) {
+         std::vector<int> vec(10000, i);
+         f->WriteObject(&vec, ("vec" + std::to_string(i)).c_str());
+      }
+      // read back objects which might still be written by the writing thread
+      auto vec = f->Get<std::vector<int>>("vec99");
+      ASSERT_NE(vec, nullptr);
+      EXPECT_EQ(vec->back(), 99);
+      f->Close();
+      EXPECT_FALSE(f->TestBit(TFile::kWriteError));
+      EXPECT_GT(f->GetBytesWritten(), 100 * 10000 * (Long64_t)sizeof(int));
+   }
+
+   TFile input{filename};
+   for (int i = 0; i < 100; ++i) {
+      auto vec = input.Get<std::vector<int>>(("vec" + std::to_string(i)).c_str());
+      ASSERT_NE(vec, nullptr);
+      EXPECT_EQ(vec->size(), 10000u);
+      EXPECT_EQ(vec->front(), i);
+   }
+   input.Close();
+   gSystem->Unlink(filename);
+}
+
+TEST(TFile, LazyKeys)
+{
+   auto filename{"tfile_lazykeys.root"};
+   {
+      TFile f{filename, "RECREATE"};
+      for (int i = 0; i < 1000; ++i) {
+         TNamed named{("obj" + std::to_string(i)).c_str(), std::to_string(i).c_str()};
+         named.Write();
+      }
+      // more cycles
+      for (int i = 0; i < 2; ++i) {
+         TNamed named{"obj0", "new"};
+         named.Write();
+      }
+      auto sub = f.mkdir("sub");
+      sub->cd();
+      TNamed named{"inner", "inner"};
+      named.Write();
+      f.Write();
+   }
+
+   auto names = [](TDirectory &dir) {
+      std::vector<std::string> result;
+      for (auto key : TRangeDynCast<TKey>(dir.GetListOfKeys()))
+         result.emplace_back(std::string(key->GetName()) + ";" + std::to_string(key->GetCycle()));
+      return result;
+   };
+   std::vector<std::string> expected;
+   {
+      // The keys are read eagerly by a writable file.
+      TFile f{filename, "UPDATE"};
+      expected = names(f);
+   }
+   ASSERT_EQ(expected.size(), 1003u);
+
+   TFile input{filename};
+   // Opening the file creates no key, counting them neither.
+   EXPECT_EQ(ROOT::Internal::GetNKeysCreated(input), 0);
+   EXPECT_EQ(input.GetNkeys(), 1003);
+   EXPECT_EQ(ROOT::Internal::GetNKeysCreated(input), 0);
+   auto key = input.GetKey("obj0");
+   ASSERT_NE(key, nullptr);
+   EXPECT_EQ(key->GetCycle(), 3);
+   // Looking up a name creates the keys of all its cycles only.
+   EXPECT_EQ(ROOT::Internal::GetNKeysCreated(input), 3);
+   key = input.GetKey("obj0", 1);
+   ASSERT_NE(key, nullptr);
+   EXPECT_EQ(key->GetCycle(), 1);
+   auto named = input.Get<TNamed>("obj500");
+   ASSERT_NE(named, nullptr);
+   EXPECT_STREQ(named->GetTitle(), "500");
+   EXPECT_EQ(input.Get<TNamed>("missing"), nullptr);
+   EXPECT_EQ(ROOT::Internal::GetNKeysCreated(input), 4);
+   auto inner = input.Get<TNamed>("sub/inner");
+   ASSERT_NE(inner, nullptr);
+   EXPECT_STREQ(inner->GetTitle(), "inner");
+   delete input.GetKey("obj1");
+
+   // The keys looked up above keep their place in the list.
+   auto actual = names(input);
+   EXPECT_EQ(ROOT::Internal::GetNKeysCreated(input), 1002);
+   expected.erase(std::find(expected.begin(), expected.end(), "obj1;1"));
+   EXPECT_EQ(actual, expected);
+   EXPECT_EQ(input.GetNkeys(), 1002);
+   input.Close();
+   gSystem->Unlink(filename);
+}
+
+TEST(TFile, SharedStreamerInfoRecord)
+{
+   const std::vector<std::string> filenames{"tfile_sharedsi_0.root", "tfile_sharedsi_1.root"};
+   for (const auto &filename : filenames) {
+      TFile f{filename.c_str(), "RECREATE"};
+      std::vector<int> vec{1, 2, 3};
+      f.WriteObject(&vec, "vec");
+      TNamed named{"named", "title"};
+      named.Write();
+   }
+
+   // The second file has the same StreamerInfo record as the first one: it is
+   // not decoded again, but the class index and the decoded list are the same.
+   TFile first{filenames[0].c_str()};
+   TFile second{filenames[1].c_str()};
+   ASSERT_NE(first.GetStreamerInfoCache(), nullptr);
+   EXPECT_EQ(first.GetStreamerInfoCache(), second.GetStreamerInfoCache());
+   ASSERT_NE(first.GetClassIndex(), nullptr);
+   ASSERT_NE(second.GetClassIndex(), nullptr);
+   std::vector<int> firstIndex, secondIndex;
+   for (int i = 0; i < first.GetClassIndex()->GetSize(); ++i) {
+      if (first.GetClassIndex()->At(i))
+         firstIndex.push_back(i);
+   }
+   for (int i = 0; i < second.GetClassIndex()->GetSize(); ++i) {
+      if (second.GetClassIndex()->At(i))
+         secondIndex.push_back(i);
+   }
+   EXPECT_FALSE(firstIndex.empty());
+   EXPECT_EQ(firstIndex, secondIndex);
+   auto vec = second.Get<std::vector<int>>("vec");
+   ASSERT_NE(vec, nullptr);
+   EXPECT_EQ(vec->back(), 3);
+
+   first.Close();
+   second.Close();
+   for (const auto &filename : filenames)
+      gSystem->Unlink(filename.c_str());
+}
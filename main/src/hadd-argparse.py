@@ -10,9 +10,10 @@ def get_argparse():
         "not be one of the source files.")
 
     EPILOGUE = textwrap.fill(
-        "If TARGET and SOURCES have different compression settings a slower "
-        "method is used. For options that takes a size as argument, a decimal "
-        "number of bytes is expected. If the number ends with a ``k'', ``m'', "
+        "If TARGET and SOURCES have different compression settings the baskets "
+        "of the trees are unzipped and zipped again, by the number of threads given "
+        "with -j if there are too few files for several processes. For options "
+        "that takes a size as argument, a decimal number of bytes is expected. If the number ends with a ``k'', ``m'', "
         "``g'', etc., the number is multiplied by 1000 (1K), 1000000 (1MB), "
         "1000000000 (1G), etc. If this prefix is followed by i, the number is "
         "multiplied by the traditional 1024 (1KiB), 1048576 (1MiB), 1073741824 "
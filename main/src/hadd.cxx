@@ -79,6 +79,14 @@
   the merge will be done without  unzipping or unstreaming the baskets
   (i.e. direct copy of the raw byte on disk). The "fast" mode is typically
   5 times faster than the mode unzipping and unstreaming the baskets.
+  If the sources and target compression levels differ, the baskets are still
+  copied without unstreaming them but they are unzipped and zipped again with
+  the target compression settings. With -j, this is done by several
+  threads when there are too few files to merge them in several processes
+  (and ROOT is built with implicit multi-threading support).
+  This does not apply to the TTrees that can not be fast cloned (e.g. with -O,
+  or when their branches differ from the ones of the first source): their
+  entries are unzipped, unstreamed, streamed and zipped again one by one.
 
   If the option -cachesize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
@@ -103,6 +111,7 @@
 #include "THashList.h"
 #include "TKey.h"
 #include "TClass.h"
+#include "TROOT.h"
 #include "TSystem.h"
 #include "TUUID.h"
 #include "ROOT/StringConv.hxx"
@@ -139,6 +148,7 @@ int main( int argc, char **argv )
    Bool_t keepCompressionAsIs = kFALSE;
    Bool_t useFirstInputCompression = kFALSE;
    Bool_t multiproc = kFALSE;
+   Bool_t jobsRequested = kFALSE;
    Bool_t debug = kFALSE;
    Int_t maxopenedfiles = 0;
    Int_t verbosity = 99;
@@ -212,6 +222,7 @@ int main( int argc, char **argv )
             }
          }
          multiproc = kTRUE;
+         jobsRequested = kTRUE;
          ++ffirst;
       } else if ( strcmp(argv[a],"-cachesize=") == 0 ) {
          int size;
@@ -424,6 +435,8 @@ int main( int argc, char **argv )
       exit(1);
    }
 
+   // The number of processes requested with -j, which is reduced below if there are not enough files
+   const auto nJobs = nProcesses;
    auto filesToProcess = argc - ffirst;
    auto step = (filesToProcess + nProcesses - 1) / nProcesses;
    if (multiproc && step < 3) {
@@ -460,7 +473,13 @@ int main( int argc, char **argv )
          if (!keepCompressionAsIs && merger.HasCompressionChange()) {
             // Don't warn if the user any request re-optimization.
             std::cout << "hadd Sources and Target have different compression levels" << std::endl;
-            std::cout << "hadd merging will be slower" << std::endl;
+            std::cout << "hadd the baskets of the TTrees will be compressed again" << std::endl;
+#ifdef R__USE_IMT
+            // With -j, compress the baskets with as many threads, unless the files are already merged by
+            // several processes.
+            if (jobsRequested && !multiproc && nJobs > 1)
+               ROOT::EnableImplicitMT(nJobs);
+#endif
          }
       }
       merger.SetNotrees(noTrees);
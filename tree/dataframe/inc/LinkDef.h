@@ -61,6 +61,7 @@
 #pragma link C++ class ROOT::Detail::RDF::RMergeableVariationsBase+;
 #pragma link C++ class TNotifyLink<ROOT::Internal::RDF::RNewSampleFlag>;
 #pragma link C++ class ROOT::RDF::RCutFlowReport;
+#pragma link C++ class ROOT::RDF::Experimental::RProfileReport;
 
 #endif
 
@@ -13,6 +13,8 @@
 #include "ROOT/RDataSource.hxx"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace arrow {
 class Table;
@@ -40,6 +42,7 @@ private:
 
 public:
    RArrowDS(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columns);
+   RArrowDS(std::string_view fileName, std::vector<std::string> const &columns);
    ~RArrowDS();
    const std::vector<std::string> &GetColumnNames() const final;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
@@ -54,6 +57,8 @@ public:
 
 RDataFrame FromArrow(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columnNames);
 
+RDataFrame FromArrowIPC(std::string_view fileName, std::vector<std::string> const &columnNames = {});
+
 } // namespace RDF
 
 } // namespace ROOT
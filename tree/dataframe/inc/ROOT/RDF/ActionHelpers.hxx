@@ -48,6 +48,7 @@
 #include "ROOT/RDF/RMergeableValue.hxx"
 
 #include <algorithm>
+#include <atomic> // for TakeIntoHelper
 #include <functional>
 #include <limits>
 #include <memory>
@@ -57,6 +58,7 @@
 #include <utility> // std::index_sequence
 #include <vector>
 #include <iomanip>
+#include <mutex> // for SharedFillHelper
 #include <numeric> // std::accumulate in MeanHelper
 
 /// \cond HIDDEN_SYMBOLS
@@ -557,6 +559,169 @@ public:
    }
 };
 
+/// Fill helper for histograms that are too large to be replicated once per processing slot (e.g. big TH3Ds or THnDs).
+///
+/// Instead of filling one copy of the histogram per slot and merging the copies at the end, as FillHelper does, all
+/// slots fill the same histogram. Each slot accumulates the values to fill in a small private buffer, which is flushed
+/// into the shared histogram under a lock every fgBufferedFills fills and at the end of each task, so that the lock is
+/// taken rarely. Memory usage does not grow with the number of slots, at the cost of serializing the actual fills.
+/// BuildAction picks this helper over FillHelper when the per-slot copies would exceed GetSharedFillThreshold() bytes.
+template <typename HIST>
+class R__CLING_PTRCHECK(off) SharedFillHelper : public RActionImpl<SharedFillHelper<HIST>> {
+   /// Number of fills that each slot buffers before flushing them into the shared histogram.
+   static constexpr std::size_t fgBufferedFills = 1024;
+   using Buf_t = std::vector<double>;
+   using FlushFunc_t = void (SharedFillHelper::*)(const Buf_t &);
+
+   std::shared_ptr<HIST> fResultHist;
+   /// Per-slot values to be filled, flattened: each fill takes as many consecutive elements as Exec has arguments.
+   std::vector<Buf_t> fBuffers;
+   /// Per-slot function that fills the shared histogram with the contents of the slot's buffer.
+   std::vector<FlushFunc_t> fFlushFuncs;
+   /// Serializes the fills of the shared histogram. Held by pointer so that the helper stays movable.
+   std::unique_ptr<std::mutex> fMutex;
+   /// Per-slot copies of the shared histogram returned by PartialUpdate, created only if partial results are requested.
+   std::vector<std::unique_ptr<HIST>> fPartialResults;
+
+   void UnsetDirectoryIfPossible(TH1 *h) { h->SetDirectory(nullptr); }
+
+   void UnsetDirectoryIfPossible(...) {}
+
+   template <std::size_t... Is>
+   void FillFromBuffer(const Buf_t &buf, std::index_sequence<Is...>)
+   {
+      constexpr auto nArgs = sizeof...(Is);
+      for (std::size_t i = 0u; i < buf.size(); i += nArgs)
+         fResultHist->Fill(buf[i + Is]...);
+   }
+
+   template <std::size_t NArgs>
+   void FlushBuffer(const Buf_t &buf)
+   {
+      FillFromBuffer(buf, std::make_index_sequence<NArgs>());
+   }
+
+   void Flush(unsigned int slot)
+   {
+      auto &buf = fBuffers[slot];
+      if (buf.empty())
+         return;
+      {
+         std::lock_guard<std::mutex> lock(*fMutex);
+         (this->*fFlushFuncs[slot])(buf);
+      }
+      buf.clear();
+   }
+
+   template <typename T, std::enable_if_t<!IsDataContainer<T>::value, int> = 0>
+   static double GetValue(const T &v, std::size_t)
+   {
+      return v;
+   }
+
+   template <typename T, std::enable_if_t<IsDataContainer<T>::value, int> = 0>
+   static double GetValue(const T &v, std::size_t i)
+   {
+      return v[i];
+   }
+
+   template <typename T, std::enable_if_t<!IsDataContainer<T>::value, int> = 0>
+   static std::size_t GetSize(const T &)
+   {
+      return 1;
+   }
+
+   template <typename T, std::enable_if_t<IsDataContainer<T>::value, int> = 0>
+   static std::size_t GetSize(const T &v)
+   {
+      return v.size();
+   }
+
+public:
+   SharedFillHelper(SharedFillHelper &&) = default;
+   SharedFillHelper(const SharedFillHelper &) = delete;
+
+   SharedFillHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots)
+      : fResultHist(h), fBuffers(nSlots), fFlushFuncs(nSlots, nullptr), fMutex(new std::mutex), fPartialResults(nSlots)
+   {
+   }
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   template <typename... Xs>
+   void Exec(unsigned int slot, const Xs &...xs)
+   {
+      constexpr std::array<bool, sizeof...(Xs)> isContainer{IsDataContainer<Xs>::value...};
+      const std::array<std::size_t, sizeof...(Xs)> sizes{{GetSize(xs)...}};
+
+      // scalars are broadcast to the size of the container arguments, if any
+      std::size_t nFills = 1;
+      bool foundContainer = false;
+      for (std::size_t i = 0; i < sizeof...(Xs); ++i) {
+         if (!isContainer[i])
+            continue;
+         if (foundContainer && sizes[i] != nFills)
+            throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
+         nFills = sizes[i];
+         foundContainer = true;
+      }
+
+      auto &buf = fBuffers[slot];
+      fFlushFuncs[slot] = &SharedFillHelper::FlushBuffer<sizeof...(Xs)>;
+      for (std::size_t i = 0; i < nFills; ++i) {
+         // the braced initializer guarantees that the values are pushed in order
+         using expander = int[];
+         (void)expander{0, (buf.push_back(GetValue(xs, i)), 0)...};
+      }
+      if (buf.size() >= fgBufferedFills * sizeof...(Xs))
+         Flush(slot);
+   }
+
+   void Initialize() { /* noop */}
+
+   void FinalizeTask(unsigned int slot) { Flush(slot); }
+
+   void Finalize()
+   {
+      for (auto slot = 0u; slot < fBuffers.size(); ++slot)
+         Flush(slot);
+   }
+
+   /// Flush this slot's buffer and return a snapshot of the shared histogram, taken under the lock since other slots
+   /// might be filling it concurrently. The snapshot is owned by the slot and replaced at its next partial update.
+   HIST &PartialUpdate(unsigned int slot)
+   {
+      Flush(slot);
+      std::unique_ptr<HIST> snapshot;
+      {
+         std::lock_guard<std::mutex> lock(*fMutex);
+         snapshot.reset(static_cast<HIST *>(fResultHist->Clone()));
+      }
+      UnsetDirectoryIfPossible(snapshot.get());
+      fPartialResults[slot] = std::move(snapshot);
+      return *fPartialResults[slot];
+   }
+
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableFill<HIST>>(*fResultHist);
+   }
+
+   std::string GetActionName()
+   {
+      return std::string(fResultHist->IsA()->GetName()) + "\\n" + std::string(fResultHist->GetName());
+   }
+
+   SharedFillHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<HIST> *>(newResult);
+      result->Reset();
+      UnsetDirectoryIfPossible(result.get());
+      return SharedFillHelper(result, fBuffers.size());
+   }
+};
+
 class R__CLING_PTRCHECK(off) FillTGraphHelper : public ROOT::Detail::RDF::RActionImpl<FillTGraphHelper> {
 public:
    using Result_t = ::TGraph;
@@ -991,6 +1156,117 @@ extern template class TakeHelper<float, float, std::vector<float>>;
 extern template class TakeHelper<double, double, std::vector<double>>;
 #endif
 
+/// Write the values of a column of fundamental type into a contiguous buffer owned by the caller.
+///
+/// Processing slots reserve blocks of the buffer from a shared atomic cursor and write their values in place, so
+/// that no per-slot collection has to be grown and merged. At the end of the event loop the blocks are compacted
+/// towards the front of the buffer (partially filled blocks leave holes) and the result is the number of values
+/// written. Values that do not fit in the reserved blocks once the buffer is fully booked are parked per slot and
+/// copied in the space freed by the compaction; an exception is thrown if they do not fit either.
+template <typename T>
+class R__CLING_PTRCHECK(off) TakeIntoHelper : public RActionImpl<TakeIntoHelper<T>> {
+   static_assert(std::is_arithmetic<T>::value, "TakeInto only supports columns of fundamental types");
+
+   struct RBlock {
+      ULong64_t fBegin = 0; ///< First position of the block in the buffer
+      ULong64_t fPos = 0;   ///< Next position to be written
+      ULong64_t fEnd = 0;   ///< One past the last position of the block
+   };
+
+   std::shared_ptr<ULong64_t> fResultSize;
+   T *fBuffer;
+   ULong64_t fCapacity;
+   ULong64_t fBlockSize;
+   std::unique_ptr<std::atomic<ULong64_t>> fCursor;
+   std::vector<RBlock> fCurrentBlocks;             ///< The block each slot is currently writing to
+   std::vector<std::vector<RBlock>> fFullBlocks;   ///< The blocks each slot has completely filled
+   std::vector<std::vector<T>> fOverflows;         ///< Values that did not find a place in the buffer, per slot
+
+   void NextBlock(unsigned int slot)
+   {
+      auto &block = fCurrentBlocks[slot];
+      if (block.fEnd > block.fBegin)
+         fFullBlocks[slot].emplace_back(block);
+      const auto begin = fCursor->fetch_add(fBlockSize);
+      block.fBegin = block.fPos = std::min(begin, fCapacity);
+      block.fEnd = std::min(begin + fBlockSize, fCapacity);
+   }
+
+public:
+   using Result_t = ULong64_t;
+   using ColumnTypes_t = TypeList<T>;
+
+   TakeIntoHelper(T *buffer, ULong64_t capacity, unsigned int nSlots)
+      : fResultSize(std::make_shared<ULong64_t>(0ull)), fBuffer(buffer), fCapacity(capacity),
+        // small enough that the holes left by partially filled blocks are a small fraction of the buffer
+        fBlockSize(std::max(1ull, std::min(ULong64_t(64 * 1024), capacity / (16ull * nSlots)))),
+        fCursor(std::make_unique<std::atomic<ULong64_t>>(0ull)), fCurrentBlocks(nSlots), fFullBlocks(nSlots),
+        fOverflows(nSlots)
+   {
+   }
+   TakeIntoHelper(TakeIntoHelper &&) = default;
+   TakeIntoHelper(const TakeIntoHelper &) = delete;
+
+   std::shared_ptr<ULong64_t> GetResultPtr() const { return fResultSize; }
+
+   void Initialize()
+   {
+      fCursor->store(0ull);
+      std::fill(fCurrentBlocks.begin(), fCurrentBlocks.end(), RBlock{});
+      for (auto &blocks : fFullBlocks)
+         blocks.clear();
+      for (auto &overflow : fOverflows)
+         overflow.clear();
+   }
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, const T &v)
+   {
+      auto &block = fCurrentBlocks[slot];
+      if (block.fPos == block.fEnd) {
+         if (block.fEnd < fCapacity || block.fEnd == 0)
+            NextBlock(slot);
+         if (block.fPos == block.fEnd) { // the buffer is fully booked
+            fOverflows[slot].emplace_back(v);
+            return;
+         }
+      }
+      fBuffer[block.fPos++] = v;
+   }
+
+   void Finalize()
+   {
+      std::vector<RBlock> blocks;
+      for (auto slot = 0u; slot < fCurrentBlocks.size(); ++slot) {
+         blocks.insert(blocks.end(), fFullBlocks[slot].begin(), fFullBlocks[slot].end());
+         if (fCurrentBlocks[slot].fPos > fCurrentBlocks[slot].fBegin)
+            blocks.emplace_back(fCurrentBlocks[slot]);
+      }
+      std::sort(blocks.begin(), blocks.end(), [](const RBlock &a, const RBlock &b) { return a.fBegin < b.fBegin; });
+
+      // blocks are visited in buffer order, so values are only ever moved towards the front
+      ULong64_t size = 0ull;
+      for (const auto &block : blocks) {
+         if (block.fBegin != size)
+            std::copy(fBuffer + block.fBegin, fBuffer + block.fPos, fBuffer + size);
+         size += block.fPos - block.fBegin;
+      }
+
+      for (const auto &overflow : fOverflows) {
+         if (overflow.size() > fCapacity - size)
+            throw std::runtime_error("TakeInto: the output buffer of size " + std::to_string(fCapacity) +
+                                     " is too small for the values of the column.");
+         std::copy(overflow.begin(), overflow.end(), fBuffer + size);
+         size += overflow.size();
+      }
+
+      *fResultSize = size;
+   }
+
+   std::string GetActionName() { return "TakeInto"; }
+};
+
 template <typename ResultType>
 class R__CLING_PTRCHECK(off) MinHelper : public RActionImpl<MinHelper<ResultType>> {
    std::shared_ptr<ResultType> fResultMin;
@@ -15,6 +15,9 @@
 #include <memory>
 #include <vector>
 #include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+
+#include <cstdio>
 
 #include <iostream>
 
@@ -129,6 +132,17 @@ public:
    /// \brief Appends a node on the head of the current node
    void SetPrevNode(const std::shared_ptr<GraphNode> &node) { fPrevNode = node; }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Appends the profiling information of the corresponding RDF node to the label, if any was recorded
+   void AddProfile(ULong64_t nCalls, ULong64_t nanoseconds)
+   {
+      if (nCalls == 0)
+         return;
+      char buf[64];
+      std::snprintf(buf, sizeof(buf), "\\n%llu calls, %.3f ms", nCalls, nanoseconds * 1e-6);
+      fName += buf;
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Adds the column defined up to the node
    void AddDefinedColumns(const std::vector<std::string> &columns) { fDefinedColumns = columns; }
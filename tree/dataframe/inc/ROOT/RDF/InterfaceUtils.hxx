@@ -29,6 +29,8 @@
 #include <ROOT/TypeTraits.hxx>
 #include <TError.h> // gErrorIgnoreLevel
 #include <TH1.h>
+#include <TH3.h>
+#include <THn.h>
 #include <TROOT.h> // IsImplicitMTEnabled
 
 #include <deque>
@@ -155,6 +157,86 @@ BuildAction(const ColumnNames_t &bl, const std::shared_ptr<::TH1D> &h, const uns
    }
 }
 
+/// Return the threshold, in bytes, above which per-slot copies of a TH3D or THnD are considered too expensive.
+ULong64_t GetSharedFillThreshold();
+void SetSharedFillThreshold(ULong64_t nBytes);
+
+inline ULong64_t GetHistoMemorySize(const ::TH3D &h)
+{
+   return (ULong64_t(h.GetNcells()) + h.GetSumw2N()) * sizeof(Double_t);
+}
+
+inline ULong64_t GetHistoMemorySize(const ::THnD &h)
+{
+   return ULong64_t(h.GetNbins()) * sizeof(Double_t) * (h.GetCalculateErrors() ? 2 : 1);
+}
+
+/// Whether a value of type T (or each element of T, if T is a collection) can be buffered as a double.
+template <typename T, bool IsContainer = IsDataContainer<T>::value>
+struct IsSharedFillable : std::is_arithmetic<T> {
+};
+
+template <typename T>
+struct IsSharedFillable<T, true> : std::is_arithmetic<typename T::value_type> {
+};
+
+template <typename... ColTypes>
+constexpr bool AreSharedFillable()
+{
+   constexpr std::array<bool, sizeof...(ColTypes)> fillable{{IsSharedFillable<ColTypes>::value...}};
+   for (auto f : fillable)
+      if (!f)
+         return false;
+   return true;
+}
+
+template <typename... ColTypes, typename HIST, typename PrevNodeType,
+          std::enable_if_t<AreSharedFillable<ColTypes...>(), int> = 0>
+std::unique_ptr<RActionBase>
+BuildLargeHistoAction(const ColumnNames_t &bl, const std::shared_ptr<HIST> &h, const unsigned int nSlots,
+                      std::shared_ptr<PrevNodeType> prevNode, const RColumnRegister &colRegister)
+{
+   // one histogram copy per slot would cost (nSlots - 1) times the histogram size in extra memory
+   if (nSlots > 1 && GetHistoMemorySize(*h) * (nSlots - 1) > GetSharedFillThreshold()) {
+      using Helper_t = SharedFillHelper<HIST>;
+      using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
+      return std::make_unique<Action_t>(Helper_t(h, nSlots), bl, std::move(prevNode), colRegister);
+   }
+   using Helper_t = FillHelper<HIST>;
+   using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
+   return std::make_unique<Action_t>(Helper_t(h, nSlots), bl, std::move(prevNode), colRegister);
+}
+
+// column types that cannot be buffered as doubles (e.g. strings for labelled axes) always use FillHelper
+template <typename... ColTypes, typename HIST, typename PrevNodeType,
+          std::enable_if_t<!AreSharedFillable<ColTypes...>(), int> = 0>
+std::unique_ptr<RActionBase>
+BuildLargeHistoAction(const ColumnNames_t &bl, const std::shared_ptr<HIST> &h, const unsigned int nSlots,
+                      std::shared_ptr<PrevNodeType> prevNode, const RColumnRegister &colRegister)
+{
+   using Helper_t = FillHelper<HIST>;
+   using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
+   return std::make_unique<Action_t>(Helper_t(h, nSlots), bl, std::move(prevNode), colRegister);
+}
+
+// Histo3D filling (large histograms are filled concurrently by all slots instead of being replicated)
+template <typename... ColTypes, typename PrevNodeType>
+std::unique_ptr<RActionBase>
+BuildAction(const ColumnNames_t &bl, const std::shared_ptr<::TH3D> &h, const unsigned int nSlots,
+            std::shared_ptr<PrevNodeType> prevNode, ActionTags::Histo3D, const RColumnRegister &colRegister)
+{
+   return BuildLargeHistoAction<ColTypes...>(bl, h, nSlots, std::move(prevNode), colRegister);
+}
+
+// HistoND filling (large histograms are filled concurrently by all slots instead of being replicated)
+template <typename... ColTypes, typename PrevNodeType>
+std::unique_ptr<RActionBase>
+BuildAction(const ColumnNames_t &bl, const std::shared_ptr<::THnD> &h, const unsigned int nSlots,
+            std::shared_ptr<PrevNodeType> prevNode, ActionTags::HistoND, const RColumnRegister &colRegister)
+{
+   return BuildLargeHistoAction<ColTypes...>(bl, h, nSlots, std::move(prevNode), colRegister);
+}
+
 template <typename... ColTypes, typename PrevNodeType>
 std::unique_ptr<RActionBase>
 BuildAction(const ColumnNames_t &bl, const std::shared_ptr<TGraph> &g, const unsigned int nSlots,
@@ -108,8 +108,10 @@ public:
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevNode.CheckFilters(slot, entry))
+      if (fPrevNode.CheckFilters(slot, entry)) {
+         RNodeProfileScope profileScope(fProfile, slot, fLoopManager->IsProfilingEnabled());
          CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+      }
    }
 
    void TriggerChildrenCount() final { fPrevNode.IncrChildrenCount(); }
@@ -139,6 +141,7 @@ public:
       const auto nodeType = HasRun() ? RDFGraphDrawing::ENodeType::kUsedAction : RDFGraphDrawing::ENodeType::kAction;
       auto thisNode =
          std::make_shared<RDFGraphDrawing::GraphNode>(fHelper.GetActionName(), visitedMap.size(), nodeType);
+      thisNode->AddProfile(GetProfile().GetNCalls(), GetProfile().GetNanoseconds());
       visitedMap[(void *)this] = thisNode;
 
       auto upmostNode = AddDefinesToGraph(thisNode, GetColRegister(), prevColumns, visitedMap);
@@ -152,6 +155,8 @@ public:
    /// user-defined callback registered via RResultPtr::RegisterCallback
    void *PartialUpdate(unsigned int slot) final { return fHelper.CallPartialUpdate(slot); }
 
+   std::string GetActionName() final { return fHelper.GetActionName(); }
+
    std::unique_ptr<RActionBase> MakeVariedAction(std::vector<void *> &&results) final
    {
       const auto nVariations = GetVariations().size();
@@ -12,6 +12,7 @@
 #define ROOT_RACTIONBASE
 
 #include "ROOT/RDF/RColumnRegister.hxx"
+#include "ROOT/RDF/RNodeProfile.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "RtypesCore.h"
@@ -52,6 +53,9 @@ private:
 
    RColumnRegister fColRegister;
 
+protected:
+   RNodeProfile fProfile; ///< Time spent executing this action, only filled when profiling is enabled
+
 public:
    RActionBase(RLoopManager *lm, const ColumnNames_t &colNames, const RColumnRegister &colRegister,
                const std::vector<std::string> &prevVariations);
@@ -90,6 +94,10 @@ public:
 
    const std::vector<std::string> &GetVariations() const { return fVariations; }
 
+   virtual std::string GetActionName() = 0;
+   const RNodeProfile &GetProfile() const { return fProfile; }
+   void ResetProfile() { fProfile.Reset(); }
+
    virtual std::unique_ptr<RActionBase> MakeVariedAction(std::vector<void *> &&results) = 0;
    virtual std::unique_ptr<RActionBase> CloneAction(void *newResult) = 0;
 };
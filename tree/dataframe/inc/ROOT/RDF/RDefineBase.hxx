@@ -13,6 +13,7 @@
 
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RColumnRegister.hxx"
+#include "ROOT/RDF/RNodeProfile.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RVec.hxx"
@@ -48,6 +49,7 @@ protected:
    ROOT::RVecB fIsDefine;
    std::vector<std::string> fVariationDeps; ///< List of systematic variations that affect the value of this define.
    std::string fVariation;                  ///< This indicates for what variation this define evaluates values.
+   RDFInternal::RNodeProfile fProfile; ///< Time spent evaluating this define, only filled when profiling is enabled
 
 public:
    RDefineBase(std::string_view name, std::string_view type, const RDFInternal::RColumnRegister &colRegister,
@@ -76,6 +78,11 @@ public:
 
    /// Return a clone of this Define that works with values in the variationName "universe".
    virtual RDefineBase &GetVariedDefine(const std::string &variationName) = 0;
+
+   std::string GetVariation() const { return fVariation; }
+   /// Overridden by RJittedDefine, which forwards to the concrete define.
+   virtual const RDFInternal::RNodeProfile &GetProfile() const { return fProfile; }
+   void ResetProfile() { fProfile.Reset(); }
 };
 
 } // ns RDF
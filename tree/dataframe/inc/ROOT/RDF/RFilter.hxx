@@ -96,6 +96,7 @@ public:
             fLastResult[slot * RDFInternal::CacheLineStep<int>()] = false;
          } else {
             // evaluate this filter, cache the result
+            RDFInternal::RNodeProfileScope profileScope(fProfile, slot, fLoopManager->IsProfilingEnabled());
             auto passed = CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
             passed ? ++fAccepted[slot * RDFInternal::CacheLineStep<ULong64_t>()]
                    : ++fRejected[slot * RDFInternal::CacheLineStep<ULong64_t>()];
@@ -133,8 +134,7 @@ public:
 
    void StopProcessing() final
    {
-      ++fNStopsReceived;
-      if (fNStopsReceived == fNChildren)
+      if (++fNStopsReceived == fNChildren)
          fPrevNode.StopProcessing();
    }
 
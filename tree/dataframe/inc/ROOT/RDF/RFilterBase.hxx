@@ -13,6 +13,7 @@
 
 #include "ROOT/RDF/RColumnRegister.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RNodeProfile.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "ROOT/RVec.hxx"
 #include "RtypesCore.h"
@@ -48,6 +49,7 @@ protected:
    ROOT::RVecB fIsDefine;
    std::string fVariation; ///< This indicates for what variation this filter evaluates values.
    std::unordered_map<std::string, std::shared_ptr<RFilterBase>> fVariedFilters;
+   RDFInternal::RNodeProfile fProfile; ///< Time spent evaluating this filter, only filled when profiling is enabled
 
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots,
@@ -72,6 +74,7 @@ public:
    /// Clean-up operations to be performed at the end of a task.
    virtual void FinalizeSlot(unsigned int slot) = 0;
    virtual void InitNode();
+   const RDFInternal::RNodeProfile &GetProfile() const { return fProfile; }
 };
 
 } // ns RDF
@@ -89,6 +89,8 @@ class GraphCreatorHelper;
 void ChangeEmptyEntryRange(const ROOT::RDF::RNode &node, std::pair<ULong64_t, ULong64_t> &&newRange);
 void ChangeSpec(const ROOT::RDF::RNode &node, ROOT::RDF::Experimental::RDatasetSpec &&spec);
 void TriggerRun(ROOT::RDF::RNode node);
+void SetProfilingEnabled(const ROOT::RDF::RNode &node, bool enable);
+ROOT::RDF::Experimental::RProfileReport GetProfileReport(const ROOT::RDF::RNode &node);
 } // namespace RDF
 } // namespace Internal
 
@@ -121,6 +123,8 @@ class RInterface : public RInterfaceBase {
    friend void RDFInternal::TriggerRun(RNode node);
    friend void RDFInternal::ChangeEmptyEntryRange(const RNode &node, std::pair<ULong64_t, ULong64_t> &&newRange);
    friend void RDFInternal::ChangeSpec(const RNode &node, ROOT::RDF::Experimental::RDatasetSpec &&spec);
+   friend void RDFInternal::SetProfilingEnabled(const RNode &node, bool enable);
+   friend ROOT::RDF::Experimental::RProfileReport RDFInternal::GetProfileReport(const RNode &node);
 
    std::shared_ptr<Proxied> fProxiedPtr; ///< Smart pointer to the graph node encapsulated by this RInterface.
 
@@ -1232,7 +1236,8 @@ public:
    /// \return the first node of the computation graph for which the event loop is limited to a certain range of entries.
    ///
    /// Note that in case of previous Ranges and Filters the selected range refers to the transformed dataset.
-   /// Ranges are only available if EnableImplicitMT has _not_ been called. Multi-thread ranges are not supported.
+   /// With EnableImplicitMT, which entries are selected by a Range that does not hang directly from the RDataFrame
+   /// depends on the order in which threads process them: see the section on ranges in the RDataFrame documentation.
    ///
    /// ### Example usage:
    /// ~~~{.cpp}
@@ -1246,7 +1251,6 @@ public:
       // check invariants
       if (stride == 0 || (end != 0 && end < begin))
          throw std::runtime_error("Range: stride must be strictly greater than 0 and end must be greater than begin.");
-      CheckIMTDisabled("Range");
 
       using Range_t = RDFDetail::RRange<Proxied>;
       auto rangePtr = std::make_shared<Range_t>(begin, end, stride, fProxiedPtr);
@@ -56,6 +56,7 @@ public:
    void *PartialUpdate(unsigned int slot) final;
    bool HasRun() const final;
    void SetHasRun() final;
+   std::string GetActionName() final;
 
    std::shared_ptr<GraphDrawing::GraphNode>
    GetGraph(std::unordered_map<void *, std::shared_ptr<GraphDrawing::GraphNode>> &visitedMap) final;
@@ -15,6 +15,7 @@
 #include "ROOT/RDF/RColumnReaderBase.hxx"
 #include "ROOT/RDF/RDatasetSpec.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RNodeProfile.hxx"
 #include "ROOT/RDF/RNewSampleNotifier.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
 
@@ -35,6 +36,9 @@ namespace ROOT {
 namespace RDF {
 class RCutFlowReport;
 class RDataSource;
+namespace Experimental {
+class RProfileReport;
+}
 } // ns RDF
 
 namespace Internal {
@@ -135,6 +139,9 @@ class RLoopManager : public RNodeBase {
    const ColumnNames_t fDefaultColumns;
    /// Range of entries created when no data source is specified.
    std::pair<ULong64_t, ULong64_t> fEmptyEntryRange{};
+   /// Entries, relative to the beginning of the dataset, that multi-thread event loops have to process at all, given
+   /// the Ranges booked on this node. See EvalEntryWindow().
+   std::pair<ULong64_t, ULong64_t> fEntryWindow{0ull, std::numeric_limits<ULong64_t>::max()};
    const unsigned int fNSlots{1};
    bool fMustRunNamedFilters{true};
    const ELoopType fLoopType; ///< The kind of event loop that is going to be run (e.g. on ROOT files, on no files)
@@ -157,6 +164,12 @@ class RLoopManager : public RNodeBase {
 
    ROOT::Internal::TreeUtils::RNoCleanupNotifier fNoCleanupNotifier;
 
+   /// Whether nodes should record call counts and timings, and dataset columns their I/O, during the event loop.
+   bool fProfilingEnabled{false};
+   /// Per-slot I/O statistics of the columns read from fTree. Only filled when profiling is enabled.
+   std::vector<RDFInternal::RColumnIOProfile> fColumnIOProfiles;
+   double fLastLoopRealTime{0.}; ///< Wall-clock duration of the last event loop, in seconds
+
    void RunEmptySourceMT();
    void RunEmptySource();
    void RunTreeProcessorMT();
@@ -169,6 +182,7 @@ class RLoopManager : public RNodeBase {
    void CleanUpNodes();
    void CleanUpTask(TTreeReader *r, unsigned int slot);
    void EvalChildrenCounts();
+   void EvalEntryWindow();
    void SetupSampleCallbacks(TTreeReader *r, unsigned int slot);
    void UpdateSampleInfo(unsigned int slot, const std::pair<ULong64_t, ULong64_t> &range);
    void UpdateSampleInfo(unsigned int slot, TTreeReader &r);
@@ -239,6 +253,10 @@ public:
 
    void SetEmptyEntryRange(std::pair<ULong64_t, ULong64_t> &&newRange);
    void ChangeSpec(ROOT::RDF::Experimental::RDatasetSpec &&spec);
+
+   void SetProfilingEnabled(bool enable) { fProfilingEnabled = enable; }
+   bool IsProfilingEnabled() const { return fProfilingEnabled; }
+   ROOT::RDF::Experimental::RProfileReport GetProfileReport() const;
 };
 
 } // ns RDF
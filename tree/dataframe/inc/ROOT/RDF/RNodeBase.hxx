@@ -14,6 +14,7 @@
 #include "RtypesCore.h"
 #include "TError.h" // R__ASSERT
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -44,7 +45,9 @@ class RNodeBase {
 protected:
    RLoopManager *fLoopManager;
    unsigned int fNChildren{0};      ///< Number of nodes of the functional graph hanging from this object
-   unsigned int fNStopsReceived{0}; ///< Number of times that a children node signaled to stop processing entries.
+   /// Number of times that a children node signaled to stop processing entries.
+   /// Atomic because in multi-thread event loops Ranges can signal from any processing slot.
+   std::atomic<unsigned int> fNStopsReceived{0};
    std::vector<std::string> fVariations; ///< List of systematic variations that affect this node.
 
 public:
@@ -0,0 +1,125 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RNODEPROFILE
+#define ROOT_RDF_RNODEPROFILE
+
+#include "ROOT/RDF/Utils.hxx" // CacheLineStep
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+class TBranch;
+class TTree;
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Per-slot number of calls and wall-clock time spent in a node of the computation graph.
+/// The counters are only filled when profiling is enabled on the RLoopManager, see
+/// ROOT::RDF::Experimental::EnableProfiling.
+class RNodeProfile {
+   // Entries are spaced by CacheLineStep to avoid false sharing between slots
+   std::vector<ULong64_t> fNCalls;
+   std::vector<ULong64_t> fNanoseconds;
+
+public:
+   explicit RNodeProfile(unsigned int nSlots)
+      : fNCalls(nSlots * CacheLineStep<ULong64_t>()), fNanoseconds(nSlots * CacheLineStep<ULong64_t>())
+   {
+   }
+
+   void Add(unsigned int slot, ULong64_t nanoseconds)
+   {
+      ++fNCalls[slot * CacheLineStep<ULong64_t>()];
+      fNanoseconds[slot * CacheLineStep<ULong64_t>()] += nanoseconds;
+   }
+
+   void Reset();
+
+   unsigned int GetNSlots() const { return fNCalls.size() / CacheLineStep<ULong64_t>(); }
+   ULong64_t GetNCalls(unsigned int slot) const { return fNCalls[slot * CacheLineStep<ULong64_t>()]; }
+   ULong64_t GetNanoseconds(unsigned int slot) const { return fNanoseconds[slot * CacheLineStep<ULong64_t>()]; }
+   /// Total number of calls, summed over all slots.
+   ULong64_t GetNCalls() const;
+   /// Total time in nanoseconds, summed over all slots.
+   ULong64_t GetNanoseconds() const;
+};
+
+/// Scope guard that adds the time elapsed between its construction and destruction to a RNodeProfile.
+/// It does nothing (and does not read the clock) if constructed with `enabled == false`.
+class RNodeProfileScope {
+   using Clock_t = std::chrono::steady_clock;
+
+   RNodeProfile &fProfile;
+   const unsigned int fSlot;
+   const bool fEnabled;
+   Clock_t::time_point fStart;
+
+public:
+   RNodeProfileScope(RNodeProfile &profile, unsigned int slot, bool enabled)
+      : fProfile(profile), fSlot(slot), fEnabled(enabled)
+   {
+      if (fEnabled)
+         fStart = Clock_t::now();
+   }
+   RNodeProfileScope(const RNodeProfileScope &) = delete;
+   RNodeProfileScope &operator=(const RNodeProfileScope &) = delete;
+
+   ~RNodeProfileScope()
+   {
+      if (fEnabled)
+         fProfile.Add(fSlot, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_t::now() - fStart).count());
+   }
+};
+
+/// Per-column bytes read from storage and bytes decompressed, for one processing slot.
+///
+/// Bytes are accounted one basket at a time: after every entry, Update() checks whether the branches backing each
+/// column moved to a new basket and, if so, adds the size of the basket on disk and its uncompressed size.
+/// Only columns read from a TTree/TChain are tracked.
+class RColumnIOProfile {
+   struct RBranchState {
+      TBranch *fBranch;
+      Int_t fLastBasket;
+   };
+
+   struct RColumnState {
+      std::string fName;
+      std::vector<RBranchState> fBranches; ///< The branch backing the column and all its sub-branches
+      ULong64_t fBytesRead = 0ull;
+      ULong64_t fBytesUnzipped = 0ull;
+   };
+
+   std::vector<RColumnState> fColumns;
+   TTree *fTree = nullptr; ///< The TTree the branch pointers refer to
+
+   void ConnectBranches(RColumnState &column);
+
+public:
+   void AddColumn(const std::string &name);
+   /// Connect the tracked columns to the branches of a new TTree (or disconnect them if `tree` is null).
+   /// Must be called every time the TTreeReader switches to a new tree, as the old TBranch objects might be gone.
+   void SetTree(TTree *tree);
+   void Update();
+   void Reset();
+
+   std::size_t GetNColumns() const { return fColumns.size(); }
+   const std::string &GetColumnName(std::size_t i) const { return fColumns[i].fName; }
+   ULong64_t GetBytesRead(std::size_t i) const { return fColumns[i].fBytesRead; }
+   ULong64_t GetBytesUnzipped(std::size_t i) const { return fColumns[i].fBytesUnzipped; }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RNODEPROFILE
@@ -0,0 +1,119 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROFILEREPORT
+#define ROOT_RDF_RPROFILEREPORT
+
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+namespace Detail {
+namespace RDF {
+class RLoopManager;
+} // namespace RDF
+} // namespace Detail
+
+namespace RDF {
+namespace Experimental {
+
+/// Number of calls and wall-clock time spent in one node of the computation graph during the last event loop.
+class RNodeProfileInfo {
+   friend class ROOT::Detail::RDF::RLoopManager;
+
+   std::string fName;
+   std::string fKind; ///< "Define", "Filter" or "Action"
+   std::vector<ULong64_t> fNCalls;      ///< Per-slot number of evaluations
+   std::vector<ULong64_t> fNanoseconds; ///< Per-slot time spent evaluating the node
+
+   RNodeProfileInfo(const std::string &name, const std::string &kind, std::vector<ULong64_t> &&nCalls,
+                    std::vector<ULong64_t> &&ns)
+      : fName(name), fKind(kind), fNCalls(std::move(nCalls)), fNanoseconds(std::move(ns))
+   {
+   }
+
+public:
+   const std::string &GetName() const { return fName; }
+   const std::string &GetKind() const { return fKind; }
+   unsigned int GetNSlots() const { return fNCalls.size(); }
+   ULong64_t GetNCalls(unsigned int slot) const { return fNCalls[slot]; }
+   ULong64_t GetNCalls() const { return std::accumulate(fNCalls.begin(), fNCalls.end(), 0ull); }
+   /// Time spent in this node by the given slot, in seconds.
+   double GetRealTime(unsigned int slot) const { return fNanoseconds[slot] * 1e-9; }
+   /// Time spent in this node summed over all slots, in seconds.
+   double GetRealTime() const { return std::accumulate(fNanoseconds.begin(), fNanoseconds.end(), 0ull) * 1e-9; }
+};
+
+/// Bytes read from storage and bytes decompressed to serve one input column during the last event loop.
+class RColumnIOInfo {
+   friend class ROOT::Detail::RDF::RLoopManager;
+
+   std::string fName;
+   std::vector<ULong64_t> fBytesRead;     ///< Per-slot compressed bytes
+   std::vector<ULong64_t> fBytesUnzipped; ///< Per-slot uncompressed bytes
+
+   RColumnIOInfo(const std::string &name, unsigned int nSlots)
+      : fName(name), fBytesRead(nSlots, 0ull), fBytesUnzipped(nSlots, 0ull)
+   {
+   }
+
+public:
+   const std::string &GetName() const { return fName; }
+   unsigned int GetNSlots() const { return fBytesRead.size(); }
+   ULong64_t GetBytesRead(unsigned int slot) const { return fBytesRead[slot]; }
+   ULong64_t GetBytesRead() const { return std::accumulate(fBytesRead.begin(), fBytesRead.end(), 0ull); }
+   ULong64_t GetBytesUnzipped(unsigned int slot) const { return fBytesUnzipped[slot]; }
+   ULong64_t GetBytesUnzipped() const { return std::accumulate(fBytesUnzipped.begin(), fBytesUnzipped.end(), 0ull); }
+};
+
+// clang-format off
+/**
+\class ROOT::RDF::Experimental::RProfileReport
+\ingroup dataframe
+\brief Per-node timing and per-column I/O statistics of the last event loop of a computation graph.
+
+Returned by ROOT::RDF::Experimental::GetProfileReport() for computation graphs on which profiling has been enabled
+with ROOT::RDF::Experimental::EnableProfiling().
+
+Node timings are inclusive of the evaluation of the Defines that the node reads for the first time in a given entry,
+since Defines are evaluated lazily. They do not include the time spent in upstream Filters.
+*/
+// clang-format on
+class RProfileReport {
+   friend class ROOT::Detail::RDF::RLoopManager;
+
+   std::vector<RNodeProfileInfo> fNodes;
+   std::vector<RColumnIOInfo> fColumns;
+   double fLoopRealTime = 0.;
+
+public:
+   using const_iterator = std::vector<RNodeProfileInfo>::const_iterator;
+
+   void Print() const;
+   const_iterator begin() const { return fNodes.begin(); }
+   const_iterator end() const { return fNodes.end(); }
+   const std::vector<RNodeProfileInfo> &GetNodes() const { return fNodes; }
+   const std::vector<RColumnIOInfo> &GetColumns() const { return fColumns; }
+   /// Return the information of the first node with the given name (Define'd column name, filter or action name).
+   const RNodeProfileInfo &operator[](std::string_view nodeName) const;
+   /// Return the I/O statistics of the given input column.
+   const RColumnIOInfo &GetColumn(std::string_view columnName) const;
+   /// Wall-clock duration of the whole event loop, in seconds.
+   double GetLoopRealTime() const { return fLoopRealTime; }
+};
+
+} // namespace Experimental
+} // namespace RDF
+} // namespace ROOT
+
+#endif // ROOT_RDF_RPROFILEREPORT
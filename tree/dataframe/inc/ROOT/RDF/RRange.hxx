@@ -48,7 +48,8 @@ class RRange final : public RRangeBase {
 public:
    RRange(unsigned int start, unsigned int stop, unsigned int stride, std::shared_ptr<PrevNode_t> pd)
       : RRangeBase(pd->GetLoopManagerUnchecked(), start, stop, stride, pd->GetLoopManagerUnchecked()->GetNSlots(),
-                   pd->GetVariations()),
+                   pd->GetVariations(),
+                   static_cast<RNodeBase *>(pd.get()) == static_cast<RNodeBase *>(pd->GetLoopManagerUnchecked())),
         fPrevNodePtr(std::move(pd)), fPrevNode(*fPrevNodePtr)
    {
       fLoopManager->Register(this);
@@ -60,31 +61,34 @@ public:
    // otherwise if fPrevNode is fLoopManager we get a use after delete
    ~RRange() { fLoopManager->Deregister(this); }
 
-   /// Ranges act as filters when it comes to selecting entries that downstream nodes should process
+   /// Ranges act as filters when it comes to selecting entries that downstream nodes should process.
+   /// In multi-thread event loops the entries that pass the upstream filters are counted across all processing slots,
+   /// so the range selects the right number of entries but which ones depends on the order in which they are processed.
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
-      if (entry != fLastCheckedEntry) {
+      auto &lastCheckedEntry = fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()];
+      auto &lastResult = fLastResult[slot * RDFInternal::CacheLineStep<int>()];
+      if (entry != lastCheckedEntry) {
          if (fHasStopped)
             return false;
          if (!fPrevNode.CheckFilters(slot, entry)) {
             // a filter upstream returned false, cache the result
-            fLastResult = false;
+            lastResult = false;
          } else {
             // apply range filter logic, cache the result
-            if (fNProcessedEntries < fStart || (fStop > 0 && fNProcessedEntries >= fStop) ||
-                (fStride != 1 && (fNProcessedEntries - fStart) % fStride != 0))
-               fLastResult = false;
+            const ULong64_t nProcessed = fNProcessedEntries.fetch_add(1, std::memory_order_relaxed);
+            if (nProcessed < fStart || (fStop > 0 && nProcessed >= fStop) ||
+                (fStride != 1 && (nProcessed - fStart) % fStride != 0))
+               lastResult = false;
             else
-               fLastResult = true;
-            ++fNProcessedEntries;
-            if (fNProcessedEntries == fStop) {
-               fHasStopped = true;
+               lastResult = true;
+            // only the slot that processed the last entry of the range signals upstream
+            if (nProcessed + 1 == fStop && !fHasStopped.exchange(true))
                fPrevNode.StopProcessing();
-            }
          }
-         fLastCheckedEntry = entry;
+         lastCheckedEntry = entry;
       }
-      return fLastResult;
+      return lastResult;
    }
 
    // recursive chain of `Report`s
@@ -95,8 +99,7 @@ public:
 
    void StopProcessing() final
    {
-      ++fNStopsReceived;
-      if (fNStopsReceived == fNChildren && !fHasStopped)
+      if (++fNStopsReceived == fNChildren && !fHasStopped.exchange(true))
          fPrevNode.StopProcessing();
    }
 
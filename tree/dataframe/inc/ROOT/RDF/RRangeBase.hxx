@@ -14,7 +14,9 @@
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "RtypesCore.h"
 
+#include <atomic>
 #include <unordered_map>
+#include <vector>
 
 namespace ROOT {
 namespace Internal {
@@ -35,21 +37,31 @@ protected:
    unsigned int fStart;
    unsigned int fStop;
    unsigned int fStride;
-   Long64_t fLastCheckedEntry{-1};
-   bool fLastResult{true};
-   ULong64_t fNProcessedEntries{0};
-   bool fHasStopped{false};    ///< True if the end of the range has been reached
+   std::vector<Long64_t> fLastCheckedEntry;
+   std::vector<int> fLastResult; // std::vector<bool> cannot be used in a MT context safely
+   /// Number of entries that passed the upstream filters so far, counted across all processing slots.
+   std::atomic<ULong64_t> fNProcessedEntries{0};
+   std::atomic<bool> fHasStopped{false}; ///< True if the end of the range has been reached
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
+   const bool fIsOnLoopManager; ///< True if this Range is booked directly on the RLoopManager
    std::unordered_map<std::string, std::shared_ptr<RRangeBase>> fVariedRanges;
 
 public:
    RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int stop, unsigned int stride,
-              const unsigned int nSlots, const std::vector<std::string> &prevVariations);
+              const unsigned int nSlots, const std::vector<std::string> &prevVariations, bool isOnLoopManager);
 
    RRangeBase &operator=(const RRangeBase &) = delete;
    ~RRangeBase() override;
 
-   void InitNode();
+   /// Reset the state of the range at the beginning of an event loop.
+   /// \param[in] nSkippedEntries Number of entries that the event loop will not process at all and that this range has
+   ///            to count as already seen, see RLoopManager::EvalEntryWindow().
+   void InitNode(ULong64_t nSkippedEntries = 0);
+
+   unsigned int GetStart() const { return fStart; }
+   unsigned int GetStop() const { return fStop; }
+   bool IsOnLoopManager() const { return fIsOnLoopManager; }
+   bool HasChildren() const { return fNChildren > 0; }
 };
 
 } // ns RDF
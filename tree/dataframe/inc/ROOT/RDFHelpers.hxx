@@ -15,6 +15,7 @@
 
 #include <ROOT/RDF/GraphUtils.hxx>
 #include <ROOT/RDF/RActionBase.hxx>
+#include <ROOT/RDF/RProfileReport.hxx>
 #include <ROOT/RDF/RResultMap.hxx>
 #include <ROOT/RResultHandle.hxx> // users of RunGraphs might rely on this transitive include
 #include <ROOT/TypeTraits.hxx>
@@ -252,6 +253,78 @@ RResultMap<T> VariationsFor(RResultPtr<T> resPtr)
 using SnapshotPtr_t = ROOT::RDF::RResultPtr<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager, void>>;
 SnapshotPtr_t VariationsFor(SnapshotPtr_t resPtr);
 
+// clang-format off
+/// \brief Write the values of a column directly into a contiguous buffer provided by the caller.
+/// \tparam T The type of the column, which must be a fundamental type.
+/// \param[in] node Any node of a computation graph.
+/// \param[in] column The name of the column to read.
+/// \param[in] buffer The beginning of the output buffer.
+/// \param[in] size The number of elements of type T that fit in the buffer.
+/// \return the number of values written at the beginning of the buffer, wrapped in a RResultPtr.
+///
+/// Differently from Take(), which collects the values in one std::vector per processing slot and concatenates them
+/// at the end of the event loop, TakeInto writes every value in place: the processing slots reserve disjoint blocks of
+/// the buffer and the blocks are compacted at the end of the event loop. No memory is allocated for the values besides
+/// the buffer itself, which makes it possible to export large columns to e.g. NumPy arrays owned by Python.
+///
+/// The buffer must be large enough for all values (e.g. its size can be obtained with a Count() of the same node)
+/// and must stay valid until the event loop has run. In multi-thread event loops the order of the values is not
+/// guaranteed, as for Take().
+///
+/// ~~~{.cpp}
+/// auto filtered = df.Filter("pt > 10");
+/// std::vector<float> pts(*filtered.Count());
+/// auto n = ROOT::RDF::Experimental::TakeInto<float>(filtered, "pt", pts.data(), pts.size());
+/// ~~~
+///
+/// This action is *lazy*: upon invocation of this method the calculation is booked but not executed.
+// clang-format on
+template <typename T>
+RResultPtr<ULong64_t> TakeInto(RNode node, std::string_view column, T *buffer, ULong64_t size)
+{
+   return node.Book<T>(ROOT::Internal::RDF::TakeIntoHelper<T>(buffer, size, node.GetNSlots()), {std::string(column)});
+}
+
+// clang-format off
+/// \brief Record per-node timings and per-column I/O statistics during the event loops of a computation graph.
+/// \param[in] node Any node of the computation graph. Profiling is enabled for the whole graph.
+/// \param[in] enable Pass `false` to switch profiling off again.
+///
+/// When profiling is enabled, every Define, Filter and action records how many times it was evaluated and the
+/// wall-clock time spent doing so, per processing slot, and every column read from a TTree/TChain records how many
+/// bytes were read from storage and decompressed to serve it. The results of the last event loop can be retrieved
+/// with GetProfileReport(), and are also shown in the labels of the nodes drawn by SaveGraph().
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("events", "file.root");
+/// ROOT::RDF::Experimental::EnableProfiling(df);
+/// auto h = df.Define("pt2", "pt*pt").Filter("pt2 > 100").Histo1D("pt2");
+/// h->Draw(); // runs the event loop
+/// ROOT::RDF::Experimental::GetProfileReport(df).Print();
+/// ROOT::RDF::SaveGraph(df, "graph.dot");
+/// ~~~
+///
+/// Profiling adds a couple of clock reads per node evaluation, so it is meant for finding hot spots rather than
+/// for production runs. Node timings include the evaluation of the Defines that the node reads.
+// clang-format on
+void EnableProfiling(RNode node, bool enable = true);
+
+/// \brief Return the timings and I/O statistics recorded during the last event loop of a computation graph.
+/// \param[in] node Any node of the computation graph.
+///
+/// See EnableProfiling() for more information.
+RProfileReport GetProfileReport(RNode node);
+
+/// \brief Set the memory threshold above which large histograms are filled concurrently instead of being replicated.
+/// \param[in] nBytes Maximum extra memory, in bytes, that the per-slot copies of a single histogram may take.
+///
+/// In multi-thread event loops, Histo3D and HistoND normally fill one copy of the histogram per processing slot and
+/// merge the copies at the end of the event loop. If the copies would take more than `nBytes` of extra memory
+/// (1 GiB by default), all slots fill the same histogram instead, with the fills buffered per slot and applied under
+/// a lock. This keeps very large histograms within memory at high thread counts, at the cost of some contention.
+/// The threshold is read when the action is booked.
+void SetSharedFillThreshold(ULong64_t nBytes);
+
 } // namespace Experimental
 } // namespace RDF
 } // namespace ROOT
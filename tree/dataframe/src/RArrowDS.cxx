@@ -20,9 +20,17 @@ A RDataFrame that adapts an arrow::Table class can be constructed using the fact
 ROOT::RDF::FromArrow, which accepts one parameter:
 1. An arrow::Table smart pointer.
 
+Alternatively, ROOT::RDF::FromArrowIPC reads an Arrow IPC file (also known as Feather V2)
+directly. The file is memory-mapped and its record batches are used in place, so that
+column data is paged in from disk on demand rather than copied into memory upfront.
+
 The types of the columns are derived from the types in the associated
 arrow::Schema.
 
+When the table is made of several chunks (e.g. the record batches of an IPC file) and there
+are at least as many chunks as processing slots, each chunk becomes one entry range, so that
+slots never read across chunk boundaries. Otherwise the entries are split in equal ranges.
+
 */
 // clang-format on
 
@@ -41,6 +49,9 @@ arrow::Schema.
 #pragma GCC diagnostic ignored "-Wshadow"
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #endif
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/record_batch.h>
 #include <arrow/table.h>
 #include <arrow/stl.h>
 #if defined(__GNUC__)
@@ -380,6 +391,37 @@ public:
    using ::arrow::TypeVisitor::Visit;
 };
 
+namespace {
+/// Memory-map an Arrow IPC file and expose its record batches, without copying them, as the chunks of a table.
+std::shared_ptr<arrow::Table> OpenIPCFile(std::string_view fileName)
+{
+   const std::string fname(fileName);
+   auto throwIfError = [&fname](const arrow::Status &status) {
+      if (!status.ok())
+         throw std::runtime_error("RArrowDS: cannot read Arrow IPC file " + fname + ": " + status.ToString());
+   };
+
+   auto file = arrow::io::MemoryMappedFile::Open(fname, arrow::io::FileMode::READ);
+   throwIfError(file.status());
+   auto reader = arrow::ipc::RecordBatchFileReader::Open(*file);
+   throwIfError(reader.status());
+
+   const auto nBatches = (*reader)->num_record_batches();
+   std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+   batches.reserve(nBatches);
+   for (int i = 0; i < nBatches; ++i) {
+      // the buffers of the batch point into the memory map and keep it alive
+      auto batch = (*reader)->ReadRecordBatch(i);
+      throwIfError(batch.status());
+      batches.emplace_back(std::move(*batch));
+   }
+
+   auto table = arrow::Table::FromRecordBatches((*reader)->schema(), batches);
+   throwIfError(table.status());
+   return *table;
+}
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////
 /// Constructor to create an Arrow RDataSource for RDataFrame.
 /// \param[in] inTable the arrow Table to observe.
@@ -455,6 +497,16 @@ RArrowDS::RArrowDS(std::shared_ptr<arrow::Table> inTable, std::vector<std::strin
    }
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Constructor to create an Arrow RDataSource for RDataFrame from an Arrow IPC (Feather V2) file.
+/// \param[in] fileName the path of the file, which is memory-mapped.
+/// \param[in] inColumns the name of the columns to use
+/// In case columns is empty, we use all the columns found in the file
+RArrowDS::RArrowDS(std::string_view fileName, std::vector<std::string> const &inColumns)
+   : RArrowDS(OpenIPCFile(fileName), inColumns)
+{
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Destructor.
 RArrowDS::~RArrowDS()
@@ -586,10 +638,37 @@ std::vector<void *> RArrowDS::GetColumnReadersImpl(std::string_view colName, con
    return fValueGetters[getterIdx]->SlotPtrs();
 }
 
+/// Use the chunk boundaries of the given column as entry ranges.
+/// Returns false, leaving ranges untouched, if there are fewer chunks than slots.
+bool splitAtChunkBoundaries(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges,
+                            const std::shared_ptr<arrow::ChunkedArray> &column, unsigned int nSlots)
+{
+   const auto nChunks = column->num_chunks();
+   if (nChunks < 2 || static_cast<unsigned int>(nChunks) < nSlots)
+      return false;
+   ranges.clear();
+   ULong64_t start = 0;
+   for (const auto &chunk : column->chunks()) {
+      const ULong64_t end = start + chunk->length();
+      if (end > start)
+         ranges.emplace_back(start, end);
+      start = end;
+   }
+   return true;
+}
+
 void RArrowDS::Initialize()
 {
-   auto nRecords = getNRecords(fTable, fColumnNames);
-   splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
+   if (fColumnNames.empty()) {
+      // No column to take the chunks from: split the rows of the table.
+      splitInEqualRanges(fEntryRanges, fTable->num_rows(), fNSlots);
+      return;
+   }
+   const auto firstColumn = getData(fTable->column(fTable->schema()->GetFieldIndex(fColumnNames.front())));
+   if (!splitAtChunkBoundaries(fEntryRanges, firstColumn, fNSlots)) {
+      auto nRecords = getNRecords(fTable, fColumnNames);
+      splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
+   }
 }
 
 std::string RArrowDS::GetLabel()
@@ -609,6 +688,20 @@ RDataFrame FromArrow(std::shared_ptr<arrow::Table> table, std::vector<std::strin
    return tdf;
 }
 
+/// \brief Factory method to create a RDataFrame reading an Apache Arrow IPC file.
+///
+/// Creates a RDataFrame that reads an Arrow IPC file (also known as Feather V2 file), e.g. as written by
+/// `pyarrow.feather.write_feather` or `pyarrow.ipc.new_file`. The file is memory-mapped, and
+/// column values are read in place from the mapped record batches.
+/// \param[in] fileName the path of the Arrow IPC file
+/// \param[in] columnNames the name of the columns to use
+/// In case columnNames is empty, we use all the columns found in the file
+RDataFrame FromArrowIPC(std::string_view fileName, std::vector<std::string> const &columnNames)
+{
+   ROOT::RDataFrame tdf(std::make_unique<RArrowDS>(fileName, columnNames));
+   return tdf;
+}
+
 } // namespace RDF
 
 } // namespace ROOT
@@ -68,9 +68,11 @@ double-quote characters must be represented by a pair of double-quote characters
     2000,Mercury,Cougar
 ~~~
 
-The current implementation of RCsvDS reads the entire CSV file content into memory before
+With the default chunk size, RCsvDS reads the entire CSV file content into memory before
 RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
-important to check both how much memory is available and the size of the CSV file.
+important to check both how much memory is available and the size of the CSV file, or to
+pass a chunk size so that the file is read and processed a bunch of lines at a time.
+When implicit multi-threading is enabled, the lines of each chunk are parsed in parallel.
 
 RCsvDS can handle empty cells and also allows the usage of the special keywords "NaN" and "nan" to
 indicate `nan` values. If the column is of type double, these cells are stored internally as `nan`.
@@ -82,12 +84,49 @@ Empty cells and explicit `nan`-s inside columns of type Long64_t/bool are stored
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/RRawFile.hxx>
 #include <TError.h>
+#include <TROOT.h>       // IsImplicitMTEnabled
+#include "RConfigure.h" // R__USE_IMT
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #include <algorithm>
+#include <cerrno>
+#include <cmath> // HUGE_VAL
+#include <cstdlib> // strtod, strtoll
 #include <memory>
-#include <sstream>
 #include <string>
 
+namespace {
+// Lines are read and parsed in batches of this size, so that at most this many raw lines are held in memory at a time
+constexpr std::size_t kParseBatchSize = 65536;
+
+// Equivalent to std::stod/std::stoll, minus the temporary strings and the exception-based control flow.
+double ParseDouble(const std::string &s)
+{
+   char *end = nullptr;
+   errno = 0;
+   const double d = std::strtod(s.c_str(), &end);
+   if (end == s.c_str())
+      throw std::invalid_argument("RCsvDS: cannot convert \"" + s + "\" to double");
+   if (errno == ERANGE && (d == HUGE_VAL || d == -HUGE_VAL))
+      throw std::out_of_range("RCsvDS: value \"" + s + "\" is out of range for type double");
+   return d;
+}
+
+Long64_t ParseLong64(const std::string &s)
+{
+   char *end = nullptr;
+   errno = 0;
+   const Long64_t l = std::strtoll(s.c_str(), &end, 10);
+   if (end == s.c_str())
+      throw std::invalid_argument("RCsvDS: cannot convert \"" + s + "\" to Long64_t");
+   if (errno == ERANGE)
+      throw std::out_of_range("RCsvDS: value \"" + s + "\" is out of range for type Long64_t");
+   return l;
+}
+} // anonymous namespace
+
 namespace ROOT {
 
 namespace RDF {
@@ -117,25 +156,28 @@ void RCsvDS::FillHeaders(const std::string &line)
    }
 }
 
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
+/// Parse one line into a record. Columns with empty cells that cannot be represented as NaN are added to
+/// colContainingEmpty. This method does not modify the data source, so that lines can be parsed concurrently.
+void RCsvDS::FillRecord(const std::string &line, Record_t &record, std::set<std::string> &colContainingEmpty) const
 {
    auto i = 0U;
 
    auto columns = ParseColumns(line);
+   record.reserve(columns.size());
 
    for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
+      auto colType = fColTypesList[i];
 
       switch (colType) {
       case 'D': {
-         record.emplace_back(new double((col != "nan") ? std::stod(col) : std::numeric_limits<double>::quiet_NaN()));
+         record.emplace_back(new double((col != "nan") ? ParseDouble(col) : std::numeric_limits<double>::quiet_NaN()));
          break;
       }
       case 'L': {
          if (col != "nan") {
-            record.emplace_back(new Long64_t(std::stoll(col)));
+            record.emplace_back(new Long64_t(ParseLong64(col)));
          } else {
-            fColContainingEmpty.insert(fHeaders[i]);
+            colContainingEmpty.insert(fHeaders[i]);
             record.emplace_back(new Long64_t(0));
          }
          break;
@@ -144,9 +186,10 @@ void RCsvDS::FillRecord(const std::string &line, Record_t &record)
          auto b = new bool();
          record.emplace_back(b);
          if (col != "nan") {
-            std::istringstream(col) >> std::boolalpha >> *b;
+            // same as reading with std::boolalpha: anything other than "true" reads as false
+            *b = col == "true";
          } else {
-            fColContainingEmpty.insert(fHeaders[i]);
+            colContainingEmpty.insert(fHeaders[i]);
             *b = false;
          }
          break;
@@ -160,6 +203,36 @@ void RCsvDS::FillRecord(const std::string &line, Record_t &record)
    }
 }
 
+/// Parse a batch of lines and append the resulting records to fRecords.
+/// If implicit multi-threading is enabled, the batch is split in contiguous blocks of lines that are parsed in parallel.
+void RCsvDS::FillRecords(std::vector<std::string> &lines)
+{
+   const auto nLines = lines.size();
+   const auto firstRecord = fRecords.size();
+   fRecords.resize(firstRecord + nLines);
+
+   const unsigned int nTasks = ROOT::IsImplicitMTEnabled() ? std::max(1u, std::min<unsigned int>(fNSlots, nLines)) : 1u;
+   std::vector<std::set<std::string>> colsContainingEmpty(nTasks);
+   auto parseBlock = [&](unsigned int task) {
+      const auto begin = nLines * task / nTasks;
+      const auto end = nLines * (task + 1) / nTasks;
+      for (auto i = begin; i < end; ++i)
+         FillRecord(lines[i], fRecords[firstRecord + i], colsContainingEmpty[task]);
+   };
+
+#ifdef R__USE_IMT
+   if (nTasks > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(parseBlock, ROOT::TSeqU(nTasks));
+   } else
+#endif
+      parseBlock(0u);
+
+   for (auto &cols : colsContainingEmpty)
+      fColContainingEmpty.insert(cols.begin(), cols.end());
+   lines.clear();
+}
+
 void RCsvDS::GenerateHeaders(size_t size)
 {
    fHeaders.reserve(size);
@@ -273,7 +346,7 @@ void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
    fColTypesList.push_back(type);
 }
 
-std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
+std::vector<std::string> RCsvDS::ParseColumns(const std::string &line) const
 {
    std::vector<std::string> columns;
 
@@ -284,11 +357,12 @@ std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
    return columns;
 }
 
-size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i)
+size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i) const
 {
    std::string val;
    bool quoted = false;
    const size_t prevPos = i; // used to check if cell is empty
+   const char stopChars[] = {fDelimiter, '"'};
 
    for (; i < line.size(); ++i) {
       if (line[i] == fDelimiter && !quoted) {
@@ -300,8 +374,15 @@ size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &col
          } else {
             val += line[++i];
          }
-      } else {
+      } else if (quoted) {
          val += line[i];
+      } else {
+         // copy the unquoted characters up to the next delimiter or quote in one go
+         auto next = line.find_first_of(stopChars, i, sizeof(stopChars));
+         if (next == std::string::npos)
+            next = line.size();
+         val.append(line, i, next - i);
+         i = next - 1;
       }
    }
 
@@ -429,13 +510,18 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
    auto linesToRead = fLinesChunkSize;
    FreeRecords();
 
+   // Reading lines is sequential, the much more expensive parsing is done in batches (in parallel if possible)
+   std::vector<std::string> lines;
+   lines.reserve(std::min<std::size_t>(kParseBatchSize, fLinesChunkSize == -1LL ? kParseBatchSize : fLinesChunkSize));
    std::string line;
    while ((-1LL == fLinesChunkSize || 0 != linesToRead) && fCsvFile->Readln(line)) {
       if (line.empty()) continue; // skip empty lines
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
+      lines.emplace_back(std::move(line));
       --linesToRead;
+      if (lines.size() == kParseBatchSize)
+         FillRecords(lines);
    }
+   FillRecords(lines);
 
    if (!fColContainingEmpty.empty()) {
       std::string msg = "";
@@ -28,6 +28,8 @@ GraphDrawing::CreateDefineNode(const std::string &columnName, const ROOT::Detail
       return duplicateDefineIt->second;
 
    auto node = std::make_shared<GraphNode>("Define\\n" + columnName, visitedMap.size(), ENodeType::kDefine);
+   if (columnPtr)
+      node->AddProfile(columnPtr->GetProfile().GetNCalls(), columnPtr->GetProfile().GetNanoseconds());
    visitedMap[(void *)columnPtr] = node;
    return node;
 }
@@ -45,6 +47,7 @@ GraphDrawing::CreateFilterNode(const ROOT::Detail::RDF::RFilterBase *filterPtr,
 
    auto node = std::make_shared<GraphNode>((filterPtr->HasName() ? filterPtr->GetName() : "Filter"), visitedMap.size(),
                                            ENodeType::kFilter);
+   node->AddProfile(filterPtr->GetProfile().GetNCalls(), filterPtr->GetProfile().GetNanoseconds());
    visitedMap[(void *)filterPtr] = node;
    return node;
 }
@@ -14,6 +14,7 @@
 #include "TStopwatch.h"
 #include "RConfigure.h" // R__USE_IMT
 #include "ROOT/RLogger.hxx"
+#include "ROOT/RDF/InterfaceUtils.hxx" // for SetSharedFillThreshold
 #include "ROOT/RDF/RLoopManager.hxx" // for RLoopManager
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RResultHandle.hxx"    // for RResultHandle, RunGraphs
@@ -99,3 +100,18 @@ ROOT::RDF::Experimental::SnapshotPtr_t ROOT::RDF::Experimental::VariationsFor(RO
 {
    throw std::logic_error("Varying a Snapshot result is not implemented yet.");
 }
+
+void ROOT::RDF::Experimental::EnableProfiling(ROOT::RDF::RNode node, bool enable)
+{
+   ROOT::Internal::RDF::SetProfilingEnabled(node, enable);
+}
+
+ROOT::RDF::Experimental::RProfileReport ROOT::RDF::Experimental::GetProfileReport(ROOT::RDF::RNode node)
+{
+   return ROOT::Internal::RDF::GetProfileReport(node);
+}
+
+void ROOT::RDF::Experimental::SetSharedFillThreshold(ULong64_t nBytes)
+{
+   ROOT::Internal::RDF::SetSharedFillThreshold(nBytes);
+}
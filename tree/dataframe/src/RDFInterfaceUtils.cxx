@@ -46,6 +46,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>  // for size_t
 #include <iterator> // for back_insert_iterator
@@ -1015,6 +1016,21 @@ void RemoveDuplicates(ColumnNames_t &columnNames)
       columnNames.end());
 }
 
+namespace {
+// by default, histograms are filled in a shared instance if one copy per slot would cost more than 1 GiB extra
+std::atomic<ULong64_t> gSharedFillThreshold{1ull << 30};
+} // anonymous namespace
+
+ULong64_t GetSharedFillThreshold()
+{
+   return gSharedFillThreshold;
+}
+
+void SetSharedFillThreshold(ULong64_t nBytes)
+{
+   gSharedFillThreshold = nBytes;
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
@@ -436,7 +436,7 @@ auto d15on = d.Range(15, 0);
 // We can specify a stride too, in this case we pick an event every 3
 auto d15each3 = d.Range(0, 15, 3);
 ~~~
-Note that ranges are not available when multi-threading is enabled. More information on ranges is available
+More information on ranges, including their behavior when multi-threading is enabled, is available
 [here](#ranges).
 
 ### Executing multiple actions in the same event loop
@@ -525,9 +525,8 @@ that has been run using the relevant RDataFrame.
 
 \anchor ranges
 ### Ranges
-When RDataFrame is not being used in a multi-thread environment (i.e. no call to EnableImplicitMT() was made),
-Range() transformations are available. These act very much like filters but instead of basing their decision on
-a filter expression, they rely on `begin`,`end` and `stride` parameters.
+Range() transformations act very much like filters but instead of basing their decision on a filter expression, they
+rely on `begin`,`end` and `stride` parameters.
 
 - `begin`: initial entry number considered for this range.
 - `end`: final entry number (excluded) considered for this range. 0 means that the range goes until the end of the dataset.
@@ -544,6 +543,13 @@ preceding filter*.
 Ranges allow "early quitting": if all branches of execution of a functional graph reached their `end` value of
 processed entries, the event-loop is immediately interrupted. This is useful for debugging and quick data explorations.
 
+Ranges also work when multi-threading is enabled. If the only nodes booked directly on the RDataFrame are Ranges,
+the event loop only splits the entries between the smallest `begin` and the largest `end` among them into tasks, so
+e.g. `df.Range(1000000)` processes exactly the first million entries of the dataset using all threads. Otherwise, and
+for ranges that hang from other nodes, the entries that reach the range are counted across all threads: the range
+lets the right number of entries pass, but which ones depends on the order in which threads process them, in the
+same way as the order of the entries seen by actions is not deterministic in multi-thread event loops.
+
 \anchor custom-columns
 ### Custom columns
 Custom columns are created by invoking `Define(name, f, columnList)`. As usual, `f` can be any callable object
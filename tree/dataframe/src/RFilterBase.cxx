@@ -24,7 +24,7 @@ RFilterBase::RFilterBase(RLoopManager *implPtr, std::string_view name, const uns
      fLastResult(nSlots * RDFInternal::CacheLineStep<int>()),
      fAccepted(nSlots * RDFInternal::CacheLineStep<ULong64_t>()),
      fRejected(nSlots * RDFInternal::CacheLineStep<ULong64_t>()), fName(name), fColumnNames(columns),
-     fColRegister(colRegister), fIsDefine(columns.size()), fVariation(variation)
+     fColRegister(colRegister), fIsDefine(columns.size()), fVariation(variation), fProfile(nSlots)
 {
    const auto nColumns = fColumnNames.size();
    for (auto i = 0u; i < nColumns; ++i) {
@@ -60,4 +60,5 @@ void RFilterBase::InitNode()
 {
    if (!fName.empty()) // if this is a named filter we care about its report count
       ResetReportCount();
+   fProfile.Reset();
 }
@@ -9,6 +9,7 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RInterface.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
 
 void ROOT::Internal::RDF::ChangeEmptyEntryRange(const ROOT::RDF::RNode &node,
                                                 std::pair<ULong64_t, ULong64_t> &&newRange)
@@ -39,3 +40,22 @@ void ROOT::Internal::RDF::TriggerRun(ROOT::RDF::RNode node)
 {
    node.fLoopManager->Run();
 }
+
+/**
+ * \brief Enable or disable the recording of per-node timings and per-column I/O statistics.
+ * \param[in] node Any node of the computation graph.
+ * \param[in] enable Whether the next event loops should be profiled.
+ */
+void ROOT::Internal::RDF::SetProfilingEnabled(const ROOT::RDF::RNode &node, bool enable)
+{
+   node.GetLoopManager()->SetProfilingEnabled(enable);
+}
+
+/**
+ * \brief Return the profiling information recorded during the last event loop of a computation graph.
+ * \param[in] node Any node of the computation graph.
+ */
+ROOT::RDF::Experimental::RProfileReport ROOT::Internal::RDF::GetProfileReport(const ROOT::RDF::RNode &node)
+{
+   return node.GetLoopManager()->GetProfileReport();
+}
@@ -125,6 +125,12 @@ void RJittedAction::SetHasRun()
    return fConcreteAction->SetHasRun();
 }
 
+std::string RJittedAction::GetActionName()
+{
+   assert(fConcreteAction != nullptr);
+   return fConcreteAction->GetActionName();
+}
+
 std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::GetGraph(
    std::unordered_map<void *, std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode>> &visitedMap)
 {
@@ -68,3 +68,9 @@ RDefineBase &RJittedDefine::GetVariedDefine(const std::string &variationName)
    assert(fConcreteDefine != nullptr);
    return fConcreteDefine->GetVariedDefine(variationName);
 }
+
+const ROOT::Internal::RDF::RNodeProfile &RJittedDefine::GetProfile() const
+{
+   // before jitting there is no concrete define, and nothing has been profiled yet
+   return fConcreteDefine ? fConcreteDefine->GetProfile() : fProfile;
+}
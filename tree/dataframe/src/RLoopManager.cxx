@@ -14,6 +14,7 @@
 #include "ROOT/RDF/RDefineBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 #include "ROOT/RDF/RVariationBase.hxx"
 #include "ROOT/RLogger.hxx"
@@ -346,7 +347,7 @@ RLoopManager::RLoopManager(TTree *tree, const ColumnNames_t &defaultBranches)
    : fTree(std::shared_ptr<TTree>(tree, [](TTree *) {})), fDefaultColumns(defaultBranches),
      fNSlots(RDFInternal::GetNSlots()),
      fLoopType(ROOT::IsImplicitMTEnabled() ? ELoopType::kROOTFilesMT : ELoopType::kROOTFiles),
-     fNewSampleNotifier(fNSlots), fSampleInfos(fNSlots), fDatasetColumnReaders(fNSlots)
+     fNewSampleNotifier(fNSlots), fSampleInfos(fNSlots), fDatasetColumnReaders(fNSlots), fColumnIOProfiles(fNSlots)
 {
 }
 
@@ -356,14 +357,16 @@ RLoopManager::RLoopManager(ULong64_t nEmptyEntries)
      fLoopType(ROOT::IsImplicitMTEnabled() ? ELoopType::kNoFilesMT : ELoopType::kNoFiles),
      fNewSampleNotifier(fNSlots),
      fSampleInfos(fNSlots),
-     fDatasetColumnReaders(fNSlots)
+     fDatasetColumnReaders(fNSlots),
+     fColumnIOProfiles(fNSlots)
 {
 }
 
 RLoopManager::RLoopManager(std::unique_ptr<RDataSource> ds, const ColumnNames_t &defaultBranches)
    : fDefaultColumns(defaultBranches), fNSlots(RDFInternal::GetNSlots()),
      fLoopType(ROOT::IsImplicitMTEnabled() ? ELoopType::kDataSourceMT : ELoopType::kDataSource),
-     fDataSource(std::move(ds)), fNewSampleNotifier(fNSlots), fSampleInfos(fNSlots), fDatasetColumnReaders(fNSlots)
+     fDataSource(std::move(ds)), fNewSampleNotifier(fNSlots), fSampleInfos(fNSlots), fDatasetColumnReaders(fNSlots),
+     fColumnIOProfiles(fNSlots)
 {
    fDataSource->SetNSlots(fNSlots);
 }
@@ -373,7 +376,8 @@ RLoopManager::RLoopManager(ROOT::RDF::Experimental::RDatasetSpec &&spec)
      fLoopType(ROOT::IsImplicitMTEnabled() ? ELoopType::kROOTFilesMT : ELoopType::kROOTFiles),
      fNewSampleNotifier(fNSlots),
      fSampleInfos(fNSlots),
-     fDatasetColumnReaders(fNSlots)
+     fDatasetColumnReaders(fNSlots),
+     fColumnIOProfiles(fNSlots)
 {
    ChangeSpec(std::move(spec));
 }
@@ -436,12 +440,15 @@ void RLoopManager::RunEmptySourceMT()
    ROOT::Internal::RSlotStack slotStack(fNSlots);
    // Working with an empty tree.
    // Evenly partition the entries according to fNSlots. Produce around 2 tasks per slot.
-   const auto nEmptyEntries = GetNEmptyEntries();
+   // Only the entries that the Ranges booked on this node can select are partitioned.
+   const auto firstEntry = fEmptyEntryRange.first + std::min(fEntryWindow.first, GetNEmptyEntries());
+   const auto lastEntry = fEmptyEntryRange.first + std::min(fEntryWindow.second, GetNEmptyEntries());
+   const auto nEmptyEntries = lastEntry - firstEntry;
    const auto nEntriesPerSlot = nEmptyEntries / (fNSlots * 2);
    auto remainder = nEmptyEntries % (fNSlots * 2);
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   ULong64_t begin = fEmptyEntryRange.first;
-   while (begin < fEmptyEntryRange.second) {
+   ULong64_t begin = firstEntry;
+   while (begin < lastEntry) {
       ULong64_t end = begin + nEntriesPerSlot;
       if (remainder > 0) {
          ++end;
@@ -453,6 +460,8 @@ void RLoopManager::RunEmptySourceMT()
 
    // Each task will generate a subrange of entries
    auto genFunction = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
+      if (fNStopsReceived >= fNChildren) // all Ranges are done, nothing left to do
+         return;
       ROOT::Internal::RSlotStackRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
       RCallCleanUpTask cleanup(*this, slot);
@@ -460,7 +469,7 @@ void RLoopManager::RunEmptySourceMT()
       R__LOG_DEBUG(0, RDFLogChannel()) << LogRangeProcessing({"an empty source", range.first, range.second, slot});
       try {
          UpdateSampleInfo(slot, range);
-         for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
+         for (auto currEntry = range.first; currEntry < range.second && fNStopsReceived < fNChildren; ++currEntry) {
             RunAndCheckFilters(slot, currEntry);
          }
       } catch (...) {
@@ -499,17 +508,31 @@ void RLoopManager::RunEmptySource()
 void RLoopManager::RunTreeProcessorMT()
 {
 #ifdef R__USE_IMT
-   if (fEndEntry == fBeginEntry) // empty range => no work needed
+   // restrict the global entry range to the entries that the Ranges booked on this node can select
+   // (there is no such window if the tree has an entry list, see EvalEntryWindow)
+   auto beginEntry = fBeginEntry;
+   auto endEntry = fEndEntry;
+   if (fEntryWindow.first > 0) {
+      beginEntry += fEntryWindow.first;
+      if (beginEntry >= std::min(fEndEntry, fTree->GetEntries()))
+         return; // the Ranges start after the end of the dataset
+   }
+   if (fEntryWindow.second != std::numeric_limits<ULong64_t>::max())
+      endEntry = std::min(fEndEntry, fBeginEntry + static_cast<Long64_t>(fEntryWindow.second));
+
+   if (endEntry == beginEntry) // empty range => no work needed
       return;
    ROOT::Internal::RSlotStack slotStack(fNSlots);
    const auto &entryList = fTree->GetEntryList() ? *fTree->GetEntryList() : TEntryList();
-   auto tp = (fBeginEntry != 0 || fEndEntry != std::numeric_limits<Long64_t>::max())
-                ? std::make_unique<ROOT::TTreeProcessorMT>(*fTree, fNSlots, std::make_pair(fBeginEntry, fEndEntry))
+   auto tp = (beginEntry != 0 || endEntry != std::numeric_limits<Long64_t>::max())
+                ? std::make_unique<ROOT::TTreeProcessorMT>(*fTree, fNSlots, std::make_pair(beginEntry, endEntry))
                 : std::make_unique<ROOT::TTreeProcessorMT>(*fTree, entryList, fNSlots);
 
    std::atomic<ULong64_t> entryCount(0ull);
 
    tp->Process([this, &slotStack, &entryCount](TTreeReader &r) -> void {
+      if (fNStopsReceived >= fNChildren) // all Ranges are done, nothing left to do
+         return;
       ROOT::Internal::RSlotStackRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
       RCallCleanUpTask cleanup(*this, slot, &r);
@@ -520,18 +543,21 @@ void RLoopManager::RunTreeProcessorMT()
       auto count = entryCount.fetch_add(nEntries);
       try {
          // recursive call to check filters and conditionally execute actions
-         while (r.Next()) {
+         // processing can be stopped early by ranges, hence the check on fNStopsReceived
+         while (r.Next() && fNStopsReceived < fNChildren) {
             if (fNewSampleNotifier.CheckFlag(slot)) {
                UpdateSampleInfo(slot, r);
+               if (fProfilingEnabled)
+                  fColumnIOProfiles[slot].SetTree(r.GetTree()->GetTree());
             }
             RunAndCheckFilters(slot, count++);
+            if (fProfilingEnabled)
+               fColumnIOProfiles[slot].Update();
          }
       } catch (...) {
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
          throw;
       }
-      // fNStopsReceived < fNChildren is always true at the moment as we don't support event loop early quitting in
-      // multi-thread runs, but it costs nothing to be safe and future-proof in case we add support for that later.
       if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd && fNStopsReceived < fNChildren) {
          // something went wrong in the TTreeReader event loop
          throw std::runtime_error("An error was encountered while processing the data. TTreeReader status code is: " +
@@ -564,8 +590,12 @@ void RLoopManager::RunTreeReader()
       while (r.Next() && fNStopsReceived < fNChildren) {
          if (fNewSampleNotifier.CheckFlag(0)) {
             UpdateSampleInfo(/*slot*/0, r);
+            if (fProfilingEnabled)
+               fColumnIOProfiles[0].SetTree(r.GetTree()->GetTree());
          }
          RunAndCheckFilters(0, r.GetCurrentEntry());
+         if (fProfilingEnabled)
+            fColumnIOProfiles[0].Update();
       }
    } catch (...) {
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -619,6 +649,8 @@ void RLoopManager::RunDataSourceMT()
 
    // Each task works on a subrange of entries
    auto runOnRange = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
+      if (fNStopsReceived >= fNChildren) // all Ranges are done, nothing left to do
+         return;
       ROOT::Internal::RSlotStackRAII slotRAII(slotStack);
       const auto slot = slotRAII.fSlot;
       InitNodeSlots(nullptr, slot);
@@ -628,7 +660,7 @@ void RLoopManager::RunDataSourceMT()
       const auto end = range.second;
       R__LOG_DEBUG(0, RDFLogChannel()) << LogRangeProcessing({fDataSource->GetLabel(), start, end, slot});
       try {
-         for (auto entry = start; entry < end; ++entry) {
+         for (auto entry = start; entry < end && fNStopsReceived < fNChildren; ++entry) {
             if (fDataSource->SetEntry(slot, entry)) {
                RunAndCheckFilters(slot, entry);
             }
@@ -642,7 +674,7 @@ void RLoopManager::RunDataSourceMT()
 
    fDataSource->Initialize();
    auto ranges = fDataSource->GetEntryRanges();
-   while (!ranges.empty()) {
+   while (!ranges.empty() && fNStopsReceived < fNChildren) {
       pool.Foreach(runOnRange, ranges);
       ranges = fDataSource->GetEntryRanges();
    }
@@ -731,12 +763,22 @@ void RLoopManager::UpdateSampleInfo(unsigned int slot, TTreeReader &r) {
 void RLoopManager::InitNodes()
 {
    EvalChildrenCounts();
+   EvalEntryWindow();
    for (auto *filter : fBookedFilters)
       filter->InitNode();
    for (auto *range : fBookedRanges)
-      range->InitNode();
-   for (auto *ptr : fBookedActions)
+      range->InitNode(range->IsOnLoopManager() ? fEntryWindow.first : 0ull);
+   for (auto *ptr : fBookedActions) {
+      ptr->ResetProfile();
       ptr->Initialize();
+   }
+   // profiling information always refers to the last event loop
+   for (auto *ptr : fBookedDefines)
+      ptr->ResetProfile();
+   for (auto *ptr : fRunActions)
+      ptr->ResetProfile();
+   for (auto &p : fColumnIOProfiles)
+      p.Reset();
 }
 
 /// Perform clean-up operations. To be called at the end of each event loop.
@@ -769,6 +811,8 @@ void RLoopManager::CleanUpTask(TTreeReader *r, unsigned int slot)
 {
    if (r != nullptr)
       fNewSampleNotifier.GetChainNotifyLink(slot).RemoveLink(*r->GetTree());
+   // the TTreeReader, and possibly the TTree, of this task are about to go away
+   fColumnIOProfiles[slot].SetTree(nullptr);
    for (auto *ptr : fBookedActions)
       ptr->FinalizeSlot(slot);
    for (auto *ptr : fBookedFilters)
@@ -820,6 +864,35 @@ void RLoopManager::EvalChildrenCounts()
       namedFilterPtr->TriggerChildrenCount();
 }
 
+/// Compute the window of entries that multi-thread event loops over ROOT files or over no files have to process.
+/// If all the nodes hanging from the RLoopManager are Ranges, no entry outside of the union of their windows can
+/// be selected, so the event loop only partitions and reads the entries in that window. Each Range then starts
+/// counting from the beginning of the window. Single-thread event loops and data sources process all entries, as
+/// before, and are stopped early once all Ranges are done. So do event loops over trees with an entry list: the
+/// Ranges count the entries of the list, which cannot be mapped to a window of tree entries in advance.
+void RLoopManager::EvalEntryWindow()
+{
+   fEntryWindow = {0ull, std::numeric_limits<ULong64_t>::max()};
+   if (fLoopType != ELoopType::kNoFilesMT && fLoopType != ELoopType::kROOTFilesMT)
+      return;
+   if (fLoopType == ELoopType::kROOTFilesMT && fTree->GetEntryList())
+      return;
+
+   unsigned int nRanges = 0u;
+   std::pair<ULong64_t, ULong64_t> window{std::numeric_limits<ULong64_t>::max(), 0ull};
+   for (auto *range : fBookedRanges) {
+      if (!range->IsOnLoopManager() || !range->HasChildren())
+         continue;
+      ++nRanges;
+      window.first = std::min(window.first, ULong64_t(range->GetStart()));
+      // a stop value of 0 means "until the end of the dataset"
+      window.second = range->GetStop() == 0 ? std::numeric_limits<ULong64_t>::max()
+                                            : std::max(window.second, ULong64_t(range->GetStop()));
+   }
+   if (nRanges > 0u && nRanges == fNChildren)
+      fEntryWindow = window;
+}
+
 /// Start the event loop with a different mechanism depending on IMT/no IMT, data source/no data source.
 /// Also perform a few setup and clean-up operations (jit actions if necessary, clear booked actions after the loop...).
 /// The jitting phase is skipped if the `jit` parameter is `false` (unsafe, use with care).
@@ -848,6 +921,7 @@ void RLoopManager::Run(bool jit)
    case ELoopType::kDataSource: RunDataSource(); break;
    }
    s.Stop();
+   fLastLoopRealTime = s.RealTime();
 
    CleanUpNodes();
 
@@ -1058,6 +1132,8 @@ RColumnReaderBase *RLoopManager::AddTreeColumnReader(unsigned int slot, const st
    assert(readers.find(key) == readers.end() || readers[key] == nullptr);
    auto *rptr = reader.get();
    readers[key] = std::move(reader);
+   if (fProfilingEnabled)
+      fColumnIOProfiles[slot].AddColumn(col);
    return rptr;
 }
 
@@ -1082,3 +1158,54 @@ void RLoopManager::SetEmptyEntryRange(std::pair<ULong64_t, ULong64_t> &&newRange
 {
    fEmptyEntryRange = std::move(newRange);
 }
+
+/// Collect the call counts and timings of all Defines, Filters and actions, and the I/O statistics of all dataset
+/// columns, as recorded during the last event loop. All counters are zero unless profiling was enabled via
+/// SetProfilingEnabled() before the event loop started.
+ROOT::RDF::Experimental::RProfileReport RLoopManager::GetProfileReport() const
+{
+   using ROOT::RDF::Experimental::RColumnIOInfo;
+   using ROOT::RDF::Experimental::RNodeProfileInfo;
+
+   auto perSlot = [this](const RDFInternal::RNodeProfile &p, bool nanoseconds) {
+      std::vector<ULong64_t> v(fNSlots);
+      for (auto slot = 0u; slot < fNSlots; ++slot)
+         v[slot] = nanoseconds ? p.GetNanoseconds(slot) : p.GetNCalls(slot);
+      return v;
+   };
+   auto makeInfo = [&perSlot](const std::string &name, const std::string &kind, const RDFInternal::RNodeProfile &p) {
+      return RNodeProfileInfo(name, kind, perSlot(p, /*nanoseconds=*/false), perSlot(p, /*nanoseconds=*/true));
+   };
+
+   ROOT::RDF::Experimental::RProfileReport report;
+   report.fLoopRealTime = fLastLoopRealTime;
+
+   for (auto *define : fBookedDefines) {
+      auto name = define->GetName();
+      if (define->GetVariation() != "nominal")
+         name += " [" + define->GetVariation() + "]";
+      report.fNodes.emplace_back(makeInfo(name, "Define", define->GetProfile()));
+   }
+   for (auto *filter : fBookedFilters)
+      report.fNodes.emplace_back(
+         makeInfo(filter->HasName() ? filter->GetName() : "Unnamed Filter", "Filter", filter->GetProfile()));
+   for (auto *action : GetAllActions())
+      report.fNodes.emplace_back(makeInfo(action->GetActionName(), "Action", action->GetProfile()));
+
+   for (auto slot = 0u; slot < fNSlots; ++slot) {
+      const auto &io = fColumnIOProfiles[slot];
+      for (auto i = 0u; i < io.GetNColumns(); ++i) {
+         const auto &colName = io.GetColumnName(i);
+         auto it = std::find_if(report.fColumns.begin(), report.fColumns.end(),
+                                [&colName](const RColumnIOInfo &c) { return c.GetName() == colName; });
+         if (it == report.fColumns.end()) {
+            report.fColumns.emplace_back(RColumnIOInfo(colName, fNSlots));
+            it = std::prev(report.fColumns.end());
+         }
+         it->fBytesRead[slot] += io.GetBytesRead(i);
+         it->fBytesUnzipped[slot] += io.GetBytesUnzipped(i);
+      }
+   }
+
+   return report;
+}
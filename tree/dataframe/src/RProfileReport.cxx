@@ -0,0 +1,172 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RNodeProfile.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "TBasket.h"
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TObjArray.h"
+#include "TString.h" // Printf
+#include "TTree.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+void CollectBranches(TBranch *b, std::vector<TBranch *> &branches)
+{
+   branches.push_back(b);
+   for (auto *sb : *b->GetListOfBranches())
+      CollectBranches(static_cast<TBranch *>(sb), branches);
+}
+
+TBranch *FindColumnBranch(TTree &t, const std::string &colName)
+{
+   auto *b = t.GetBranch(colName.c_str());
+   if (!b)
+      b = t.FindBranch(colName.c_str()); // try harder
+   if (!b) {
+      // leaves of leaf-list branches are valid column names too
+      if (auto *leaf = t.FindLeaf(colName.c_str()))
+         b = leaf->GetBranch();
+   }
+   return b;
+}
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+void RNodeProfile::Reset()
+{
+   std::fill(fNCalls.begin(), fNCalls.end(), 0ull);
+   std::fill(fNanoseconds.begin(), fNanoseconds.end(), 0ull);
+}
+
+ULong64_t RNodeProfile::GetNCalls() const
+{
+   return std::accumulate(fNCalls.begin(), fNCalls.end(), 0ull);
+}
+
+ULong64_t RNodeProfile::GetNanoseconds() const
+{
+   return std::accumulate(fNanoseconds.begin(), fNanoseconds.end(), 0ull);
+}
+
+void RColumnIOProfile::ConnectBranches(RColumnState &column)
+{
+   column.fBranches.clear();
+   if (!fTree)
+      return;
+   auto *b = FindColumnBranch(*fTree, column.fName);
+   if (!b)
+      return;
+   std::vector<TBranch *> branches;
+   CollectBranches(b, branches);
+   for (auto *br : branches)
+      column.fBranches.push_back({br, -1});
+}
+
+void RColumnIOProfile::AddColumn(const std::string &name)
+{
+   auto sameName = [&name](const RColumnState &c) { return c.fName == name; };
+   if (std::find_if(fColumns.begin(), fColumns.end(), sameName) != fColumns.end())
+      return;
+   fColumns.emplace_back();
+   fColumns.back().fName = name;
+   ConnectBranches(fColumns.back());
+}
+
+void RColumnIOProfile::SetTree(TTree *tree)
+{
+   fTree = tree;
+   for (auto &c : fColumns)
+      ConnectBranches(c);
+}
+
+void RColumnIOProfile::Update()
+{
+   for (auto &c : fColumns) {
+      for (auto &s : c.fBranches) {
+         auto *b = s.fBranch;
+         // fReadEntry is -1 until the branch is actually read
+         if (b->GetReadEntry() < 0 || b->GetReadBasket() == s.fLastBasket)
+            continue;
+         s.fLastBasket = b->GetReadBasket();
+         const auto onDisk = b->GetBasketBytes() ? b->GetBasketBytes()[s.fLastBasket] : 0;
+         c.fBytesRead += onDisk;
+         auto *basket = static_cast<TBasket *>(b->GetListOfBaskets()->UncheckedAt(s.fLastBasket));
+         if (basket) {
+            c.fBytesUnzipped += basket->GetObjlen() + basket->GetKeylen();
+         } else if (b->GetZipBytes() > 0) {
+            // the basket has already been dropped, estimate its size from the compression factor of the branch
+            c.fBytesUnzipped += ULong64_t(double(onDisk) * b->GetTotBytes() / b->GetZipBytes());
+         }
+      }
+   }
+}
+
+void RColumnIOProfile::Reset()
+{
+   fColumns.clear();
+   fTree = nullptr;
+}
+
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+namespace Experimental {
+
+void RProfileReport::Print() const
+{
+   Printf("Event loop: %.3f s", fLoopRealTime);
+   for (const auto &n : fNodes) {
+      const auto nCalls = n.GetNCalls();
+      const auto time = n.GetRealTime();
+      Printf("%-8s %-20s: calls=%-10llu time=%10.3f ms -- %8.1f ns/call", n.GetKind().c_str(), n.GetName().c_str(),
+             nCalls, time * 1e3, nCalls > 0 ? time * 1e9 / nCalls : 0.);
+   }
+   for (const auto &c : fColumns) {
+      Printf("Column   %-20s: read=%-12llu unzipped=%-12llu bytes", c.GetName().c_str(), c.GetBytesRead(),
+             c.GetBytesUnzipped());
+   }
+}
+
+const RNodeProfileInfo &RProfileReport::operator[](std::string_view nodeName) const
+{
+   auto pred = [&nodeName](const RNodeProfileInfo &n) { return n.GetName() == nodeName; };
+   const auto it = std::find_if(fNodes.begin(), fNodes.end(), pred);
+   if (it == fNodes.end()) {
+      std::string err = "Cannot find a node called \"";
+      err += nodeName;
+      err += "\" in the profile report.";
+      throw std::runtime_error(err);
+   }
+   return *it;
+}
+
+const RColumnIOInfo &RProfileReport::GetColumn(std::string_view columnName) const
+{
+   auto pred = [&columnName](const RColumnIOInfo &c) { return c.GetName() == columnName; };
+   const auto it = std::find_if(fColumns.begin(), fColumns.end(), pred);
+   if (it == fColumns.end()) {
+      std::string err = "Cannot find I/O statistics for column \"";
+      err += columnName;
+      err += "\" in the profile report.";
+      throw std::runtime_error(err);
+   }
+   return *it;
+}
+
+} // namespace Experimental
+} // namespace RDF
+} // namespace ROOT
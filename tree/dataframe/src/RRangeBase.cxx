@@ -9,19 +9,26 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RRangeBase.hxx"
+#include "ROOT/RDF/Utils.hxx" // CacheLineStep
+
+#include <algorithm>
 
 using ROOT::Detail::RDF::RRangeBase;
 
 RRangeBase::RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int stop, unsigned int stride,
-                       const unsigned int nSlots, const std::vector<std::string> &prevVariations)
-   : RNodeBase(prevVariations, implPtr), fStart(start), fStop(stop), fStride(stride), fNSlots(nSlots)
+                       const unsigned int nSlots, const std::vector<std::string> &prevVariations,
+                       bool isOnLoopManager)
+   : RNodeBase(prevVariations, implPtr), fStart(start), fStop(stop), fStride(stride),
+     fLastCheckedEntry(nSlots * ROOT::Internal::RDF::CacheLineStep<Long64_t>(), -1),
+     fLastResult(nSlots * ROOT::Internal::RDF::CacheLineStep<int>(), true), fNSlots(nSlots),
+     fIsOnLoopManager(isOnLoopManager)
 {
 }
 
-void RRangeBase::InitNode()
+void RRangeBase::InitNode(ULong64_t nSkippedEntries)
 {
-   fLastCheckedEntry = -1;
-   fNProcessedEntries = 0;
+   std::fill(fLastCheckedEntry.begin(), fLastCheckedEntry.end(), -1);
+   fNProcessedEntries = nSkippedEntries;
    fHasStopped = false;
 }
 
@@ -125,3 +125,32 @@ TEST(RDFEntryList, TreeMT)
    TestTreeWithEntryList(true);
 }
 #endif
+
+#ifdef R__USE_IMT
+// Ranges count the entries selected by the entry list, not the entries of the tree
+TEST(RDFEntryList, RangeMT)
+{
+   const auto nEntries = 100;
+   const auto treename = "t";
+   const auto filename = "rdfentrylist_range.root";
+   MakeInputFile(filename, nEntries);
+
+   RMTRAII gomt(true);
+
+   TEntryList elist("e", "e");
+   TFile f(filename);
+   auto t = f.Get<TTree>(treename);
+   t->SetEntryList(&elist);
+   for (auto i = 0; i < nEntries; i += 2)
+      elist.Enter(i);
+
+   ROOT::RDataFrame df(*t);
+   EXPECT_EQ(*df.Range(40, 0).Count(), 10u);
+   EXPECT_EQ(*df.Range(60, 0).Count(), 0u);
+   auto entries = df.Range(10).Take<int>("e").GetValue();
+   EXPECT_EQ(entries.size(), 10u);
+   EXPECT_TRUE(std::all_of(entries.begin(), entries.end(), [](int e) { return e % 2 == 0; }));
+
+   gSystem->Unlink(filename);
+}
+#endif
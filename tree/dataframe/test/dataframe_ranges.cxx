@@ -1,5 +1,9 @@
 #include "ROOT/RDataFrame.hxx"
 #include <TROOT.h>
+#include <TSystem.h>
+
+#include <algorithm>
+#include <numeric>
 
 #include "gtest/gtest.h"
 
@@ -91,18 +95,64 @@ TEST_F(RDFRanges, NoEarlyStopping)
 }
 
 #ifdef R__USE_IMT
-TEST(RDFRangesMT, ThrowIfIMT)
+TEST(RDFRangesMT, EmptySource)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d(1000);
+   // the only node booked on the RDataFrame is a Range: exactly the entries in its window are processed
+   auto entries = d.Range(100, 200).Take<ULong64_t>("rdfentry_");
+   auto sorted = *entries;
+   std::sort(sorted.begin(), sorted.end());
+   std::vector<ULong64_t> expected(100);
+   std::iota(expected.begin(), expected.end(), 100ull);
+   EXPECT_EQ(sorted, expected);
+
+   // several Ranges: the right number of entries pass each of them
+   auto c1 = d.Range(10).Count();
+   auto c2 = d.Range(5, 20, 5).Count();
+   auto c3 = d.Range(990, 0).Count();
+   EXPECT_EQ(*c1, 10u);
+   EXPECT_EQ(*c2, 3u);
+   EXPECT_EQ(*c3, 10u);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, AfterFilter)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d(100000);
+   auto f = d.Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"});
+   auto ranged = f.Range(50).Take<ULong64_t>("rdfentry_");
+   auto counted = f.Range(10, 20).Count();
+   EXPECT_EQ(ranged->size(), 50u);
+   EXPECT_TRUE(std::all_of(ranged->begin(), ranged->end(), [](ULong64_t e) { return e % 2 == 0; }));
+   EXPECT_EQ(*counted, 10u);
+
+   // ranges past the end of the dataset select nothing
+   EXPECT_EQ(*d.Range(200000, 300000).Count(), 0u);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, Tree)
 {
-   bool hasThrown = false;
-   ROOT::EnableImplicitMT();
-   RDataFrame d(0);
-   try {
-      d.Range(0);
-   } catch (const std::exception &e) {
-      hasThrown = true;
-      EXPECT_STREQ(e.what(), "Range was called with ImplicitMT enabled, but multi-thread is not supported.");
+   const auto fileName = "dataframe_ranges_mt.root";
+   {
+      ROOT::RDF::RSnapshotOptions opts;
+      opts.fAutoFlush = 10; // many clusters
+      RDataFrame(1000).Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Snapshot<int>("t", fileName,
+                                                                                                    {"x"}, opts);
    }
-   EXPECT_TRUE(hasThrown);
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d("t", fileName);
+   auto xs = d.Range(105, 300).Take<int>("x");
+   auto sorted = *xs;
+   std::sort(sorted.begin(), sorted.end());
+   std::vector<int> expected(195);
+   std::iota(expected.begin(), expected.end(), 105);
+   EXPECT_EQ(sorted, expected);
+   EXPECT_EQ(*d.Range(2000, 0).Count(), 0u);
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(fileName);
 }
 #endif
 
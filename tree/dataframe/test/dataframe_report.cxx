@@ -1,5 +1,9 @@
+#include "TFile.h"
 #include "TRandom.h"
+#include "TSystem.h"
+#include "TTree.h"
 #include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDFHelpers.hxx"
 #include "ROOT/TSeq.hxx"
 #include "gtest/gtest.h"
 
@@ -97,3 +101,72 @@ TEST(RDataFrameReport, ActionLazyness)
    EXPECT_TRUE(hasRun);
 
 }
+
+TEST(RDataFrameReport, ProfileDisabled)
+{
+   ROOT::RDataFrame d(10);
+   auto c = d.Define("x", [] { return 1; }).Filter([](int x) { return x > 0; }, {"x"}).Count();
+   *c;
+   const auto rep = ROOT::RDF::Experimental::GetProfileReport(d);
+   for (const auto &n : rep)
+      EXPECT_EQ(n.GetNCalls(), 0ull);
+}
+
+TEST(RDataFrameReport, ProfileNodes)
+{
+   ROOT::RDataFrame d(100);
+   ROOT::RDF::Experimental::EnableProfiling(d);
+   auto c = d.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+               .Filter([](int x) { return x % 2 == 0; }, {"x"}, "even")
+               .Count();
+   EXPECT_EQ(*c, 50ull);
+
+   const auto rep = ROOT::RDF::Experimental::GetProfileReport(d);
+   EXPECT_EQ(rep["x"].GetKind(), "Define");
+   EXPECT_EQ(rep["x"].GetNCalls(), 100ull);
+   EXPECT_EQ(rep["even"].GetKind(), "Filter");
+   EXPECT_EQ(rep["even"].GetNCalls(), 100ull);
+   EXPECT_EQ(rep["Count"].GetKind(), "Action");
+   EXPECT_EQ(rep["Count"].GetNCalls(), 50ull);
+   EXPECT_GT(rep.GetLoopRealTime(), 0.);
+   EXPECT_ANY_THROW(rep["NonExisting"]);
+
+   // the profile is also reported in the computation graph
+   const auto graph = ROOT::RDF::SaveGraph(d);
+   EXPECT_NE(graph.find("100 calls"), std::string::npos);
+   EXPECT_NE(graph.find("50 calls"), std::string::npos);
+
+   // profiling information refers to the last event loop only
+   ROOT::RDF::Experimental::EnableProfiling(d, false);
+   auto c2 = d.Count();
+   *c2;
+   for (const auto &n : ROOT::RDF::Experimental::GetProfileReport(d))
+      EXPECT_EQ(n.GetNCalls(), 0ull);
+}
+
+TEST(RDataFrameReport, ProfileColumnIO)
+{
+   const auto fname = "dataframe_report_profileio.root";
+   {
+      TFile f(fname, "recreate");
+      TTree t("t", "t");
+      int x = 0;
+      t.Branch("x", &x);
+      for (x = 0; x < 10000; ++x)
+         t.Fill();
+      t.Write();
+   }
+
+   ROOT::RDataFrame d("t", fname);
+   ROOT::RDF::Experimental::EnableProfiling(d);
+   auto s = d.Sum<int>("x");
+   EXPECT_EQ(*s, 49995000.);
+
+   const auto rep = ROOT::RDF::Experimental::GetProfileReport(d);
+   const auto &x = rep.GetColumn("x");
+   EXPECT_GT(x.GetBytesRead(), 0ull);
+   EXPECT_GE(x.GetBytesUnzipped(), 10000ull * sizeof(int));
+   EXPECT_ANY_THROW(rep.GetColumn("y"));
+
+   gSystem->Unlink(fname);
+}
@@ -8,6 +8,7 @@
 
 #include <ROOT/TestSupport.hxx>
 #include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDFHelpers.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TChain.h>
 #include <TFile.h>
@@ -21,6 +22,7 @@
 #include <algorithm> // std::sort
 #include <array>
 #include <chrono>
+#include <mutex>
 #include <thread>
 #include <set>
 #include <random>
@@ -849,6 +851,81 @@ TEST_P(RDFSimpleTests, HistosOneWeightPerEvent)
    EXPECT_DOUBLE_EQ(h3->GetMean(), 2.);
 }
 
+// large histograms are filled concurrently by all slots rather than replicated
+TEST_P(RDFSimpleTests, HistosSharedFill)
+{
+   auto df = RDataFrame(10000)
+                .Define("x", [](ULong64_t e) { return double(e % 10); }, {"rdfentry_"})
+                .Define("v", [](ULong64_t e) { return ROOT::RVecF{float(e % 7), float(e % 5)}; }, {"rdfentry_"})
+                .Define("w", [] { return 2.; });
+   auto fill = [&df] {
+      std::vector<ROOT::RDF::RResultPtr<TH3D>> h3s{
+         df.Histo3D<double, double, double>({"h3", "h3", 10, 0, 10, 10, 0, 10, 10, 0, 10}, "x", "x", "x"),
+         df.Histo3D<double, ROOT::RVecF, double, double>({"h3w", "h3w", 10, 0, 10, 10, 0, 10, 10, 0, 10}, "x", "v",
+                                                         "x", "w")};
+      auto hn = df.HistoND<double, double, double, double>(
+         {"hn", "hn", 3, {10, 10, 10}, {0., 0., 0.}, {10., 10., 10.}}, {"x", "x", "x", "w"});
+      return std::make_pair(h3s, hn);
+   };
+
+   auto replicated = fill();
+   ROOT::RDF::Experimental::SetSharedFillThreshold(0);
+   auto shared = fill();
+   ROOT::RDF::Experimental::SetSharedFillThreshold(1ull << 30);
+
+   for (auto i : {0, 1}) {
+      const auto &r = *replicated.first[i];
+      const auto &s = *shared.first[i];
+      EXPECT_DOUBLE_EQ(r.GetEntries(), s.GetEntries());
+      EXPECT_DOUBLE_EQ(r.GetMean(2), s.GetMean(2));
+      for (int bin = 0; bin < r.GetNcells(); ++bin)
+         ASSERT_DOUBLE_EQ(r.GetBinContent(bin), s.GetBinContent(bin));
+   }
+   EXPECT_DOUBLE_EQ(shared.first[1]->GetEntries(), 20000.);
+   EXPECT_DOUBLE_EQ(replicated.second->GetEntries(), shared.second->GetEntries());
+   EXPECT_DOUBLE_EQ(replicated.second->GetSumw(), shared.second->GetSumw());
+   EXPECT_DOUBLE_EQ(shared.second->GetSumw(), 20000.);
+
+   // partial results are snapshots, which can be read while the other slots keep filling
+   ROOT::RDF::Experimental::SetSharedFillThreshold(0);
+   auto h3 = df.Histo3D<double, double, double>({"h3p", "h3p", 10, 0, 10, 10, 0, 10, 10, 0, 10}, "x", "x", "x");
+   ROOT::RDF::Experimental::SetSharedFillThreshold(1ull << 30);
+   std::mutex m;
+   unsigned int nPartials = 0;
+   bool inRange = true;
+   h3.OnPartialResultSlot(2000, [&](unsigned int, TH3D &h) {
+      std::lock_guard<std::mutex> lock(m);
+      ++nPartials;
+      inRange = inRange && h.GetEntries() <= 10000.;
+   });
+   EXPECT_DOUBLE_EQ(h3->GetEntries(), 10000.);
+   EXPECT_GT(nPartials, 0u);
+   EXPECT_TRUE(inRange);
+}
+
+TEST_P(RDFSimpleTests, TakeInto)
+{
+   auto df = RDataFrame(10000).Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Filter([](int x) {
+      return x % 3 != 0;
+   }, {"x"});
+   auto expected = df.Take<int>("x");
+   const auto nValues = *df.Count();
+
+   std::vector<int> buffer(nValues + 10, -1);
+   auto n = ROOT::RDF::Experimental::TakeInto<int>(df, "x", buffer.data(), buffer.size());
+   EXPECT_EQ(*n, nValues);
+   EXPECT_TRUE(std::all_of(buffer.begin() + nValues, buffer.end(), [](int x) { return x == -1; }));
+   buffer.resize(nValues);
+   std::sort(buffer.begin(), buffer.end());
+   auto sortedExpected = *expected;
+   std::sort(sortedExpected.begin(), sortedExpected.end());
+   EXPECT_EQ(buffer, sortedExpected);
+
+   std::vector<int> tooSmall(nValues - 1);
+   auto n2 = ROOT::RDF::Experimental::TakeInto<int>(df, "x", tooSmall.data(), tooSmall.size());
+   EXPECT_THROW(n2.GetValue(), std::runtime_error);
+}
+
 TEST_P(RDFSimpleTests, ManyRangesPerWorker)
 {
    auto filename = "ManyRangesPerWorker_file.root";
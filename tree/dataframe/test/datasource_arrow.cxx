@@ -2,12 +2,15 @@
 #include <ROOT/RArrowDS.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
 #endif
 #include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
 #include <arrow/memory_pool.h>
 #include <arrow/record_batch.h>
 #include <arrow/table.h>
@@ -202,6 +205,83 @@ TEST(RArrowDS, FromARDFWithJitting)
    EXPECT_EQ(40, *min);
 }
 
+// Write the test table to an Arrow IPC file, in record batches of (at most) batchSize rows
+void writeTestIPCFile(const std::string &fileName, int64_t batchSize)
+{
+   auto table = createTestTable();
+   auto sink = arrow::io::FileOutputStream::Open(fileName);
+   ASSERT_TRUE(sink.ok());
+   auto writer = arrow::ipc::MakeFileWriter(*sink, table->schema());
+   ASSERT_TRUE(writer.ok());
+   ASSERT_TRUE((*writer)->WriteTable(*table, batchSize).ok());
+   ASSERT_TRUE((*writer)->Close().ok());
+}
+
+TEST(RArrowDS, IPCFileEntryRanges)
+{
+   const auto fileName = "datasource_arrow_entryranges.arrow";
+   writeTestIPCFile(fileName, 2);
+
+   {
+      // one entry range per record batch
+      RArrowDS tds(fileName, {});
+      tds.SetNSlots(2U);
+      auto valsAge = tds.GetColumnReaders<Long64_t>("Age");
+      tds.Initialize();
+      auto ranges = tds.GetEntryRanges();
+      ASSERT_EQ(3U, ranges.size());
+      std::vector<Long64_t> refsAge = {64, 50, 40, 30, 2, 0};
+      for (auto i : ROOT::TSeqU(3)) {
+         EXPECT_EQ(2U * i, ranges[i].first);
+         EXPECT_EQ(2U * i + 2U, ranges[i].second);
+         const auto slot = i % 2;
+         tds.InitSlot(slot, ranges[i].first);
+         for (auto entry : ROOT::TSeq<ULong64_t>(ranges[i].first, ranges[i].second)) {
+            tds.SetEntry(slot, entry);
+            EXPECT_EQ(refsAge[entry], **valsAge[slot]);
+         }
+      }
+   }
+
+   {
+      // fewer batches than slots: fall back to equal ranges
+      RArrowDS tds(fileName, {});
+      tds.SetNSlots(6U);
+      tds.Initialize();
+      EXPECT_EQ(6U, tds.GetEntryRanges().size());
+   }
+
+   gSystem->Unlink(fileName);
+}
+
+TEST(RArrowDS, NoColumns)
+{
+   auto table = Table::Make(schema({}), std::vector<std::shared_ptr<ChunkedArray>>{}, 4);
+   RArrowDS tds(table, {});
+   tds.SetNSlots(2U);
+   tds.Initialize();
+   auto ranges = tds.GetEntryRanges();
+   ASSERT_EQ(2U, ranges.size());
+   EXPECT_EQ(0U, ranges[0].first);
+   EXPECT_EQ(4U, ranges[1].second);
+}
+
+TEST(RArrowDS, FromArrowIPC)
+{
+   const auto fileName = "datasource_arrow_fromipc.arrow";
+   writeTestIPCFile(fileName, 4);
+
+   auto rdf = ROOT::RDF::FromArrowIPC(fileName, {"Name", "Height"});
+   auto max = rdf.Max<double>("Height");
+   auto c = rdf.Filter([](const std::string &n) { return n == "Tom"; }, {"Name"}).Count();
+   EXPECT_DOUBLE_EQ(200.5, *max);
+   EXPECT_EQ(1U, *c);
+
+   EXPECT_THROW(ROOT::RDF::FromArrowIPC("nonexistent.arrow"), std::runtime_error);
+
+   gSystem->Unlink(fileName);
+}
+
 // NOW MT!-------------
 #ifdef R__USE_IMT
 
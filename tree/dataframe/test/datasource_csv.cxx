@@ -3,6 +3,9 @@
 #include <ROOT/TSeq.hxx>
 #include <ROOT/TestSupport.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
+
+#include <fstream>
 
 #include <gtest/gtest.h>
 
@@ -422,4 +425,34 @@ TEST(RCsvDS, NanWarningChecks)
    EXPECT_EQ(d->AsString(), AsString);
 }
 
+TEST(RCsvDS, ParallelParsingMT)
+{
+   ROOT::EnableImplicitMT(4);
+
+   // more lines than a parsing batch, with quoted fields containing delimiters and escaped quotes
+   const auto fileName = "RCsvDS_test_parallel.csv";
+   const auto nLines = 100000LL;
+   {
+      std::ofstream f(fileName);
+      f << "i,x,b,s\n";
+      for (auto i = 0LL; i < nLines; ++i)
+         f << i << ',' << i << ".5," << (i % 2 ? "true" : "false") << ",\"a, \"\"" << i % 3 << "\"\"\"\n";
+   }
+
+   for (auto chunkSize : {-1LL, 30000LL}) {
+      auto df = ROOT::RDF::FromCSV(fileName, true, ',', chunkSize);
+      auto sumI = df.Sum<Long64_t>("i");
+      auto sumX = df.Sum<double>("x");
+      auto nTrue = df.Filter([](bool b) { return b; }, {"b"}).Count();
+      auto nS = df.Filter([](const std::string &s) { return s == "a, \"2\""; }, {"s"}).Count();
+      EXPECT_EQ(*sumI, nLines * (nLines - 1) / 2);
+      EXPECT_DOUBLE_EQ(*sumX, nLines * (nLines - 1) / 2 + 0.5 * nLines);
+      EXPECT_EQ(*nTrue, ULong64_t(nLines / 2));
+      EXPECT_EQ(*nS, ULong64_t(nLines / 3));
+   }
+
+   gSystem->Unlink(fileName);
+   ROOT::DisableImplicitMT();
+}
+
 #endif // R__USE_IMT
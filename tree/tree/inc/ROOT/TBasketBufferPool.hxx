@@ -0,0 +1,63 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBasketBufferPool
+#define ROOT_TBasketBufferPool
+
+#include "RtypesCore.h"
+#include "TBuffer.h"
+
+namespace ROOT {
+namespace Internal {
+
+/**
+\class ROOT::Internal::TBasketBufferPool
+\ingroup tree
+\brief Pool of the I/O buffers used to read baskets.
+
+Reading a tree allocates, for each basket, a buffer for its uncompressed content, which is freed
+when the basket is dropped. Instead of freeing them, TBasket and TTreeCacheUnzip give their buffers
+back to this pool, from which the buffers of the next baskets are taken. TBranch::GetBulkEntries, whose
+buffer takes over the memory of a basket already in memory, gives back the memory it replaces. Only
+buffers in read mode are pooled; the buffers of baskets being written are allocated and freed as before.
+
+Buffers are kept per thread, sorted in size classes (four per power of two), such that acquiring and
+releasing a buffer needs no lock. A buffer goes to the pool of the thread releasing it, which is not
+necessarily the one that acquired it. The total size of the buffers kept by all threads is bounded by
+SetMaxPooledBytes(); buffers beyond that are freed.
+*/
+class TBasketBufferPool {
+public:
+   /// Return a TBufferFile in read mode, owning a buffer of at least `size` bytes.
+   /// It must be given back with Release() or deleted.
+   static TBuffer *Acquire(Int_t size);
+   /// Give back `buffer` to the pool of this thread, or delete it. Buffers in write mode, that do not
+   /// own their memory or that use a custom reallocation function are always deleted.
+   static void Release(TBuffer *buffer);
+
+   /// Return memory of at least `size` bytes, allocated with `new char[]`, and set `capacity` to its size.
+   static char *AcquireMemory(Int_t size, Int_t &capacity);
+   /// Give back memory of at least `capacity` bytes, allocated with `new char[]`.
+   static void ReleaseMemory(char *memory, Int_t capacity);
+
+   /// Number of buffers acquired by all threads.
+   static ULong64_t GetNAcquired();
+   /// Number of acquired buffers that were taken from a pool rather than allocated.
+   static ULong64_t GetNReused();
+   /// Number of bytes currently kept by the pools of all threads.
+   static Long64_t GetPooledBytes();
+
+   /// Set the maximum number of bytes kept by the pools of all threads (default: 64 MB); 0 disables pooling.
+   static void SetMaxPooledBytes(Long64_t maxBytes);
+   static Long64_t GetMaxPooledBytes();
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
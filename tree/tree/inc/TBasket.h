@@ -144,6 +144,7 @@ public:
 
    Int_t           LoadBasketBuffers(Long64_t pos, Int_t len, TFile *file, TTree *tree = nullptr);
    Long64_t        CopyTo(TFile *to);
+           Int_t   Recompress(Int_t cxlevel, Int_t cxAlgorithm);
 
            void    SetBranch(TBranch *branch) { fBranch = branch; }
            void    SetNevBufSize(Int_t n) { fNevBufSize=n; }
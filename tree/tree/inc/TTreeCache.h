@@ -29,6 +29,12 @@ class TTree;
 class TBranch;
 class TObjArray;
 
+namespace ROOT {
+namespace Internal {
+class TTreeCacheReadAhead;
+}
+}
+
 class TTreeCache : public TFileCacheRead {
 
 public:
@@ -104,6 +110,12 @@ protected:
 
    std::unique_ptr<MissCache> fMissCache; ///<! Cache contents for misses
 
+   Int_t    fReadAheadClusters{0};         ///<! Number of clusters read ahead asynchronously (0: disabled)
+   Long64_t fReadAheadMaxBytes{0};         ///<! Maximum number of bytes read ahead (0: the size of the cache)
+   Long64_t fReadAheadBytes{0};            ///<! Number of bytes of the cache taken from the clusters read ahead
+   Bool_t   fReadAheadTried{kFALSE};       ///<! true if the read-ahead was set up for the current file
+   std::unique_ptr<ROOT::Internal::TTreeCacheReadAhead> fReadAhead; ///<! Reads the clusters after the cached ones
+
 private:
    TTreeCache(const TTreeCache &) = delete; ///< this class cannot be copied
    TTreeCache &operator=(const TTreeCache &) = delete;
@@ -124,6 +136,11 @@ private:
    TBranch *CalculateMissEntries(Long64_t, int, bool);    ///< Given an file read, try to determine the corresponding branch.
    Bool_t   ProcessMiss(Long64_t pos, int len); ///<! Given a file read not in the miss cache, handle (possibly) loading the data.
 
+   TString GetConfiguredProfile() const;
+   Int_t  GetConfiguredReadAhead() const;
+   void   ReadAhead(); ///< Take the content of the cache from the read-ahead and read the next clusters ahead.
+   void   ResetReadAhead();
+
 public:
 
    TTreeCache();
@@ -146,6 +163,8 @@ public:
    virtual EPrefillType GetLearnPrefill() const {return fPrefillType;}
    Double_t             GetMissEfficiency() const;
    Double_t             GetMissEfficiencyRel() const;
+   Long64_t             GetReadAheadBytes() const;
+   Int_t                GetReadAheadClusters() const { return fReadAheadClusters; }
    TTree               *GetTree() const {return fTree;}
    Bool_t               IsAutoCreated() const {return fAutoCreated;}
    virtual Bool_t       IsEnabled() const {return fEnabled;}
@@ -154,6 +173,7 @@ public:
    virtual Bool_t       FillBuffer();
    Int_t                LearnBranch(TBranch *b, Bool_t subgbranches = kFALSE) override;
    virtual void         LearnPrefill();
+   Int_t                LoadProfile(const char *filename = nullptr);
 
    void                 Print(Option_t *option="") const override;
    Int_t                ReadBuffer(char *buf, Long64_t pos, Int_t len) override;
@@ -168,6 +188,7 @@ public:
    virtual void         SetLearnPrefill(EPrefillType type = kNoPrefill);
    static void          SetLearnEntries(Int_t n = 10);
    void                 SetOptimizeMisses(Bool_t opt);
+   virtual void         SetReadAhead(Int_t nclusters, Long64_t maxbytes = 0);
    void                 StartLearningPhase();
    virtual void         StopLearningPhase();
    virtual void         UpdateBranches(TTree *tree);
@@ -97,6 +97,13 @@ protected:
    Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of a group of baskets ready to be unzipped by a IMT task
    Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
 
+   // Members used to unzip the baskets in the order they are read
+   std::vector<Long64_t>  fSeekEntry;    ///<! [fNseek] First entry of the baskets in the cache
+   std::vector<Int_t>     fUnzipOrder;   ///<! Indices of the baskets, sorted by their first entry
+   std::atomic<Int_t>     fUnzipNext;    ///<! Position in fUnzipOrder of the next basket to unzip
+   std::atomic<Long64_t>  fUnzipBytes;   ///<! Summed size of the unzipped blocks not yet read
+   std::atomic<Bool_t>    fUnzipStalled; ///<! Tasks stopped because fUnzipBufferSize was reached
+
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
    // Members use to keep statistics
@@ -104,6 +111,8 @@ protected:
    Int_t       fNMissed;          ///<! number of blocks that were not found in the cache and were unzipped
    Int_t       fNStalls;          ///<! number of hits which caused a stall
    Int_t       fNUnzip;           ///<! number of blocks that were unzipped
+   Int_t       fNReaderUnzip;     ///<! number of blocks in the cache that were unzipped by the reading thread
+   std::atomic<Int_t> fNDeferred; ///<! number of blocks whose unzipping was deferred to stay within fUnzipBufferSize
 
 private:
    TTreeCacheUnzip(const TTreeCacheUnzip &) = delete;
@@ -114,6 +123,9 @@ private:
 
    // Private methods
    void  Init();
+   Bool_t ReserveUnzipBytes(Int_t len);
+   void  RewindUnzipOrder(Int_t next);
+   Int_t TakeUnzipped(Int_t index, char **buf, Bool_t *free);
 
 public:
    TTreeCacheUnzip();
@@ -151,7 +163,9 @@ public:
    // Methods to get stats
    Int_t  GetNUnzip() { return fNUnzip; }
    Int_t  GetNMissed(){ return fNMissed; }
+   Int_t  GetNReaderUnzip() { return fNReaderUnzip; }
    Int_t  GetNFound() { return fNFound; }
+   Int_t  GetNDeferred() { return fNDeferred; }
 
    void Print(Option_t* option = "") const override;
 
@@ -23,6 +23,7 @@
 #include "TVirtualMutex.h"
 #include "TVirtualPerfStats.h"
 #include "TTimeStamp.h"
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "RZip.h"
 
@@ -105,13 +106,13 @@ TBasket::~TBasket()
 {
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
-   if (fBufferRef) delete fBufferRef;
+   ROOT::Internal::TBasketBufferPool::Release(fBufferRef);
    fBufferRef = 0;
    fBuffer = 0;
    fDisplacement= 0;
    // Note we only delete the compressed buffer if we own it
    if (fCompressedBufferRef && fOwnsCompressedBuffer) {
-      delete fCompressedBufferRef;
+      ROOT::Internal::TBasketBufferPool::Release(fCompressedBufferRef);
       fCompressedBufferRef = 0;
    }
    // TKey::~TKey will use fMotherDir to attempt to remove they key
@@ -158,6 +159,91 @@ Long64_t TBasket::CopyTo(TFile *to)
    return nBytes>0 ? nBytes : -1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compress again the content of a basket loaded by LoadBasketBuffers() with
+/// the given compression level and algorithm, as WriteBuffer() would do.
+/// The function does not access any file, such that it can be called for several
+/// baskets concurrently; it is called by TTreeCloner when the compression settings
+/// of the output differ from the ones of the input.
+/// The function returns 0 in case of success, 1 in case of error, leaving the
+/// basket unchanged.
+
+Int_t TBasket::Recompress(Int_t cxlevel, Int_t cxAlgorithm)
+{
+   if (!fBufferRef || fObjlen <= 0)
+      return 1;
+
+   char *rawBuffer = fBufferRef->Buffer();
+   const Bool_t compressed = fObjlen > fNbytes - fKeylen;
+   if (!compressed && cxlevel <= 0)
+      return 0;
+
+   // Unzip the object part of the basket, if needed.
+   char *objbuf = rawBuffer + fKeylen;
+   Int_t objcapacity = 0;
+   if (compressed) {
+      objbuf = ROOT::Internal::TBasketBufferPool::AcquireMemory(fObjlen, objcapacity);
+      UChar_t *bufcur = (UChar_t *)rawBuffer + fKeylen;
+      Int_t nin, nbuf;
+      Int_t nout = 0, noutot = 0;
+      while (1) {
+         if (R__unzip_header(&nin, bufcur, &nbuf) != 0)
+            break;
+         R__unzip(&nin, bufcur, &nbuf, (unsigned char *)objbuf + noutot, &nout);
+         if (!nout) break;
+         noutot += nout;
+         if (noutot >= fObjlen) break;
+         bufcur += nin;
+      }
+      if (noutot != fObjlen) {
+         Error("Recompress", "fNbytes = %d, fKeylen = %d, fObjlen = %d, noutot = %d", fNbytes, fKeylen, fObjlen, noutot);
+         ROOT::Internal::TBasketBufferPool::ReleaseMemory(objbuf, objcapacity);
+         return 1;
+      }
+   }
+
+   // Compress it again, keeping it uncompressed if this does not reduce its size.
+   Int_t nbuffers = 1 + (fObjlen - 1) / kMAXZIPBUF;
+   Int_t buflen = fKeylen + fObjlen + 9 * nbuffers + 28;
+   Int_t capacity = 0;
+   char *newBuffer = ROOT::Internal::TBasketBufferPool::AcquireMemory(buflen, capacity);
+   Int_t noutot = 0;
+   if (cxlevel > 0) {
+      char *bufcur = newBuffer + fKeylen;
+      Int_t nzip = 0;
+      for (Int_t i = 0; i < nbuffers; ++i) {
+         Int_t bufmax = (i == nbuffers - 1) ? fObjlen - nzip : kMAXZIPBUF;
+         Int_t nout = 0;
+         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf + nzip, &bufmax, bufcur, &nout,
+                                 static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(cxAlgorithm));
+         if (nout == 0 || noutot + nout >= fObjlen) {
+            noutot = 0;
+            break;
+         }
+         bufcur += nout;
+         noutot += nout;
+         nzip += kMAXZIPBUF;
+      }
+   }
+   if (!noutot) {
+      memcpy(newBuffer + fKeylen, objbuf, fObjlen);
+      noutot = fObjlen;
+   }
+   memcpy(newBuffer, rawBuffer, fKeylen);
+   if (compressed)
+      ROOT::Internal::TBasketBufferPool::ReleaseMemory(objbuf, objcapacity);
+
+   // The key header is streamed again by CopyTo.
+   Int_t oldCapacity = fBufferRef->BufferSize();
+   Bool_t isOwner = fBufferRef->TestBit(TBuffer::kIsOwner);
+   fBufferRef->DetachBuffer();
+   if (isOwner)
+      ROOT::Internal::TBasketBufferPool::ReleaseMemory(rawBuffer, oldCapacity);
+   fBufferRef->SetBuffer(newBuffer, capacity, kTRUE);
+   fNbytes = fKeylen + noutot;
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///  Delete fEntryOffset array.
 
@@ -176,8 +262,9 @@ Int_t TBasket::DropBuffers()
 
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
-   if (fBufferRef)    delete fBufferRef;
-   if (fCompressedBufferRef && fOwnsCompressedBuffer) delete fCompressedBufferRef;
+   ROOT::Internal::TBasketBufferPool::Release(fBufferRef);
+   if (fCompressedBufferRef && fOwnsCompressedBuffer)
+      ROOT::Internal::TBasketBufferPool::Release(fCompressedBufferRef);
    fBufferRef   = 0;
    fCompressedBufferRef = 0;
    fBuffer      = 0;
@@ -256,7 +343,7 @@ Int_t TBasket::LoadBasketBuffers(Long64_t pos, Int_t len, TFile *file, TTree *tr
       }
       fBufferRef->SetReadMode();
    } else {
-      fBufferRef = new TBufferFile(TBuffer::kRead, len);
+      fBufferRef = ROOT::Internal::TBasketBufferPool::Acquire(len);
    }
    fBufferRef->SetParent(file);
    char *buffer = fBufferRef->Buffer();
@@ -379,11 +466,13 @@ Int_t TBasket::ReadBasketBuffersUncompressedCase()
 
 Int_t TBasket::ReadBasketBuffersUnzip(char* buffer, Int_t size, Bool_t mustFree, TFile* file)
 {
-   if (fBufferRef) {
+   if (fBufferRef && !fBufferRef->TestBit(TBuffer::kIsOwner)) {
       fBufferRef->SetBuffer(buffer, size, mustFree);
       fBufferRef->SetReadMode();
       fBufferRef->Reset();
    } else {
+      // Give the memory of the current buffer back for the next basket rather than freeing it.
+      ROOT::Internal::TBasketBufferPool::Release(fBufferRef);
       fBufferRef = new TBufferFile(TBuffer::kRead, size, buffer, mustFree);
    }
    fBufferRef->SetParent(file);
@@ -420,7 +509,7 @@ static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t l
       bufferRef->Reset();
       result = bufferRef;
    } else {
-      result = new TBufferFile(TBuffer::kRead, len);
+      result = ROOT::Internal::TBasketBufferPool::Acquire(len);
    }
    result->SetParent(file);
    return result;
@@ -720,7 +809,7 @@ void TBasket::DisownBuffer()
 /// Adopt a buffer from an external entity
 void TBasket::AdoptBuffer(TBuffer *user_buffer)
 {
-   delete fBufferRef;
+   ROOT::Internal::TBasketBufferPool::Release(fBufferRef);
    fBufferRef = user_buffer;
 }
 
@@ -0,0 +1,204 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TBasketBufferPool.hxx"
+#include "TBufferFile.h"
+#include "TStorage.h"
+
+#include <atomic>
+#include <typeinfo>
+#include <vector>
+
+namespace {
+
+/// Each power of two is split in four size classes: class `4 * e + k` starts at 2^e * (1 + k / 4), such that
+/// rounding a size up to its class wastes less than a quarter of it.
+constexpr int kNSizeClasses = 4 * 31;
+
+std::atomic<ULong64_t> gNAcquired{0};
+std::atomic<ULong64_t> gNReused{0};
+std::atomic<Long64_t> gMaxPooledBytes{64 * 1024 * 1024};
+/// Bytes kept by the pools of all threads.
+std::atomic<Long64_t> gPooledBytes{0};
+
+/// Smallest size of the buffers of class `c`.
+Long64_t SizeOfClass(int c)
+{
+   const Long64_t base = Long64_t(1) << (c / 4);
+   return base + (c % 4) * (base / 4);
+}
+
+/// Class of a buffer of `size` (> 0) bytes.
+int FloorSizeClass(Int_t size)
+{
+   int e = 0;
+   while ((Long64_t(2) << e) <= size)
+      ++e;
+   const Long64_t base = Long64_t(1) << e;
+   const int k = base >= 4 ? int((size - base) / (base / 4)) : 0;
+   return 4 * e + k;
+}
+
+/// Smallest class whose buffers are all large enough for `size` bytes.
+int CeilSizeClass(Int_t size)
+{
+   const int c = FloorSizeClass(size);
+   return SizeOfClass(c) < size ? c + 1 : c;
+}
+
+struct TThreadPool {
+   std::vector<TBuffer *> fFree[kNSizeClasses];
+   ~TThreadPool();
+};
+
+// Trivially destructible, so still usable while the thread_local pool is being destroyed.
+thread_local bool gThreadPoolDestroyed = false;
+
+TThreadPool::~TThreadPool()
+{
+   gThreadPoolDestroyed = true;
+   for (auto &buffers : fFree) {
+      for (auto *b : buffers) {
+         gPooledBytes -= b->BufferSize();
+         delete b;
+      }
+   }
+}
+
+/// The pool of the calling thread, nullptr if the thread is exiting.
+TThreadPool *GetThreadPool()
+{
+   if (gThreadPoolDestroyed)
+      return nullptr;
+   thread_local TThreadPool pool;
+   return &pool;
+}
+
+TBuffer *TakeFromPool(TThreadPool &pool, Int_t size)
+{
+   const int ceilClass = CeilSizeClass(size);
+   // accept buffers up to about twice larger than needed
+   for (int c = ceilClass; c < kNSizeClasses && c <= ceilClass + 3; ++c) {
+      auto &buffers = pool.fFree[c];
+      if (!buffers.empty()) {
+         TBuffer *b = buffers.back();
+         buffers.pop_back();
+         return b;
+      }
+   }
+   // buffers of the class below might be large enough too
+   if (ceilClass > 0) {
+      auto &buffers = pool.fFree[ceilClass - 1];
+      for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+         if ((*it)->BufferSize() >= size) {
+            TBuffer *b = *it;
+            *it = buffers.back();
+            buffers.pop_back();
+            return b;
+         }
+      }
+   }
+   return nullptr;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+TBuffer *TBasketBufferPool::Acquire(Int_t size)
+{
+   gNAcquired.fetch_add(1, std::memory_order_relaxed);
+   if (size < TBuffer::kMinimalSize)
+      size = TBuffer::kMinimalSize;
+
+   TThreadPool *pool = GetThreadPool();
+   if (pool) {
+      if (TBuffer *b = TakeFromPool(*pool, size)) {
+         gPooledBytes -= b->BufferSize();
+         gNReused.fetch_add(1, std::memory_order_relaxed);
+         b->SetReadMode();
+         b->Reset();
+         b->ResetBit(TBufferFile::kNotDecompressed);
+         b->ResetBit(TBuffer::kCannotHandleMemberWiseStreaming);
+         return b;
+      }
+   }
+
+   // Round the size up to its class, such that the buffer can serve any request of that class once released.
+   const int c = CeilSizeClass(size);
+   if (c < kNSizeClasses && GetMaxPooledBytes() > 0)
+      size = Int_t(SizeOfClass(c));
+   return new TBufferFile(TBuffer::kRead, size);
+}
+
+void TBasketBufferPool::Release(TBuffer *buffer)
+{
+   if (!buffer)
+      return;
+
+   TThreadPool *pool = GetThreadPool();
+   const Long64_t size = buffer->BufferSize();
+   // Only read buffers allocated as by TBufferFile can be handed out again.
+   const bool poolable = pool && typeid(*buffer) == typeid(TBufferFile) && buffer->IsReading() &&
+                         buffer->Buffer() && buffer->TestBit(TBuffer::kIsOwner) &&
+                         buffer->GetReAllocFunc() == TStorage::ReAllocChar && size > 0;
+   if (!poolable || gPooledBytes.fetch_add(size) + size > GetMaxPooledBytes()) {
+      if (poolable)
+         gPooledBytes -= size;
+      delete buffer;
+      return;
+   }
+   buffer->SetParent(nullptr);
+   pool->fFree[FloorSizeClass(size)].push_back(buffer);
+}
+
+char *TBasketBufferPool::AcquireMemory(Int_t size, Int_t &capacity)
+{
+   TBuffer *b = Acquire(size);
+   char *memory = b->Buffer();
+   capacity = b->BufferSize();
+   b->DetachBuffer();
+   delete b;
+   return memory;
+}
+
+void TBasketBufferPool::ReleaseMemory(char *memory, Int_t capacity)
+{
+   if (!memory)
+      return;
+   Release(new TBufferFile(TBuffer::kRead, capacity, memory, kTRUE));
+}
+
+ULong64_t TBasketBufferPool::GetNAcquired()
+{
+   return gNAcquired.load(std::memory_order_relaxed);
+}
+
+ULong64_t TBasketBufferPool::GetNReused()
+{
+   return gNReused.load(std::memory_order_relaxed);
+}
+
+Long64_t TBasketBufferPool::GetPooledBytes()
+{
+   return gPooledBytes;
+}
+
+void TBasketBufferPool::SetMaxPooledBytes(Long64_t maxBytes)
+{
+   gMaxPooledBytes = maxBytes;
+}
+
+Long64_t TBasketBufferPool::GetMaxPooledBytes()
+{
+   return gMaxPooledBytes;
+}
+
+} // namespace Internal
+} // namespace ROOT
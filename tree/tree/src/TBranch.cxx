@@ -52,12 +52,34 @@
 #include "TBranchIMTHelper.h"
 
 #include "ROOT/TIOFeatures.hxx"
+#include "ROOT/TBasketBufferPool.hxx"
 
 #include <atomic>
 #include <cstddef>
 #include <cstring>
 #include <cstdio>
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Let the buffer of a bulk read take over the memory of the basket buffer `buf`,
+/// giving the memory it owned so far back to the basket buffer pool, from which
+/// the next baskets are read, instead of freeing it.
+
+void AdoptBasketMemory(TBuffer &user_buf, TBuffer &buf)
+{
+   if (user_buf.Buffer() && user_buf.TestBit(TBufferIO::kIsOwner) &&
+       user_buf.GetReAllocFunc() == TStorage::ReAllocChar) {
+      char *memory = user_buf.Buffer();
+      const Int_t capacity = user_buf.BufferSize();
+      user_buf.ResetBit(TBufferIO::kIsOwner);
+      ROOT::Internal::TBasketBufferPool::ReleaseMemory(memory, capacity);
+   }
+   user_buf.SetBuffer(buf.Buffer(), buf.BufferSize());
+   buf.ResetBit(TBufferIO::kIsOwner);
+}
+
+} // namespace
 
 Int_t TBranch::fgCount = 0;
 
@@ -1513,8 +1535,7 @@ Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
       R__ASSERT(result == fReadBasket);
       if (fBasketSeek[fReadBasket]) {
          // It is backed, so we can be destructive
-         user_buf.SetBuffer(buf->Buffer(), buf->BufferSize());
-         buf->ResetBit(TBufferIO::kIsOwner);
+         AdoptBasketMemory(user_buf, *buf);
          fCurrentBasket = nullptr;
          fBaskets[fReadBasket] = nullptr;
       } else {
@@ -1631,8 +1652,7 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
       R__ASSERT(result == fReadBasket);
       if (fBasketSeek[fReadBasket]) {
          // It is backed, so we can be destructive
-         user_buf.SetBuffer(buf->Buffer(), buf->BufferSize());
-         buf->ResetBit(TBufferIO::kIsOwner);
+         AdoptBasketMemory(user_buf, *buf);
          fCurrentBasket = nullptr;
          fBaskets[fReadBasket] = nullptr;
       } else {
@@ -63,6 +63,12 @@ the trees in the chain.
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include <numeric> // std::iota
+#include <vector>
+#endif
+
 ClassImp(TChain);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -977,12 +983,68 @@ Long64_t TChain::GetEntries() const
                                " run TChain::SetProof(kTRUE, kTRUE) first");
       return fProofChain->GetEntries();
    }
+   if (fEntries == TTree::kMaxEntries) {
+      const_cast<TChain*>(this)->ReadEntriesConcurrently();
+   }
    if (fEntries == TTree::kMaxEntries) {
       const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
    }
    return fEntries;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the number of entries of the trees of the chain for which it is not
+/// known yet, opening their files concurrently, and update the tree offsets.
+///
+/// This is only done if implicit multi-threading is enabled: otherwise, or for
+/// the files that cannot be read here, LoadTree reads (and reports errors about)
+/// one file after the other.
+
+void TChain::ReadEntriesConcurrently()
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || fProofChain)
+      return;
+
+   std::vector<TChainElement *> unknown;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      auto *element = static_cast<TChainElement *>(fFiles->UncheckedAt(i));
+      if (element->GetEntries() == TTree::kMaxEntries)
+         unknown.push_back(element);
+   }
+   if (unknown.size() < 2)
+      return;
+
+   std::vector<Long64_t> entries(unknown.size(), TTree::kMaxEntries);
+   auto readEntries = [&](std::size_t idx) {
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> file(TFile::Open(unknown[idx]->GetTitle(), "READ_WITHOUT_GLOBALREGISTRATION"));
+      if (!file || file->IsZombie())
+         return;
+      if (auto *tree = file->Get<TTree>(unknown[idx]->GetName()))
+         entries[idx] = tree->GetEntries();
+   };
+   std::vector<std::size_t> idxs(unknown.size());
+   std::iota(idxs.begin(), idxs.end(), 0u);
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(readEntries, idxs);
+
+   for (std::size_t idx = 0; idx < unknown.size(); ++idx) {
+      if (entries[idx] != TTree::kMaxEntries)
+         unknown[idx]->SetNumberEntries(entries[idx]);
+   }
+   // offsets after a tree with an unknown number of entries stay unknown
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      const auto nentries = static_cast<TChainElement *>(fFiles->UncheckedAt(i))->GetEntries();
+      if (fTreeOffset[i] == TTree::kMaxEntries || nentries == TTree::kMaxEntries)
+         fTreeOffset[i + 1] = TTree::kMaxEntries;
+      else
+         fTreeOffset[i + 1] = fTreeOffset[i] + nentries;
+   }
+   fEntries = fTreeOffset[fNtrees];
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get entry from the file to memory.
 ///
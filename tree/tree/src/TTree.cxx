@@ -3517,6 +3517,16 @@ namespace {
 ///
 /// See TTree::CloneTree for a detailed explanation of the semantics of these 3 options.
 ///
+/// When 'fast' is specified, 'option' can also contain 'recompress': the baskets
+/// whose compression settings differ from the ones of the branches of this tree are
+/// then unzipped and zipped again (in parallel when the implicit multi-threading is
+/// enabled) instead of being copied as is.
+///
+/// Without 'fast', or if the fast cloning is not possible (e.g. the branches of the two
+/// trees differ), the entries are read and filled one by one in the calling thread. Then
+/// only the compression of the baskets, when this tree flushes them, is done in parallel
+/// (see TTree::SetImplicitMT).
+///
 /// If the tree or any of the underlying tree of the chain has an index, that index and any
 /// index in the subsequent underlying TTree objects will be merged.
 ///
@@ -6931,7 +6941,8 @@ Long64_t TTree::Merge(TCollection* li, TFileMergeInfo *info)
          FlushBasketsImpl();
          fDirectory->WriteTObject(this);
       } else if (info->fOptions.Contains("fast")) {
-         InPlaceClone(info->fOutputDirectory);
+         // Of the merge options, only the recompression applies to the in place cloning.
+         InPlaceClone(info->fOutputDirectory, info->fOptions.Contains("recompress") ? "recompress" : "");
       } else {
          TDirectory::TContext ctxt(info->fOutputDirectory);
          TIOFeatures saved_features = fIOFeatures;
@@ -8804,6 +8815,8 @@ Int_t TTree::SetCacheSizeAux(Bool_t autocache /* = kTRUE */, Long64_t cacheSize
       pf = new TTreeCache(this, cacheSize);
 
    pf->SetAutoCreated(autocache);
+   // Prefetch the branches of the configured access profile, if any, from the first entry.
+   pf->LoadProfile();
 
    return 0;
 }
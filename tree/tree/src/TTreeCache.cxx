@@ -20,6 +20,7 @@
 - [General Description](\ref description)
 - [Changes in behaviour](\ref changesbehaviour)
 - [Self-optimization](\ref cachemisses)
+- [Reading ahead](\ref readahead)
 - [Examples of usage](\ref examples)
 - [Check performance and stats](\ref checkPerf)
 
@@ -101,6 +102,7 @@ The learning phase is started or restarted when:
 
 The learning period is stopped (and prefetching is started) when:
    - TTreeCache::StopLearningPhase is called.
+   - TTreeCache::LoadProfile is called.
    - An entry outside the 'learning' range is requested
      The 'learning range is from fEntryMin (default to 0) to
      fEntryMin + fgLearnEntries.
@@ -129,6 +131,41 @@ Additionally, on the first miss of an event, we must iterate through all the
 This can be potentially a CPU-expensive operation compared to, e.g., the
 latency of a SSD.  This is why the miss cache is currently disabled by default.
 
+\anchor readahead
+## Reading the next clusters ahead
+
+The content of the cache is read when the first basket of a new fill is
+requested, such that the event loop waits for the transfer at each fill.
+With SetReadAhead, the baskets of the cached branches in the next clusters are
+read in the background while the current ones are processed, through a separate
+handle on the file (see ROOT::Internal::RRawFile, which uses io_uring when
+available). The next fill then takes its content from these clusters, waiting
+only if they are still being read.
+~~~ {.cpp}
+    T->SetCacheSize(cachesize);
+    T->GetReadCache(f)->SetReadAhead(2); // 2 clusters in flight, at most the size of the cache
+~~~
+The number of clusters can also be set with the environment variable
+`ROOT_TTREECACHE_READAHEAD` or the TTreeCache.ReadAhead option. Reading ahead
+is only done for local files and files accessed via HTTP, opened for reading.
+
+\anchor profile
+## Prefetching the branches of a recorded access profile
+
+The learning phase reads the baskets of its entries branch by branch, and only
+sees the branches used by these entries. When the same job is run again, e.g.
+in production workflows, the branches it reads can be recorded once by a
+TTreePerfStats and saved with TTreePerfStats::SaveProfile. LoadProfile then puts
+exactly these branches in the cache and stops the learning phase, so that the
+first cluster is already prefetched in full:
+~~~ {.cpp}
+    T->SetCacheSize(cachesize);
+    T->GetReadCache(f)->LoadProfile("profile.txt");
+~~~
+The profile can also be given with the environment variable
+`ROOT_TTREECACHE_PROFILE` or the TTreeCache.Profile option, in which case it is
+loaded by each cache created by TTree::SetCacheSize, including the automatic ones.
+
 \anchor examples
 ## Example usages of TTreeCache
 
@@ -285,6 +322,7 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TSystem.h"
 #include "TEnv.h"
 #include "TTreeCache.h"
+#include "TTreeCacheReadAhead.h"
 #include "TChain.h"
 #include "TList.h"
 #include "TBranch.h"
@@ -297,6 +335,7 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TFriendElement.h"
 #include "TFile.h"
 #include "TMath.h"
+#include "TTimeStamp.h"
 #include "TBranchCacheInfo.h"
 #include "TVirtualPerfStats.h"
 #include <limits.h>
@@ -308,7 +347,8 @@ ClassImp(TTreeCache);
 ////////////////////////////////////////////////////////////////////////////////
 /// Default Constructor.
 
-TTreeCache::TTreeCache() : TFileCacheRead(), fPrefillType(GetConfiguredPrefillType())
+TTreeCache::TTreeCache()
+   : TFileCacheRead(), fPrefillType(GetConfiguredPrefillType()), fReadAheadClusters(GetConfiguredReadAhead())
 {
 }
 
@@ -317,7 +357,8 @@ TTreeCache::TTreeCache() : TFileCacheRead(), fPrefillType(GetConfiguredPrefillTy
 
 TTreeCache::TTreeCache(TTree *tree, Int_t buffersize)
    : TFileCacheRead(tree->GetCurrentFile(), buffersize, tree), fEntryMax(tree->GetEntriesFast()), fEntryNext(0),
-     fBrNames(new TList), fTree(tree), fPrefillType(GetConfiguredPrefillType())
+     fBrNames(new TList), fTree(tree), fPrefillType(GetConfiguredPrefillType()),
+     fReadAheadClusters(GetConfiguredReadAhead())
 {
    fEntryNext = fEntryMin + fgLearnEntries;
    Int_t nleaves = tree->GetListOfLeaves()->GetEntriesFast();
@@ -329,6 +370,8 @@ TTreeCache::TTreeCache(TTree *tree, Int_t buffersize)
 
 TTreeCache::~TTreeCache()
 {
+   ResetReadAhead();
+
    // Informe the TFile that we have been deleted (in case
    // we are deleted explicitly by legacy user code).
    if (fFile) fFile->SetCacheRead(0, fTree);
@@ -1789,9 +1832,131 @@ Bool_t TTreeCache::FillBuffer()
       }
    }
    fIsLearning = kFALSE;
+   if (fReadAheadClusters > 0 && !fEnablePrefetching && !fAsyncReading)
+      ReadAhead();
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Take the content of the cache, which FillBuffer just set up, from the clusters
+/// read ahead if they cover it; then start reading the next clusters ahead, up to
+/// fReadAheadClusters clusters and fReadAheadMaxBytes bytes in flight.
+
+void TTreeCache::ReadAhead()
+{
+   if (!fReadAhead) {
+      if (fReadAheadTried)
+         return;
+      fReadAheadTried = kTRUE;
+      fReadAhead = ROOT::Internal::TTreeCacheReadAhead::Create(fFile);
+      if (!fReadAhead)
+         return;
+   }
+
+   if (fNseek > 0 && !fIsSorted) {
+      Bool_t covered = kFALSE;
+      for (Int_t i = 0; i < fNseek && !covered; ++i)
+         covered = fReadAhead->Contains(fSeek[i], fSeekLen[i]);
+      if (covered) {
+         // Copy the baskets that were read ahead and read the others from the file in one go.
+         Sort();
+         std::vector<Long64_t> missPos;
+         std::vector<Int_t> missLen;
+         std::vector<Int_t> missOffset;
+         Int_t missSize = 0;
+         Long64_t readAheadSize = 0;
+         Double_t start = 0;
+         if (gPerfStats)
+            start = TTimeStamp();
+         for (Int_t i = 0; i < fNseek; ++i) {
+            if (fReadAhead->Contains(fSeekSort[i], fSeekSortLen[i]) &&
+                fReadAhead->Read(fBuffer + fSeekPos[i], fSeekSort[i], fSeekSortLen[i])) {
+               fReadAheadBytes += fSeekSortLen[i];
+               fBytesRead += fSeekSortLen[i];
+               readAheadSize += fSeekSortLen[i];
+            } else if (!missPos.empty() && missPos.back() + missLen.back() == fSeekSort[i] &&
+                       missOffset.back() + missLen.back() == fSeekPos[i]) {
+               missLen.back() += fSeekSortLen[i];
+               missSize += fSeekSortLen[i];
+            } else {
+               missPos.push_back(fSeekSort[i]);
+               missLen.push_back(fSeekSortLen[i]);
+               missOffset.push_back(fSeekPos[i]);
+               missSize += fSeekSortLen[i];
+            }
+         }
+         fIsTransferred = kTRUE;
+         if (readAheadSize)
+            fReadAhead->CountRead(fFile, readAheadSize, start);
+         if (!missPos.empty()) {
+            Long64_t fileBytesRead0 = fFile->GetBytesRead();
+            Long64_t fileBytesReadExtra0 = fFile->GetBytesReadExtra();
+            Int_t fileReadCalls0 = fFile->GetReadCalls();
+            std::vector<char> missing(missSize);
+            if (fFile->ReadBuffers(missing.data(), missPos.data(), missLen.data(), missPos.size())) {
+               // The baskets will be read one by one, reporting the error.
+               TFileCacheRead::Prefetch(0, 0);
+            } else {
+               for (std::size_t i = 0, offset = 0; i < missPos.size(); offset += missLen[i], ++i)
+                  memcpy(fBuffer + missOffset[i], missing.data() + offset, missLen[i]);
+            }
+            fBytesRead += fFile->GetBytesRead() - fileBytesRead0;
+            fBytesReadExtra += fFile->GetBytesReadExtra() - fileBytesReadExtra0;
+            fReadCalls += fFile->GetReadCalls() - fileReadCalls0;
+         }
+      }
+   }
+
+   fReadAhead->Drop(fEntryNext);
+   if (fReadAhead->HasFailed())
+      return;
+
+   TTree *tree = ((TBranch *)fBranches->UncheckedAt(0))->GetTree();
+   const Long64_t maxBytes = fReadAheadMaxBytes > 0 ? fReadAheadMaxBytes : fBufferSizeMin;
+   Long64_t next = fReadAhead->IsEmpty() ? fEntryNext : fReadAhead->GetEntryEnd();
+   std::vector<ROOT::Internal::TTreeCacheReadAhead::RBlock> blocks;
+   while (next >= 0 && next < fEntryMax && (Int_t)fReadAhead->GetNRequests() < fReadAheadClusters) {
+      TTree::TClusterIterator clusterIter = tree->GetClusterIterator(next);
+      clusterIter();
+      const Long64_t end = std::min(clusterIter.GetNextEntry(), fEntryMax);
+      if (end <= next)
+         break;
+
+      blocks.clear();
+      Long64_t nbytes = 0;
+      for (Int_t i = 0; i < fNbranches; ++i) {
+         TBranch *b = (TBranch *)fBranches->UncheckedAt(i);
+         if (b->GetDirectory() == 0 || b->TestBit(TBranch::kDoNotProcess))
+            continue;
+         if (b->GetDirectory()->GetFile() != fFile)
+            continue;
+         Int_t nb = b->GetMaxBaskets();
+         Int_t *lbaskets = b->GetBasketBytes();
+         Long64_t *entries = b->GetBasketEntry();
+         if (!lbaskets || !entries)
+            continue;
+         Int_t blistsize = b->GetListOfBaskets()->GetSize();
+         Long64_t j = TMath::BinarySearch(b->GetWriteBasket() + 1, entries, next);
+         for (j = (j < 0) ? 0 : j; j < nb && entries[j] < end; ++j) {
+            if (j < blistsize && b->GetListOfBaskets()->UncheckedAt(j))
+               continue;
+            Long64_t pos = b->GetBasketSeek(j);
+            Int_t len = lbaskets[j];
+            if (pos <= 0 || len <= 0 || len > fBufferSizeMin || fReadAhead->Contains(pos, len))
+               continue;
+            blocks.push_back({pos, len});
+            nbytes += len;
+         }
+      }
+
+      // Always allow one cluster, even if it is larger than the limit.
+      if (!fReadAhead->IsEmpty() && fReadAhead->GetBytesInFlight() + nbytes > maxBytes)
+         break;
+      fReadAhead->Submit(next, end, blocks);
+      next = end;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the desired prefill type from the environment or resource variable
 /// - 0 - No prefill
@@ -1811,6 +1976,38 @@ TTreeCache::EPrefillType TTreeCache::GetConfiguredPrefillType() const
    return static_cast<TTreeCache::EPrefillType>(s);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of clusters to read ahead from the environment or resource
+/// variable (0, the default, disables reading ahead).
+
+Int_t TTreeCache::GetConfiguredReadAhead() const
+{
+   const char *stcp;
+   Int_t s = 0;
+
+   if (!(stcp = gSystem->Getenv("ROOT_TTREECACHE_READAHEAD")) || !*stcp) {
+      s = gEnv->GetValue("TTreeCache.ReadAhead", 0);
+   } else {
+      s = TString(stcp).Atoi();
+   }
+
+   return s > 0 ? s : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the access profile to load from the environment or resource variable
+/// (empty, the default, if none).
+
+TString TTreeCache::GetConfiguredProfile() const
+{
+   const char *stcp;
+
+   if (!(stcp = gSystem->Getenv("ROOT_TTREECACHE_PROFILE")) || !*stcp)
+      stcp = gEnv->GetValue("TTreeCache.Profile", "");
+
+   return stcp;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Give the total efficiency of the primary cache... defined as the ratio
 /// of blocks found in the cache vs. the number of blocks prefetched
@@ -1906,6 +2103,8 @@ void TTreeCache::Print(Option_t *option) const
    printf("Secondary Efficiency ..............: %f\n", GetMissEfficiency());
    printf("Secondary Efficiency Rel ..........: %f\n", GetMissEfficiencyRel());
    printf("Learn entries......................: %d\n",TTreeCache::GetLearnEntries());
+   if (fReadAheadClusters > 0)
+      printf("Read ahead.........................: %d clusters, %lld bytes used\n",fReadAheadClusters,fReadAheadBytes);
    if ( opt.Contains("cachedbranches") ) {
       opt.ReplaceAll("cachedbranches","");
       printf("Cached branches....................:\n");
@@ -2056,6 +2255,9 @@ void TTreeCache::ResetCache()
       fFirstTime = kTRUE;
       TFileCacheRead::SecondPrefetch(0, 0);
    }
+
+   if (fReadAhead)
+      fReadAhead->Clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2127,6 +2329,7 @@ void TTreeCache::SetFile(TFile *file, TFile::ECacheAction action)
    // The infinite recursion is 'broken' by the fact that
    // TFile::SetCacheRead remove the entry from fCacheReadMap _before_
    // calling SetFile (and also by setting fFile to zero before the calling).
+   ResetReadAhead();
    if (fFile) {
       TFile *prevFile = fFile;
       fFile = 0;
@@ -2135,6 +2338,39 @@ void TTreeCache::SetFile(TFile *file, TFile::ECacheAction action)
    TFileCacheRead::SetFile(file, action);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the baskets of the next `nclusters` clusters in the background while the
+/// current ones are processed, keeping at most `maxbytes` bytes (by default the
+/// size of the cache) read ahead. A single cluster larger than that is still read
+/// ahead on its own. Setting `nclusters` to 0 disables reading ahead.
+/// See the [class documentation](\ref readahead).
+
+void TTreeCache::SetReadAhead(Int_t nclusters, Long64_t maxbytes /* = 0 */)
+{
+   fReadAheadClusters = nclusters > 0 ? nclusters : 0;
+   fReadAheadMaxBytes = maxbytes > 0 ? maxbytes : 0;
+   if (!fReadAheadClusters)
+      ResetReadAhead();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of bytes of the cache that were taken from the clusters
+/// read ahead.
+
+Long64_t TTreeCache::GetReadAheadBytes() const
+{
+   return fReadAheadBytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop reading ahead from the current file, waiting for the reads in flight.
+
+void TTreeCache::ResetReadAhead()
+{
+   fReadAhead.reset();
+   fReadAheadTried = kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Static function to set the number of entries to be used in learning mode
 /// The default value for n is 10. n must be >= 1
@@ -2174,6 +2410,60 @@ void TTreeCache::StartLearningPhase()
    fEntryCurrent = -1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add to the cache the branches of the tree recorded in the access profile
+/// `filename`, as saved by TTreePerfStats::SaveProfile, in the order in which
+/// they were read, and stop the learning phase. Without `filename`, the profile
+/// configured with TTreeCache.Profile is loaded, if any.
+/// See the [class documentation](\ref profile).
+/// Returns:
+///  - the number of branches added
+///  - -1 on error
+
+Int_t TTreeCache::LoadProfile(const char *filename /* = nullptr */)
+{
+   TString configured;
+   if (!filename) {
+      configured = GetConfiguredProfile();
+      if (configured.IsNull())
+         return 0;
+      filename = configured.Data();
+   }
+   if (!fTree)
+      return -1;
+
+   TEnv profile;
+   if (profile.ReadFile(filename, kEnvLocal) < 0) {
+      Error("LoadProfile", "cannot read the access profile %s", filename);
+      return -1;
+   }
+   TString key = TString::Format("%s.Branches", fTree->GetName());
+   if (!profile.Defined(key)) {
+      if (configured.IsNull())
+         Warning("LoadProfile", "no access profile for the tree %s in %s", fTree->GetName(), filename);
+      return 0;
+   }
+
+   Int_t nadded = 0;
+   TString branches = profile.GetValue(key, "");
+   TString name;
+   Ssiz_t from = 0;
+   while (branches.Tokenize(name, from, " ")) {
+      TBranch *b = fTree->GetBranch(name);
+      if (!b) {
+         Warning("LoadProfile", "unknown branch %s in the access profile %s", name.Data(), filename);
+         continue;
+      }
+      if (AddBranch(b, kFALSE) == 0)
+         ++nadded;
+   }
+   if (nadded > 0) {
+      fEntryNext = -1; // Fill the cache with the branches of the profile on the next read.
+      StopLearningPhase();
+   }
+   return nadded;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This is the counterpart of StartLearningPhase() and can be used to stop
 /// the learning phase. It's useful when the user knows exactly what branches
@@ -0,0 +1,242 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TTreeCacheReadAhead.h"
+
+#include "ROOT/RRawFile.hxx"
+#include "TError.h"
+#include "TFile.h"
+#include "TUrl.h"
+#include "TVirtualPerfStats.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+ROOT::Internal::TTreeCacheReadAhead::TTreeCacheReadAhead(std::unique_ptr<RRawFile> rawFile)
+   : fRawFile(std::move(rawFile))
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for the requests in flight, which read into buffers owned by this object.
+
+ROOT::Internal::TTreeCacheReadAhead::~TTreeCacheReadAhead()
+{
+   Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a read-ahead for the given file, or nullptr if its content can not be
+/// read through a separate handle (files in memory, in archives, opened for
+/// writing or using a protocol not supported by RRawFile).
+
+std::unique_ptr<ROOT::Internal::TTreeCacheReadAhead> ROOT::Internal::TTreeCacheReadAhead::Create(TFile *file)
+{
+   if (!file || file->IsWritable() || file->GetArchive())
+      return nullptr;
+
+   const TUrl *url = file->GetEndpointUrl();
+   std::string location;
+   if (file->IsA() == TFile::Class() && !strcmp(url->GetProtocol(), "file"))
+      location = url->GetFile();
+   else if (!strcmp(url->GetProtocol(), "http") || !strcmp(url->GetProtocol(), "https"))
+      location = url->GetUrl();
+   else
+      return nullptr;
+
+   try {
+      RRawFile::ROptions options;
+      // The requests are read in one go, buffering them once more is pointless.
+      options.fBlockSize = 0;
+      return std::make_unique<TTreeCacheReadAhead>(RRawFile::Create(location, options));
+   } catch (const std::exception &e) {
+      if (gDebug > 0)
+         ::Info("TTreeCacheReadAhead::Create", "Cannot read ahead %s: %s", location.c_str(), e.what());
+   }
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start reading the given blocks, which hold the baskets of the entries
+/// [entryStart, entryEnd[. The blocks are sorted in place.
+
+void ROOT::Internal::TTreeCacheReadAhead::Submit(Long64_t entryStart, Long64_t entryEnd, std::vector<RBlock> &blocks)
+{
+   if (blocks.empty() || fFailed)
+      return;
+
+   auto request = std::make_unique<RRequest>();
+   request->fEntryStart = entryStart;
+   request->fEntryEnd = entryEnd;
+
+   // Merge the adjacent (or duplicated) blocks, as TFileCacheRead::Sort does.
+   std::sort(blocks.begin(), blocks.end(), [](const RBlock &a, const RBlock &b) { return a.fPos < b.fPos; });
+   for (const auto &block : blocks) {
+      if (!request->fPos.empty() && block.fPos <= request->fPos.back() + request->fLen.back()) {
+         const Long64_t end = std::max(request->fPos.back() + request->fLen.back(), block.fPos + block.fLen);
+         request->fSize += end - (request->fPos.back() + request->fLen.back());
+         request->fLen.back() = end - request->fPos.back();
+         continue;
+      }
+      request->fPos.push_back(block.fPos);
+      request->fLen.push_back(block.fLen);
+      request->fOffset.push_back(request->fSize);
+      request->fSize += block.fLen;
+   }
+   request->fBuffer.reset(new char[request->fSize]);
+
+   std::vector<RRawFile::RIOVec> ioVec(request->fPos.size());
+   for (std::size_t i = 0; i < ioVec.size(); ++i) {
+      ioVec[i].fBuffer = request->fBuffer.get() + request->fOffset[i];
+      ioVec[i].fOffset = request->fPos[i];
+      ioVec[i].fSize = request->fLen[i];
+   }
+
+   auto read = [rawFile = fRawFile.get(), mutex = &fReadMutex, ioVec = std::move(ioVec)]() mutable {
+      std::lock_guard<std::mutex> lock(*mutex);
+      try {
+         rawFile->ReadV(ioVec.data(), ioVec.size());
+      } catch (const std::exception &) {
+         return false;
+      }
+      for (const auto &io : ioVec) {
+         if (io.fOutBytes != io.fSize)
+            return false;
+      }
+      return true;
+   };
+   try {
+      request->fDone = std::async(std::launch::async, std::move(read));
+   } catch (const std::system_error &) {
+      // No thread available, the cache reads the cluster synchronously.
+      return;
+   }
+
+   fBytesInFlight += request->fSize;
+   fRequests.push_back(std::move(request));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for a request to be read; return false if reading it failed.
+
+bool ROOT::Internal::TTreeCacheReadAhead::Wait(RRequest &request)
+{
+   if (!request.fWaited) {
+      request.fOk = request.fDone.get();
+      request.fWaited = true;
+      if (!request.fOk)
+         fFailed = true;
+   }
+   return request.fOk;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find the request and its merged block containing the byte at `pos`.
+
+ROOT::Internal::TTreeCacheReadAhead::RRequest *
+ROOT::Internal::TTreeCacheReadAhead::Find(Long64_t pos, std::size_t &range) const
+{
+   for (auto &request : fRequests) {
+      auto it = std::upper_bound(request->fPos.begin(), request->fPos.end(), pos);
+      if (it == request->fPos.begin())
+         continue;
+      range = std::distance(request->fPos.begin(), it) - 1;
+      if (pos < request->fPos[range] + request->fLen[range])
+         return request.get();
+   }
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the bytes [pos, pos+len[ are covered by the requests.
+
+bool ROOT::Internal::TTreeCacheReadAhead::Contains(Long64_t pos, Int_t len) const
+{
+   const Long64_t end = pos + len;
+   while (pos < end) {
+      std::size_t range = 0;
+      const RRequest *request = Find(pos, range);
+      if (!request)
+         return false;
+      pos = request->fPos[range] + request->fLen[range];
+   }
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the bytes [pos, pos+len[ into `buf`, waiting for the requests covering
+/// them. Return false if they are not covered or could not be read.
+
+bool ROOT::Internal::TTreeCacheReadAhead::Read(char *buf, Long64_t pos, Int_t len)
+{
+   const Long64_t end = pos + len;
+   while (pos < end) {
+      std::size_t range = 0;
+      RRequest *request = Find(pos, range);
+      if (!request || !Wait(*request))
+         return false;
+      const Long64_t n = std::min(end, request->fPos[range] + request->fLen[range]) - pos;
+      memcpy(buf, request->fBuffer.get() + request->fOffset[range] + (pos - request->fPos[range]), n);
+      buf += n;
+      pos += n;
+   }
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Count `len` bytes taken from the requests as one read of `file`, started at
+/// `start`. The requests are read through fRawFile, which the read counters of
+/// the file and gPerfStats do not see.
+
+void ROOT::Internal::TTreeCacheReadAhead::CountRead(TFile *file, Long64_t len, Double_t start)
+{
+   {
+      auto lock = file->LockConcurrentRead();
+      file->fBytesRead += len;
+      file->fReadCalls++;
+   }
+   TFile::fgBytesRead += len;
+   TFile::fgReadCalls++;
+   if (gPerfStats)
+      gPerfStats->FileReadEvent(file, len, start);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Drop the requests that end before `entryNext`, the entry where the cache
+/// will be filled next. If the reading does not continue where the remaining
+/// requests start, drop them all.
+
+void ROOT::Internal::TTreeCacheReadAhead::Drop(Long64_t entryNext)
+{
+   while (!fRequests.empty() && fRequests.front()->fEntryEnd <= entryNext) {
+      auto &request = *fRequests.front();
+      if (!request.fWaited)
+         request.fDone.wait();
+      fBytesInFlight -= request.fSize;
+      fRequests.pop_front();
+   }
+   if (!fRequests.empty() && fRequests.front()->fEntryStart > entryNext)
+      Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Drop all requests, waiting for the ones in flight.
+
+void ROOT::Internal::TTreeCacheReadAhead::Clear()
+{
+   for (auto &request : fRequests) {
+      if (!request->fWaited)
+         request->fDone.wait();
+   }
+   fRequests.clear();
+   fBytesInFlight = 0;
+}
@@ -0,0 +1,97 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeCacheReadAhead
+#define ROOT_TTreeCacheReadAhead
+
+#include "RtypesCore.h"
+
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class TFile;
+
+namespace ROOT {
+namespace Internal {
+
+class RRawFile;
+
+/** \class ROOT::Internal::TTreeCacheReadAhead
+ Reads the baskets of the clusters following the one in a TTreeCache in the background.
+
+Each request covers the baskets of one cluster. It is read with a vectored read on a
+separate RRawFile handle to the file of the cache, such that it does not interfere with
+the reads done through the TFile. Requests are read one at a time, in the order they are
+submitted. The TTreeCache takes the content of its next fill from the requests that cover
+it, waiting for them if they are still in flight.
+*/
+
+class TTreeCacheReadAhead {
+public:
+   /// A block of the file, as given to TFileCacheRead::Prefetch.
+   struct RBlock {
+      Long64_t fPos;
+      Int_t fLen;
+   };
+
+private:
+   struct RRequest {
+      Long64_t fEntryStart = 0;     ///< First entry of the cluster
+      Long64_t fEntryEnd = 0;       ///< Last entry + 1 of the cluster
+      std::vector<Long64_t> fPos;   ///< Sorted position on file of the merged blocks
+      std::vector<Long64_t> fLen;   ///< Length of the merged blocks
+      std::vector<Long64_t> fOffset;///< Position of the merged blocks in fBuffer
+      std::unique_ptr<char[]> fBuffer;
+      Long64_t fSize = 0;           ///< Size of fBuffer
+      std::future<bool> fDone;      ///< Becomes ready when the blocks are read, false on error
+      bool fWaited = false;
+      bool fOk = false;
+   };
+
+   std::unique_ptr<RRawFile> fRawFile; ///< Separate handle to the file being read
+   std::mutex fReadMutex;              ///< Serializes the reads done on fRawFile
+   std::deque<std::unique_ptr<RRequest>> fRequests; ///< Requests, in the order of their entries
+   Long64_t fBytesInFlight = 0;        ///< Summed size of the buffers of fRequests
+   bool fFailed = false;               ///< A read on fRawFile failed
+
+   bool Wait(RRequest &request);
+   RRequest *Find(Long64_t pos, std::size_t &range) const;
+
+public:
+   explicit TTreeCacheReadAhead(std::unique_ptr<RRawFile> rawFile);
+   TTreeCacheReadAhead(const TTreeCacheReadAhead &) = delete;
+   TTreeCacheReadAhead &operator=(const TTreeCacheReadAhead &) = delete;
+   ~TTreeCacheReadAhead();
+
+   static std::unique_ptr<TTreeCacheReadAhead> Create(TFile *file);
+
+   void Submit(Long64_t entryStart, Long64_t entryEnd, std::vector<RBlock> &blocks);
+   bool Contains(Long64_t pos, Int_t len) const;
+   bool Read(char *buf, Long64_t pos, Int_t len);
+   void CountRead(TFile *file, Long64_t len, Double_t start);
+   void Drop(Long64_t entryNext);
+   void Clear();
+
+   /// Return true if the read of a request failed; no request should be submitted anymore.
+   bool HasFailed() const { return fFailed; }
+   bool IsEmpty() const { return fRequests.empty(); }
+   std::size_t GetNRequests() const { return fRequests.size(); }
+   Long64_t GetBytesInFlight() const { return fBytesInFlight; }
+   /// Return the last entry + 1 covered by the requests.
+   Long64_t GetEntryEnd() const { return fRequests.empty() ? -1 : fRequests.back()->fEntryEnd; }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -16,9 +16,17 @@
 
 A TTreeCache which exploits parallelized decompression of its own content.
 
+With implicit multi-threading enabled, the baskets of the cache are unzipped by tasks
+in the order they will be read, i.e. sorted by their first entry. The reader unzips
+itself the basket it needs if no task started it yet, and helps the tasks with the
+next baskets while it waits for one. The summed size of the unzipped baskets not yet
+read is kept below the size set by SetUnzipBufferSize(): the tasks stop when it is
+reached and are restarted once the reader has consumed half of it.
+
 */
 
 #include "TTreeCacheUnzip.h"
+#include "ROOT/TBasketBufferPool.hxx"
 #include "TBranch.h"
 #include "TChain.h"
 #include "TEnv.h"
@@ -33,7 +41,9 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
 extern "C" int R__unzip_header(Int_t *nin, UChar_t *bufin, Int_t *lout);
@@ -129,6 +139,13 @@ void TTreeCacheUnzip::UnzipState::SetFinished(Int_t index) {
    fUnzipStatus[index].store((Byte_t)kFinished);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Give the basket back to the tasks, e.g. when its unzipping was deferred.
+
+void TTreeCacheUnzip::UnzipState::SetUntouched(Int_t index) {
+   fUnzipStatus[index].store((Byte_t)kUntouched);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void TTreeCacheUnzip::UnzipState::SetMissed(Int_t index) {
@@ -163,10 +180,15 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipNext(0),
+   fUnzipBytes(0),
+   fUnzipStalled(kFALSE),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNReaderUnzip(0),
+   fNDeferred(0)
 {
    // Default Constructor.
    Init();
@@ -182,10 +204,15 @@ TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tre
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipNext(0),
+   fUnzipBytes(0),
+   fUnzipStalled(kFALSE),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNReaderUnzip(0),
+   fNDeferred(0)
 {
    Init();
 }
@@ -307,6 +334,7 @@ Bool_t TTreeCacheUnzip::FillBuffer()
 
    //clear cache buffer
    TFileCacheRead::Prefetch(0,0);
+   fSeekEntry.clear();
 
    //store baskets
    for (Int_t i = 0; i < fNbranches; i++) {
@@ -338,10 +366,17 @@ Bool_t TTreeCacheUnzip::FillBuffer()
          fNReadPref++;
 
          TFileCacheRead::Prefetch(pos, len);
+         fSeekEntry.resize(fNseek, entries[j]);
       }
       if (gDebug > 0) printf("Entry: %lld, registering baskets branch %s, fEntryNext=%lld, fNseek=%d, fNtot=%d\n", entry, ((TBranch*)fBranches->UncheckedAt(i))->GetName(), fEntryNext, fNseek, fNtot);
    }
 
+   // The baskets are unzipped in the order of their entries, which is the order they are read
+   fUnzipOrder.resize(fNseek);
+   std::iota(fUnzipOrder.begin(), fUnzipOrder.end(), 0);
+   std::stable_sort(fUnzipOrder.begin(), fUnzipOrder.end(),
+                    [this](Int_t a, Int_t b) { return fSeekEntry[a] < fSeekEntry[b]; });
+
    // Now fix the size of the status arrays
    ResetCache();
    fIsLearning = kFALSE;
@@ -511,9 +546,63 @@ void TTreeCacheUnzip::ResetCache()
       fUnzipState.Reset(fNseekMax, fNseek);
       fNseekMax = fNseek;
    }
+   fUnzipNext = 0;
+   fUnzipBytes = 0;
+   fUnzipStalled = kFALSE;
    fEmpty = kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Account for an unzipped block of len bytes. Returns kFALSE if this would
+/// exceed fUnzipBufferSize while other unzipped blocks are still waiting to be
+/// read. A block is always accepted when none is waiting, such that a block
+/// larger than the budget does not stall the unzipping forever.
+
+Bool_t TTreeCacheUnzip::ReserveUnzipBytes(Int_t len)
+{
+   Long64_t pending = fUnzipBytes.load();
+   do {
+      if (fUnzipBufferSize > 0 && pending > 0 && pending + len > fUnzipBufferSize)
+         return kFALSE;
+   } while (!fUnzipBytes.compare_exchange_weak(pending, pending + len));
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move the position of the next basket to unzip back to next, if it is beyond.
+
+void TTreeCacheUnzip::RewindUnzipOrder(Int_t next)
+{
+   Int_t current = fUnzipNext.load();
+   while (current > next && !fUnzipNext.compare_exchange_weak(current, next)) {
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hand the unzipped block of the basket index to the caller, see GetUnzipBuffer.
+/// Restarts the unzipping tasks if they were stopped and enough of the unzipped
+/// blocks were read.
+
+Int_t TTreeCacheUnzip::TakeUnzipped(Int_t index, char **buf, Bool_t *free)
+{
+   const Int_t len = fUnzipState.fUnzipLen[index];
+   if (!(*buf)) {
+      *buf = fUnzipState.fUnzipChunks[index].release();
+      *free = kTRUE;
+   } else {
+      memcpy(*buf, fUnzipState.fUnzipChunks[index].get(), len);
+      fUnzipState.fUnzipChunks[index].reset();
+      *free = kFALSE;
+   }
+   fUnzipBytes -= len;
+
+#ifdef R__USE_IMT
+   if (fUnzipStalled && fUnzipTaskGroup && fUnzipBytes <= fUnzipBufferSize / 2)
+      CreateTasks();
+#endif
+   return len;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This inflates a basket in the cache.. passing the data to a new
 /// buffer that will only wait there to be read...
@@ -522,6 +611,12 @@ void TTreeCacheUnzip::ResetCache()
 /// in fUnzipStatus to exclusively unzip the basket, we must update
 /// fUnzipStatus after fUnzipChunks and fUnzipLen and make sure fUnzipChunks
 /// and fUnzipLen are ready before main thread fetch the data.
+/// Returns:
+///  - 0 if the basket was unzipped or left to the main thread
+///  - 1 if the cache changed or is learning
+///  - 2 if the unzipping was deferred because fUnzipBufferSize is reached;
+///    the basket is set back as untouched
+///  - -1 on read error
 
 Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
 {
@@ -550,20 +645,22 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
    }
 
    // Prepare a memory buffer of adequate size
-   char* locbuff = 0;
+   Int_t locsize = 0;
    if (rdlen > 16384) {
-      locbuff = new char[rdlen];
+      locsize = rdlen;
    } else if (rdlen * 3 < 16384) {
-      locbuff = new char[rdlen * 2];
+      locsize = rdlen * 2;
    } else {
-      locbuff = new char[16384];
+      locsize = 16384;
    }
+   Int_t loccapacity = 0;
+   char *locbuff = ROOT::Internal::TBasketBufferPool::AcquireMemory(locsize, loccapacity);
 
    readbuf = ReadBufferExt(locbuff, rdoffs, rdlen, loc);
 
    if (readbuf <= 0) {
       fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-      if (locbuff) delete [] locbuff;
+      ROOT::Internal::TBasketBufferPool::ReleaseMemory(locbuff, loccapacity);
       return -1;
    }
 
@@ -579,18 +676,28 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
                    Info("UnzipCache", "Block %d is too big, skipping.", index);
 
            fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-           if (locbuff) delete [] locbuff;
+           ROOT::Internal::TBasketBufferPool::ReleaseMemory(locbuff, loccapacity);
            return 0;
    }
 
+   // Account for the unzipped block right away, such that concurrent tasks see it
+   const Int_t unzippedLen = keylen + objlen;
+   if (!ReserveUnzipBytes(unzippedLen)) {
+      fUnzipState.SetUntouched(index);
+      ROOT::Internal::TBasketBufferPool::ReleaseMemory(locbuff, loccapacity);
+      fNDeferred++;
+      return 2;
+   }
+
    // Unzip it into a new blk
    char *ptr = nullptr;
    Int_t loclen = UnzipBuffer(&ptr, locbuff);
    if ((loclen > 0) && (loclen == objlen + keylen)) {
       if ((myCycle != fCycle) || !fIsTransferred) {
          fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-         if (locbuff) delete [] locbuff;
-         delete [] ptr;
+         ROOT::Internal::TBasketBufferPool::ReleaseMemory(locbuff, loccapacity);
+         ROOT::Internal::TBasketBufferPool::ReleaseMemory(ptr, loclen);
+         fUnzipBytes -= unzippedLen;
          return 1;
       }
       fUnzipState.SetUnzipped(index, ptr, loclen); // Set it as done
@@ -598,58 +705,64 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
    } else {
       fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
       delete [] ptr;
+      fUnzipBytes -= unzippedLen;
    }
 
-   if (locbuff) delete [] locbuff;
+   ROOT::Internal::TBasketBufferPool::ReleaseMemory(locbuff, loccapacity);
    return 0;
 }
 
 #ifdef R__USE_IMT
 ////////////////////////////////////////////////////////////////////////////////
-/// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
-/// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping
-/// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// Start the tasks unzipping the baskets of the cache. Each task takes the next
+/// basket in the order they are read (fUnzipOrder) until all are taken, or until
+/// fUnzipBufferSize is reached. In the latter case the tasks stop and are created
+/// again by TakeUnzipped once the reader has consumed half of the unzipped blocks.
+/// One task is run per fUnzipGroupSize bytes of zipped baskets, up to the number
+/// of threads of the pool.
 
 Int_t TTreeCacheUnzip::CreateTasks()
 {
-   auto mapFunction = [&]() {
-      auto unzipFunction = [&](const std::vector<Int_t> &indices) {
-         // If cache is invalidated and we should return immediately.
-         if (!fIsTransferred) return nullptr;
-
-         for (auto ii : indices) {
-            if(fUnzipState.TryUnzipping(ii)) {
-               Int_t res = UnzipCache(ii);
-               if(res)
-                  if (gDebug > 0)
-                     Info("UnzipCache", "Unzipping failed or cache is in learning state");
-            }
-         }
-         return nullptr;
-      };
-
-      Int_t accusz = 0;
-      std::vector<std::vector<Int_t>> basketIndices;
-      std::vector<Int_t> indices;
-      if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
-      for (Int_t i = 0; i < fNseek; i++) {
-         while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
-            i++;
-            if (i >= fNseek) break;
+   // The baskets were not registered by FillBuffer, unzip them in the order of the file cache
+   if (fUnzipOrder.size() != (size_t)fNseek) {
+      fUnzipOrder.resize(fNseek);
+      std::iota(fUnzipOrder.begin(), fUnzipOrder.end(), 0);
+   }
+
+   if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
+   Long64_t accusz = 0;
+   for (Int_t i = 0; i < fNseek; i++)
+      accusz += fSeekLen[i];
+   const Int_t ntasks =
+      (Int_t)std::max<Long64_t>(1, std::min<Long64_t>(accusz / fUnzipGroupSize, ROOT::GetThreadPoolSize()));
+
+   auto unzipFunction = [this]() {
+      // If cache is invalidated and we should return immediately.
+      while (fIsTransferred) {
+         const Int_t next = fUnzipNext++;
+         if (next >= (Int_t)fUnzipOrder.size())
+            break;
+         const Int_t index = fUnzipOrder[next];
+         if (index >= fNseek || !fUnzipState.TryUnzipping(index))
+            continue;
+         Int_t res = UnzipCache(index);
+         if (res == 2) {
+            // Let the next task pick up this basket again
+            RewindUnzipOrder(next);
+            fUnzipStalled = kTRUE;
+            break;
          }
-         if (i < fNseek) i--;
-         basketIndices.push_back(indices);
-         indices.clear();
-         accusz = 0;
+         if (res)
+            if (gDebug > 0)
+               Info("UnzipCache", "Unzipping failed or cache is in learning state");
       }
-      ROOT::TThreadExecutor pool;
-      pool.Foreach(unzipFunction, basketIndices);
    };
 
-   fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
-   fUnzipTaskGroup->Run(mapFunction);
+   fUnzipStalled = kFALSE;
+   if (!fUnzipTaskGroup)
+      fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
+   for (Int_t i = 0; i < ntasks; i++)
+      fUnzipTaskGroup->Run(unzipFunction);
 
    return 0;
 }
@@ -669,6 +782,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
 {
    Int_t res = 0;
    Int_t loc = -1;
+   Bool_t inCache = kFALSE;
 
    // We go straight to TTreeCache/TfileCacheRead, in order to get the info we need
    //  pointer to the original zipped chunk
@@ -698,44 +812,35 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
          // In order to get its info
          Int_t seekidx = fSeekIndex[loc];
 
-         do {
-
-            // If the block is ready we get it immediately.
-            // And also we don't have to alloc the blks. This is supposed to be
-            // the main thread of the app.
-            if (fUnzipState.IsUnzipped(seekidx)) {
-               if(!(*buf)) {
-                  *buf = fUnzipState.fUnzipChunks[seekidx].get();
-                  fUnzipState.fUnzipChunks[seekidx].release();
-                  *free = kTRUE;
-               } else {
-                  memcpy(*buf, fUnzipState.fUnzipChunks[seekidx].get(), fUnzipState.fUnzipLen[seekidx]);
-                  fUnzipState.fUnzipChunks[seekidx].reset();
-                  *free = kFALSE;
-               }
-
-               fNFound++;
-               return fUnzipState.fUnzipLen[seekidx];
-            }
-
-            // If the requested basket is being unzipped by a background task, we try to steal a blk to unzip.
-            Int_t reqi = -1;
+         // If the block is ready we get it immediately.
+         // And also we don't have to alloc the blks. This is supposed to be
+         // the main thread of the app.
+         if (fUnzipState.IsUnzipped(seekidx)) {
+            fNFound++;
+            return TakeUnzipped(seekidx, buf, free);
+         }
 
-            if (fUnzipState.IsProgress(seekidx)) {
+         // If no task started this basket, we unzip it ourselves right now rather than
+         // waiting for a task to reach it.
+         if (!fUnzipState.TryUnzipping(seekidx)) {
+            while (fUnzipState.IsProgress(seekidx)) {
+               // The requested basket is being unzipped by a background task, we try to steal
+               // the next one to be read.
                if (fEmpty) {
-                  for (Int_t ii = 0; ii < fNseek; ++ii) {
-                     Int_t idx = (seekidx + 1 + ii) % fNseek;
-                     if (fUnzipState.IsUntouched(idx)) {
-                        if(fUnzipState.TryUnzipping(idx)) {
-                           reqi = idx;
-                           break;
-                        }
+                  Int_t reqi = -1;
+                  Int_t next = 0;
+                  while ((next = fUnzipNext++) < (Int_t)fUnzipOrder.size()) {
+                     Int_t idx = fUnzipOrder[next];
+                     if (idx < fNseek && fUnzipState.TryUnzipping(idx)) {
+                        reqi = idx;
+                        break;
                      }
                   }
                   if (reqi < 0) {
                      fEmpty = kFALSE;
-                  } else {
-                     UnzipCache(reqi);
+                  } else if (UnzipCache(reqi) == 2) {
+                     RewindUnzipOrder(next);
+                     fEmpty = kFALSE;
                   }
                }
 
@@ -749,26 +854,17 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                }
             }
 
-         } while (fUnzipState.IsProgress(seekidx));
-
-         // Here the block is not pending. It could be done or aborted or not yet being processed.
-         if ( (seekidx >= 0) && (fUnzipState.IsUnzipped(seekidx)) ) {
-            if(!(*buf)) {
-              *buf = fUnzipState.fUnzipChunks[seekidx].get();
-               fUnzipState.fUnzipChunks[seekidx].release();
-               *free = kTRUE;
-            } else {
-               memcpy(*buf, fUnzipState.fUnzipChunks[seekidx].get(), fUnzipState.fUnzipLen[seekidx]);
-               fUnzipState.fUnzipChunks[seekidx].reset();
-               *free = kFALSE;
+            // Here the block is not pending. It could be done or aborted.
+            if ( (seekidx >= 0) && (fUnzipState.IsUnzipped(seekidx)) ) {
+               fNStalls++;
+               return TakeUnzipped(seekidx, buf, free);
             }
-
-            fNStalls++;
-            return fUnzipState.fUnzipLen[seekidx];
-         } else {
-            // This is a complete miss. We want to avoid the background tasks
-            // to try unzipping this block in the future.
+         }
+         // No task unzipped this block, we do it here. We want to avoid the background
+         // tasks to try unzipping this block in the future.
+         if (seekidx >= 0) {
             fUnzipState.SetMissed(seekidx);
+            inCache = kTRUE;
          }
       } else {
          loc = -1;
@@ -818,7 +914,10 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
    }
 
    if (!fIsLearning) {
-      fNMissed++;
+      if (inCache)
+         fNReaderUnzip++;
+      else
+         fNMissed++;
    }
 
    return res;
@@ -870,7 +969,8 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
          return uzlen;
       }
       Int_t l = keylen + objlen;
-      *dest = new char[l];
+      Int_t capacity = 0;
+      *dest = ROOT::Internal::TBasketBufferPool::AcquireMemory(l, capacity);
       alloc = kTRUE;
    }
    // Must unzip the buffer
@@ -951,7 +1051,9 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
    printf("Number of blocks unzipped by threads: %d\n", fNUnzip);
    printf("Number of hits: %d\n", fNFound);
    printf("Number of stalls: %d\n", fNStalls);
+   printf("Number of blocks unzipped by the reader: %d\n", fNReaderUnzip);
    printf("Number of misses: %d\n", fNMissed);
+   printf("Number of deferred unzips: %d\n", fNDeferred.load());
 
    TTreeCache::Print(option);
 }
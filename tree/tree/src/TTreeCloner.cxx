@@ -34,9 +34,37 @@ Class implementing or helping  the various TTree cloning method
 #include "TLeafC.h"
 #include "TFileCacheRead.h"
 #include "TTreeCache.h"
+#include "TROOT.h"
 #include "snprintf.h"
 
 #include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the compression settings the baskets of the branch are written with,
+/// resolving the inherited level and algorithm as TBasket::WriteBuffer does.
+/// All the uncompressed settings are returned as 0.
+
+Int_t GetBasketCompressionSettings(const TBranch *branch, TFile *file)
+{
+   Int_t level = branch->GetCompressionLevel();
+   if (level == ROOT::RCompressionSetting::ELevel::kInherit)
+      level = file ? file->GetCompressionLevel() : 0;
+   Int_t algorithm = branch->GetCompressionAlgorithm();
+   if (algorithm == ROOT::RCompressionSetting::EAlgorithm::kInherit)
+      algorithm = file ? file->GetCompressionAlgorithm() : 0;
+   return level > 0 ? 100 * algorithm + level : 0;
+}
+
+} // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -100,6 +128,11 @@ Bool_t TTreeCloner::CompareEntry::operator()(UInt_t i1, UInt_t i2)
 /// This means that on the file the baskets will be in the order
 /// in which they will be needed when reading the whole tree
 /// sequentially.
+///
+/// If method also contains "recompress", the baskets whose compression
+/// settings differ from the ones of the output branches (or of the output
+/// file for the in place cloning) are decompressed and compressed again
+/// with the output settings. See TTreeCloner::WriteRecompressedBaskets.
 
 TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t options) :
    TTreeCloner(from, to, to ? to->GetDirectory() : nullptr, method, options)
@@ -128,6 +161,7 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, TDirectory *newdirectory, Optio
    fWarningMsg(),
    fIsValid(kTRUE),
    fNeedConversion(kFALSE),
+   fRecompress(kFALSE),
    fOptions(options),
    fFromTree(from),
    fToTree(to),
@@ -161,6 +195,7 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, TDirectory *newdirectory, Optio
       //::Info("TTreeCloner::TTreeCloner","use: kSortBasketsByOffset");
       fCloneMethod = TTreeCloner::kSortBasketsByOffset;
    }
+   fRecompress = opt.Contains("recompress");
    if (fToTree) fToStartEntries = fToTree->GetEntries();
 
    if (fFromTree == nullptr) {
@@ -724,6 +759,10 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
 
 void TTreeCloner::WriteBaskets()
 {
+   if (fRecompress) {
+      WriteRecompressedBaskets();
+      return;
+   }
    TBasket *basket = new TBasket();
    for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
@@ -776,3 +815,121 @@ void TTreeCloner::WriteBaskets()
    }
    delete basket;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transfer the baskets from the input file to the output file, compressing
+/// again the ones whose compression settings differ from the ones of the output
+/// branches.
+///
+/// The baskets are processed in batches bounded by their uncompressed size: the
+/// baskets of a batch are read in order, compressed concurrently (with one task
+/// per basket when the implicit multi-threading is enabled) and then written in
+/// order, such that the layout of the output file is the same as without
+/// recompression.
+
+void TTreeCloner::WriteRecompressedBaskets()
+{
+   // Bound on the summed uncompressed size of the baskets of a batch.
+   constexpr Long64_t kMaxBatchBytes = 32 * 1024 * 1024;
+
+   // Record the settings the input baskets were written with before the in place
+   // cloning switches the branches to the settings of the output file.
+   const Int_t nbranches = fFromBranches.GetEntriesFast();
+   std::vector<Int_t> fromSettings(nbranches);
+   for (Int_t i = 0; i < nbranches; ++i) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt(i);
+      fromSettings[i] = GetBasketCompressionSettings(from, from->GetFile(0));
+      if (IsInPlace())
+         from->fCompress = fToFile->GetCompressionSettings();
+   }
+
+   std::vector<std::unique_ptr<TBasket>> baskets;
+   std::vector<UInt_t> batch;     // Index in fBasketIndex of the baskets of the batch
+   std::vector<Int_t> settings;   // Settings to compress the baskets with, -1 to copy them as is
+   Long64_t batchBytes = 0;
+
+   auto writeBatch = [&]() {
+      const UInt_t n = batch.size();
+      auto recompress = [&](UInt_t i) {
+         if (settings[i] >= 0) {
+            // In case of failure, the basket is copied as is.
+            baskets[i]->Recompress(settings[i] % 100, settings[i] / 100);
+         }
+      };
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled() && n > 1) {
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(recompress, ROOT::TSeqU(n));
+      } else
+#endif
+      {
+         for (UInt_t i = 0; i < n; ++i)
+            recompress(i);
+      }
+
+      for (UInt_t i = 0; i < n; ++i) {
+         const UInt_t j = batch[i];
+         TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+         TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+         Int_t index = fBasketNum[ fBasketIndex[j] ];
+         TBasket *basket = baskets[i].get();
+
+         basket->CopyTo(fToFile);
+         if (IsInPlace()) {
+            Int_t delta = basket->GetNbytes() - to->fBasketBytes[index];
+            to->fBasketSeek[index] = basket->GetSeekKey();
+            to->fBasketBytes[index] = basket->GetNbytes();
+            to->fZipBytes += delta;
+            fToTree->AddZipBytes(delta);
+         } else {
+            to->AddBasket(*basket,kTRUE,fToStartEntries + from->GetBasketEntry()[index]);
+         }
+      }
+      batch.clear();
+      settings.clear();
+      batchBytes = 0;
+   };
+
+   for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+      TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
+
+      TFile *fromfile = from->GetFile(0);
+
+      Int_t index = fBasketNum[ fBasketIndex[j] ];
+
+      Long64_t pos = from->GetBasketSeek(index);
+      if (pos != 0) {
+         if (fFileCache && j >= notCached) {
+            notCached = FillCache(notCached);
+         }
+         if (batch.size() == baskets.size())
+            baskets.emplace_back(new TBasket());
+         TBasket *basket = baskets[batch.size()].get();
+         if (from->GetBasketBytes()[index] == 0) {
+            from->GetBasketBytes()[index] = basket->ReadBasketBytes(pos, fromfile);
+         }
+         Int_t len = from->GetBasketBytes()[index];
+
+         basket->LoadBasketBuffers(pos,len,fromfile,fFromTree);
+         basket->IncrementPidOffset(fPidOffset);
+
+         const Int_t tosettings = GetBasketCompressionSettings(to, fToFile);
+         batch.push_back(j);
+         settings.push_back(tosettings != fromSettings[ fBasketBranchNum[ fBasketIndex[j] ] ] ? tosettings : -1);
+         batchBytes += basket->GetKeylen() + basket->GetObjlen();
+         if (batchBytes >= kMaxBatchBytes)
+            writeBatch();
+      } else if (!IsInPlace()) {
+         writeBatch();
+         TBasket *frombasket = from->GetBasket( index );
+         if (frombasket && frombasket->GetNevBuf()>0) {
+            TBasket *tobasket = (TBasket*)frombasket->Clone();
+            tobasket->SetBranch(to);
+            to->AddBasket(*tobasket, kFALSE, fToStartEntries+from->GetBasketEntry()[index]);
+            to->FlushOneBasket(to->GetWriteBasket());
+         }
+      }
+   }
+   writeBatch();
+}
@@ -1,3 +1,4 @@
+#include "TChain.h"
 #include "TFile.h"
 #include "TROOT.h"
 #include "TSystem.h"
@@ -28,4 +29,33 @@ TEST(TTreeImplicitMT, flushBaskets)
    gSystem->Unlink(ofileName);
 }
 
+TEST(TTreeImplicitMT, ChainGetEntries)
+{
+   const std::vector<std::string> fileNames{"chainGetEntriesMT_0.root", "chainGetEntriesMT_1.root",
+                                            "chainGetEntriesMT_2.root"};
+   for (auto i = 0u; i < fileNames.size(); ++i) {
+      TFile f(fileNames[i].c_str(), "RECREATE");
+      TTree t("t", "t");
+      int x = 0;
+      t.Branch("x", &x);
+      for (auto e = 0u; e < 10 * (i + 1); ++e)
+         t.Fill();
+      t.Write();
+   }
+
+   ROOT::EnableImplicitMT(2);
+   TChain c("t");
+   for (const auto &fileName : fileNames)
+      c.Add(fileName.c_str());
+   EXPECT_EQ(c.GetEntries(), 60);
+   EXPECT_EQ(c.GetTreeOffset()[1], 10);
+   EXPECT_EQ(c.GetTreeOffset()[2], 30);
+   EXPECT_EQ(c.LoadTree(35), 5); // third file
+   EXPECT_EQ(c.GetTreeNumber(), 2);
+   ROOT::DisableImplicitMT();
+
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
+
 #endif // R__USE_IMT
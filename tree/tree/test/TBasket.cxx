@@ -1,7 +1,9 @@
 
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "TBasket.h"
 #include "TBranch.h"
+#include "TBufferFile.h"
 #include "TEnum.h"
 #include "TEnumConstant.h"
 #include "TMemFile.h"
@@ -10,6 +12,7 @@
 #include "ROOT/TestSupport.hxx"
 #include "gtest/gtest.h"
 
+#include <thread>
 #include <vector>
 
 static const Int_t gSampleEvents = 100;
@@ -411,3 +414,73 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+TEST(TBasket, BufferPool)
+{
+   using ROOT::Internal::TBasketBufferPool;
+
+   TBuffer *buffer = TBasketBufferPool::Acquire(1000);
+   ASSERT_NE(buffer, nullptr);
+   EXPECT_TRUE(buffer->IsReading());
+   EXPECT_GE(buffer->BufferSize(), 1000);
+   TBasketBufferPool::Release(buffer);
+
+   // A buffer released by this thread is handed out again.
+   const auto nReused = TBasketBufferPool::GetNReused();
+   buffer = TBasketBufferPool::Acquire(900);
+   ASSERT_NE(buffer, nullptr);
+   EXPECT_EQ(TBasketBufferPool::GetNReused(), nReused + 1);
+   EXPECT_TRUE(buffer->IsReading());
+   EXPECT_GE(buffer->BufferSize(), 900);
+   EXPECT_EQ(buffer->Length(), 0);
+   TBasketBufferPool::Release(buffer);
+
+   Int_t capacity = 0;
+   char *memory = TBasketBufferPool::AcquireMemory(1000, capacity);
+   EXPECT_EQ(TBasketBufferPool::GetNReused(), nReused + 2);
+   EXPECT_GE(capacity, 1000);
+   TBasketBufferPool::ReleaseMemory(memory, capacity);
+
+   // Sizes are rounded up to a multiple of a quarter of their power of two.
+   std::thread([] {
+      TBuffer *b = TBasketBufferPool::Acquire(66048);
+      EXPECT_EQ(b->BufferSize(), 65536 + 16384);
+      delete b;
+   }).join();
+
+   // Buffers in write mode are not pooled.
+   const auto pooledBytes = TBasketBufferPool::GetPooledBytes();
+   TBasketBufferPool::Release(new TBufferFile(TBuffer::kWrite, 1000));
+   EXPECT_EQ(TBasketBufferPool::GetPooledBytes(), pooledBytes);
+
+   // The bound applies to the buffers kept by all threads.
+   const auto maxPooledBytes = TBasketBufferPool::GetMaxPooledBytes();
+   TBasketBufferPool::SetMaxPooledBytes(pooledBytes + 100000);
+   std::thread([] { TBasketBufferPool::Release(TBasketBufferPool::Acquire(90000)); }).join();
+   EXPECT_EQ(TBasketBufferPool::GetPooledBytes(), pooledBytes);
+   std::thread t([&] {
+      TBuffer *b1 = TBasketBufferPool::Acquire(60000);
+      TBuffer *b2 = TBasketBufferPool::Acquire(60000);
+      TBasketBufferPool::Release(b1);
+      TBasketBufferPool::Release(b2);
+      // only the first one fits
+      EXPECT_EQ(TBasketBufferPool::GetPooledBytes(), pooledBytes + 65536);
+   });
+   t.join();
+
+   // Buffers are not kept when pooling is disabled.
+   TBasketBufferPool::SetMaxPooledBytes(0);
+   const auto nReusedBefore = TBasketBufferPool::GetNReused();
+   TBasketBufferPool::Release(TBasketBufferPool::Acquire(100000));
+   TBasketBufferPool::Release(TBasketBufferPool::Acquire(100000));
+   EXPECT_EQ(TBasketBufferPool::GetNReused(), nReusedBefore);
+   TBasketBufferPool::SetMaxPooledBytes(maxPooledBytes);
+
+   // Reading a tree twice with pooled buffers gives the same content.
+   TMemFile *f;
+   CreateSampleFile(f);
+   VerifySampleFile(f);
+   VerifySampleFile(f);
+   f->Close();
+   delete f;
+}
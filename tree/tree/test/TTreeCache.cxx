@@ -0,0 +1,156 @@
+#include "TEnv.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+#include "TTreeCacheUnzip.h"
+
+#include "gtest/gtest.h"
+
+// A file with a tree of many clusters
+class TTreeCacheTest : public ::testing::Test {
+protected:
+   static constexpr const char *fFileName = "TTreeCacheTest.root";
+   static constexpr Long64_t fNEntries = 50000;
+
+   void SetUp() override
+   {
+      TFile file(fFileName, "RECREATE");
+      TTree tree("tree", "A tree with many clusters");
+      tree.SetAutoFlush(1000);
+      Long64_t x = 0;
+      Double_t y = 0;
+      tree.Branch("x", &x);
+      tree.Branch("y", &y);
+      for (x = 0; x < fNEntries; ++x) {
+         y = 0.5 * x;
+         tree.Fill();
+      }
+      file.Write();
+   }
+
+   void TearDown() override { gSystem->Unlink(fFileName); }
+};
+
+TEST_F(TTreeCacheTest, ReadAheadSameContent)
+{
+   TFile file(fFileName);
+   auto tree = file.Get<TTree>("tree");
+   ASSERT_NE(tree, nullptr);
+   tree->SetCacheSize(100000);
+   tree->AddBranchToCache("*", kTRUE);
+   tree->StopCacheLearningPhase();
+   auto cache = dynamic_cast<TTreeCache *>(tree->GetReadCache(&file));
+   ASSERT_NE(cache, nullptr);
+   cache->SetReadAhead(2);
+   EXPECT_EQ(cache->GetReadAheadClusters(), 2);
+   const Long64_t fileBytesRead0 = file.GetBytesRead();
+   const Long64_t allBytesRead0 = TFile::GetFileBytesRead();
+
+   Long64_t x = -1;
+   Double_t y = -1;
+   tree->SetBranchAddress("x", &x);
+   tree->SetBranchAddress("y", &y);
+   for (Long64_t i = 0; i < fNEntries; ++i) {
+      tree->GetEntry(i);
+      ASSERT_EQ(x, i);
+      ASSERT_EQ(y, 0.5 * i);
+   }
+
+   EXPECT_GT(cache->GetReadAheadBytes(), 0);
+   EXPECT_LE(cache->GetReadAheadBytes(), cache->GetBytesRead());
+   // The bytes read ahead through a separate handle are counted as read from the file.
+   EXPECT_GE(file.GetBytesRead() - fileBytesRead0, cache->GetBytesRead());
+   EXPECT_GE(TFile::GetFileBytesRead() - allBytesRead0, cache->GetBytesRead());
+}
+
+TEST_F(TTreeCacheTest, ReadAheadDisabled)
+{
+   TFile file(fFileName);
+   auto tree = file.Get<TTree>("tree");
+   ASSERT_NE(tree, nullptr);
+   tree->SetCacheSize(100000);
+   auto cache = dynamic_cast<TTreeCache *>(tree->GetReadCache(&file));
+   ASSERT_NE(cache, nullptr);
+   cache->SetReadAhead(0);
+
+   for (Long64_t i = 0; i < fNEntries; ++i)
+      tree->GetEntry(i);
+
+   EXPECT_EQ(cache->GetReadAheadBytes(), 0);
+}
+
+TEST_F(TTreeCacheTest, UnzipWithinBudget)
+{
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   {
+      TFile file(fFileName);
+      auto tree = file.Get<TTree>("tree");
+      ASSERT_NE(tree, nullptr);
+      tree->SetCacheSize(100000);
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(tree->GetReadCache(&file));
+      ASSERT_NE(cache, nullptr);
+      // Smaller than the unzipped baskets of a cluster, such that the unzipping is deferred
+      cache->SetUnzipBufferSize(4000);
+
+      Long64_t x = -1;
+      Double_t y = -1;
+      tree->SetBranchAddress("x", &x);
+      tree->SetBranchAddress("y", &y);
+      for (Long64_t i = 0; i < fNEntries; ++i) {
+         tree->GetEntry(i);
+         ASSERT_EQ(x, i);
+         ASSERT_EQ(y, 0.5 * i);
+      }
+
+      // All baskets are in the cache: those not unzipped by the tasks are unzipped by the reader, not missed.
+      EXPECT_EQ(cache->GetNMissed(), 0);
+      EXPECT_GT(cache->GetNUnzip() + cache->GetNReaderUnzip(), 0);
+#ifdef R__USE_IMT
+      EXPECT_GT(cache->GetNDeferred(), 0);
+#endif
+   }
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+}
+
+TEST_F(TTreeCacheTest, LoadProfile)
+{
+   const auto profileName = "TTreeCacheProfile.txt";
+   {
+      // As written by TTreePerfStats::SaveProfile
+      TEnv profile;
+      profile.SetValue("tree.Branches", "y");
+      ASSERT_EQ(profile.WriteFile(profileName, kEnvAll), 0);
+   }
+
+   TFile file(fFileName);
+   auto tree = file.Get<TTree>("tree");
+   ASSERT_NE(tree, nullptr);
+   tree->SetCacheSize(100000);
+   auto cache = dynamic_cast<TTreeCache *>(tree->GetReadCache(&file));
+   ASSERT_NE(cache, nullptr);
+   EXPECT_EQ(cache->LoadProfile(profileName), 1);
+   EXPECT_FALSE(cache->IsLearning());
+   ASSERT_EQ(cache->GetCachedBranches()->GetEntries(), 1);
+   EXPECT_EQ(cache->GetCachedBranches()->At(0), tree->GetBranch("y"));
+
+   // The first cluster is already read with the branches of the profile only.
+   Double_t y = -1;
+   tree->SetBranchStatus("*", false);
+   tree->SetBranchStatus("y", true);
+   tree->SetBranchAddress("y", &y);
+   for (Long64_t i = 0; i < fNEntries; ++i) {
+      tree->GetEntry(i);
+      ASSERT_EQ(y, 0.5 * i);
+   }
+   EXPECT_EQ(cache->GetCachedBranches()->GetEntries(), 1);
+
+   gSystem->Unlink(profileName);
+}
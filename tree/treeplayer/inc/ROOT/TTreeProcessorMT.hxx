@@ -91,6 +91,8 @@ private:
 
    std::vector<std::string> FindTreeNames();
    static unsigned int fgTasksPerWorkerHint;
+   static bool fgDynamicScheduling;
+   static std::string fgMetadataCacheFile;
 
    std::pair<Long64_t, Long64_t> fGlobalRange{0, std::numeric_limits<Long64_t>::max()};
 
@@ -111,6 +113,10 @@ public:
 
    static void SetTasksPerWorkerHint(unsigned int m);
    static unsigned int GetTasksPerWorkerHint();
+   static void SetDynamicScheduling(bool enable);
+   static bool IsDynamicSchedulingEnabled();
+   static void SetMetadataCacheFile(std::string_view fileName);
+   static const std::string &GetMetadataCacheFile();
 };
 
 } // End of namespace ROOT
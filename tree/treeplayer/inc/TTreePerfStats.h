@@ -25,6 +25,7 @@
 #include "TString.h"
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 class TBrowser;
 class TFile;
@@ -62,6 +63,10 @@ protected:
    Long64_t      fUnzipInputSize;///<  Compressed bytes seen by the decompressor.
    Long64_t      fUnzipObjSize;  ///<  Uncompressed bytes produced by the decompressor.
    Double_t      fCompress;      ///<  Tree compression factor
+   Long64_t      fBufferPoolAcquired;   ///<  Number of basket buffers acquired by all threads during the measurement (see ROOT::Internal::TBasketBufferPool)
+   Long64_t      fBufferPoolReused;     ///<  Number of these buffers that were reused from the pool
+   Long64_t      fBufferPoolAcquiredStart; ///<! Number of basket buffers acquired before the measurement
+   Long64_t      fBufferPoolReusedStart;   ///<! Number of basket buffers reused before the measurement
    TString       fName;          ///<  Name of this TTreePerfStats
    TString       fHostInfo;      ///<  Name of the host system, ROOT version and date
    TFile        *fFile;          ///<! Pointer to the file containing the Tree
@@ -75,6 +80,8 @@ protected:
 
    std::unordered_map<TBranch*, size_t>  fBranchIndexCache; // Cache the index of the branch in the cache's array.
    std::vector<std::vector<BasketInfo> > fBasketsInfo;      // Details on which baskets was used, cached, 'miss-cached' or read uncached.Browse
+   std::vector<TString>          fBranchesRead;  ///<  Names of the branches read, in the order of their first read
+   std::unordered_set<TBranch *> fBranchesSeen;  ///<! Branches already recorded in fBranchesRead
 
    BasketInfo &GetBasketInfo(TBranch *b, size_t basketNumber);
    BasketInfo &GetBasketInfo(size_t bi, size_t basketNumber);
@@ -94,12 +101,15 @@ public:
    virtual void     Finish();
    Long64_t GetBytesRead() const override {return fBytesRead;}
    virtual Long64_t GetBytesReadExtra() const {return fBytesReadExtra;}
+   virtual Long64_t GetBufferPoolAcquired() const {return fBufferPoolAcquired;}
+   virtual Long64_t GetBufferPoolReused() const {return fBufferPoolReused;}
    virtual Double_t GetCpuTime()   const {return fCpuTime;}
    virtual Double_t GetDiskTime()  const {return fDiskTime;}
    TGraphErrors    *GetGraphIO()     {return fGraphIO;}
    TGraphErrors    *GetGraphTime()   {return fGraphTime;}
    const char      *GetHostInfo() const{return fHostInfo.Data();}
    const char      *GetName()    const override{return fName.Data();}
+   const std::vector<TString> &GetBranchesRead() const {return fBranchesRead;}
    virtual Int_t    GetNleaves() const {return fNleaves;}
    Long64_t GetNumEvents() const override {return 0;}
    TPaveText       *GetPave()      {return fPave;}
@@ -122,9 +132,12 @@ public:
    void     RateEvent(Double_t , Double_t , Long64_t , Long64_t) override {}
 
    void     SaveAs(const char *filename="",Option_t *option="") const override;
+   Int_t    SaveProfile(const char *filename) const;
    void     SavePrimitive(std::ostream &out, Option_t *option = "") override;
    void     SetBytesRead(Long64_t nbytes) override {fBytesRead = nbytes;}
    virtual void     SetBytesReadExtra(Long64_t nbytes) {fBytesReadExtra = nbytes;}
+   virtual void     SetBufferPoolAcquired(Long64_t n) {fBufferPoolAcquired = n;}
+   virtual void     SetBufferPoolReused(Long64_t n) {fBufferPoolReused = n;}
    virtual void     SetCompress(Double_t cx) {fCompress = cx;}
    virtual void     SetDiskTime(Double_t t) {fDiskTime = t;}
    void     SetNumEvents(Long64_t) override {}
@@ -148,13 +161,13 @@ public:
    void     SetLoadedMiss(size_t bi, size_t basketNumber) override { ++GetBasketInfo(bi, basketNumber).fLoadedMiss; }
    void     SetMissed(TBranch *b, size_t basketNumber) override { ++GetBasketInfo(b, basketNumber).fMissed; }
    void     SetMissed(size_t bi, size_t basketNumber) override { ++GetBasketInfo(bi, basketNumber).fMissed; }
-   void     SetUsed(TBranch *b, size_t basketNumber) override { ++GetBasketInfo(b, basketNumber).fUsed; }
+   void     SetUsed(TBranch *b, size_t basketNumber) override;
    void     SetUsed(size_t bi, size_t basketNumber) override { ++GetBasketInfo(bi, basketNumber).fUsed; }
    void     UpdateBranchIndices(TObjArray *branchNames) override;
 
    BasketList_t     GetDuplicateBasketCache() const;
 
-   ClassDefOverride(TTreePerfStats, 8) // TTree I/O performance measurement
+   ClassDefOverride(TTreePerfStats, 12) // TTree I/O performance measurement
 };
 
 #endif
@@ -58,6 +58,8 @@ The Draw or Print functions print the following information:
  -  ReadSize  = Average read size in KBytes
  -  Readahead = Readahead size in KBytes
  -  Readextra = Readahead overhead in percent
+ -  BufPool   = Number of basket buffers acquired since the start of the measurement, by all
+               threads of the process, and the fraction reused from the buffer pool
  -  Real Time = Real Time in seconds
  -  CPU  Time = CPU Time in seconds
  -  Disk Time = Real Time spent in pure raw disk IO
@@ -77,9 +79,23 @@ ReadTotal +ReadTotal*Readextra/100. Same for ReadSize.
 A consequence of NOTE1, the Disk I/O speed corresponds to the effective
 number of bytes returned to the application per second.
 The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
+
+ ### Access profile :
+The branches whose baskets are read from the file are recorded, in the order
+of their first read. SaveProfile writes them to a profile file that the next
+jobs reading the tree give to TTreeCache::LoadProfile (or to the resource
+TTreeCache.Profile), so that their TTreeCache prefetches exactly these branches
+from the first entry on instead of learning them:
+~~~{.cpp}
+   ps->SaveProfile("cmsprofile.txt");
+   // in the next job
+   T->SetCacheSize(10000000);
+   T->GetReadCache(T->GetCurrentFile())->LoadProfile("cmsprofile.txt");
+~~~
 */
 
 #include "TTreePerfStats.h"
+#include "ROOT/TBasketBufferPool.hxx"
 #include "TROOT.h"
 #include "TSystem.h"
 #include "TFile.h"
@@ -96,7 +112,9 @@ The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
 #include "TTimeStamp.h"
 #include "TDatime.h"
 #include "TMath.h"
+#include "TEnv.h"
 
+#include <algorithm>
 #include <iostream>
 
 ClassImp(TTreePerfStats);
@@ -128,6 +146,10 @@ TTreePerfStats::TTreePerfStats() : TVirtualPerfStats()
    fUnzipInputSize= 0;
    fUnzipObjSize  = 0;
    fCompress      = 0;
+   fBufferPoolAcquired = 0;
+   fBufferPoolReused   = 0;
+   fBufferPoolAcquiredStart = 0;
+   fBufferPoolReusedStart   = 0;
    fRealTimeAxis  = 0;
    fHostInfoText  = 0;
 }
@@ -165,6 +187,10 @@ TTreePerfStats::TTreePerfStats(const char *name, TTree *T) : TVirtualPerfStats()
    fUnzipTime     = 0;
    fUnzipInputSize= 0;
    fUnzipObjSize  = 0;
+   fBufferPoolAcquired = 0;
+   fBufferPoolReused   = 0;
+   fBufferPoolAcquiredStart = ROOT::Internal::TBasketBufferPool::GetNAcquired();
+   fBufferPoolReusedStart   = ROOT::Internal::TBasketBufferPool::GetNReused();
    fRealTimeAxis  = 0;
    fCompress      = (T->GetTotBytes()+0.00001)/T->GetZipBytes();
 
@@ -341,6 +367,8 @@ void TTreePerfStats::Finish()
    fCpuTime       = fWatch->CpuTime();
    if (fUnzipInputSize)
       fCompress = ((double)fUnzipObjSize) / fUnzipInputSize;
+   fBufferPoolAcquired = ROOT::Internal::TBasketBufferPool::GetNAcquired() - fBufferPoolAcquiredStart;
+   fBufferPoolReused   = ROOT::Internal::TBasketBufferPool::GetNReused() - fBufferPoolReusedStart;
    Int_t npoints  = fGraphIO->GetN();
    if (!npoints) return;
    Double_t iomax = TMath::MaxElement(npoints,fGraphIO->GetY());
@@ -417,6 +445,21 @@ TTreePerfStats::BasketInfo &TTreePerfStats::GetBasketInfo(size_t index, size_t b
    return brvec[basketNumber];
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record that the basket basketNumber of the branch b was read from the file;
+/// the branch is added to the list of branches read the first time.
+
+void TTreePerfStats::SetUsed(TBranch *b, size_t basketNumber)
+{
+   if (fBranchesSeen.insert(b).second) {
+      // The branch of another file of a chain may already be known by name.
+      TString name = b->GetFullName();
+      if (std::find(fBranchesRead.begin(), fBranchesRead.end(), name) == fBranchesRead.end())
+         fBranchesRead.emplace_back(name);
+   }
+   ++GetBasketInfo(b, basketNumber).fUsed;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the collection of baskets which have been read by the TTreeCache more
 /// than once
@@ -555,6 +598,8 @@ void TTreePerfStats::Print(Option_t * option) const
    printf("ReadSize  = %7.3f KBytes/read\n",0.001*fBytesRead/fReadCalls);
    printf("Readahead = %d KBytes\n",fReadaheadSize/1000);
    printf("Readextra = %5.2f per cent\n",extra);
+   if (fBufferPoolAcquired)
+      printf("BufPool   = %lld buffers, %5.2f per cent reused\n",fBufferPoolAcquired,100.*fBufferPoolReused/fBufferPoolAcquired);
    printf("Real Time = %7.3f seconds\n",fRealTime);
    printf("CPU  Time = %7.3f seconds\n",fCpuTime);
    printf("Disk Time = %7.3f seconds\n",fDiskTime);
@@ -651,6 +696,32 @@ void TTreePerfStats::SaveAs(const char *filename, Option_t * /*option*/) const
    ps->TObject::SaveAs(filename);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Save the access profile of the tree, i.e. the names of the branches read so
+/// far in the order of their first read, to the text file filename as the
+/// resource `<treename>.Branches`. The profiles of the other trees already in
+/// the file are kept. See TTreeCache::LoadProfile.
+/// Returns 0 on success, -1 on error.
+
+Int_t TTreePerfStats::SaveProfile(const char *filename) const
+{
+   if (!fTree) {
+      Error("SaveProfile", "no tree is monitored");
+      return -1;
+   }
+
+   TEnv profile;
+   profile.ReadFile(filename, kEnvLocal);
+   TString branches;
+   for (const auto &name : fBranchesRead) {
+      if (!branches.IsNull())
+         branches += " ";
+      branches += name;
+   }
+   profile.SetValue(TString::Format("%s.Branches", fTree->GetName()), branches);
+   return profile.WriteFile(filename, kEnvAll);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Save primitive as a C++ statement(s) on output stream out
 
@@ -672,6 +743,8 @@ void TTreePerfStats::SavePrimitive(std::ostream &out, Option_t *option /*= ""*/)
    out<<"   ps->SetReadaheadSize("<<fReadaheadSize<<");"<<std::endl;
    out<<"   ps->SetBytesRead("<<fBytesRead<<");"<<std::endl;
    out<<"   ps->SetBytesReadExtra("<<fBytesReadExtra<<");"<<std::endl;
+   out<<"   ps->SetBufferPoolAcquired("<<fBufferPoolAcquired<<");"<<std::endl;
+   out<<"   ps->SetBufferPoolReused("<<fBufferPoolReused<<");"<<std::endl;
    out<<"   ps->SetRealNorm("<<fRealNorm<<");"<<std::endl;
    out<<"   ps->SetRealTime("<<fRealTime<<");"<<std::endl;
    out<<"   ps->SetCpuTime("<<fCpuTime<<");"<<std::endl;
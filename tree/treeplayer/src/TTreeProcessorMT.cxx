@@ -22,11 +22,26 @@ The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the
 each corresponding to a cluster in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
 objects.
+
+By default, the clusters of each file are grouped into a fixed number of tasks before
+processing starts (see SetTasksPerWorkerHint). With dynamic scheduling enabled (see
+SetDynamicScheduling), the tasks processing a file instead take ranges of clusters from
+a shared queue on demand, with ranges that get smaller as the file runs out of work, so
+that a slow file or a few large clusters do not leave most threads idle at the end of
+the processing.
 */
 
 #include "TROOT.h"
+#include "TSystem.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
 using namespace ROOT;
 
 namespace {
@@ -122,49 +137,253 @@ ConvertToElistClusters(std::vector<std::vector<EntryRange>> &&clusters, TEntryLi
 // EntryRanges and number of entries per file
 using ClustersAndEntries = std::pair<std::vector<std::vector<EntryRange>>, std::vector<Long64_t>>;
 
+/// Number of entries and cluster boundaries (with local entry numbers) of the tree in one file.
+struct RFileMetadata {
+   Long64_t fEntries = 0ll;
+   std::vector<EntryRange> fClusters;
+};
+
+////////////////////////////////////////////////////////////////////////
+/// Open the file and read the number of entries and the cluster boundaries of the tree.
+static RFileMetadata ReadFileMetadata(const std::string &treeName, const std::string &fileName)
+{
+   TDirectory::TContext c;
+   std::unique_ptr<TFile> f(TFile::Open(
+      fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION")); // need TFile::Open to load plugins if need be
+   if (!f || f->IsZombie()) {
+      const auto msg = "TTreeProcessorMT::Process: an error occurred while opening file \"" + fileName + "\"";
+      throw std::runtime_error(msg);
+   }
+   auto *t = f->Get<TTree>(treeName.c_str()); // t will be deleted by f
+
+   if (!t) {
+      const auto msg = "TTreeProcessorMT::Process: an error occurred while getting tree \"" + treeName +
+                       "\" from file \"" + fileName + "\"";
+      throw std::runtime_error(msg);
+   }
+
+   // Avoid calling TROOT::RecursiveRemove for this tree, it takes the read lock and we don't need it.
+   t->ResetBit(kMustCleanup);
+   ROOT::Internal::TreeUtils::ClearMustCleanupBits(*t->GetListOfBranches());
+
+   RFileMetadata metadata;
+   metadata.fEntries = t->GetEntries();
+   auto clusterIter = t->GetClusterIterator(0);
+   Long64_t clusterStart = 0ll;
+   while ((clusterStart = clusterIter()) < metadata.fEntries)
+      metadata.fClusters.emplace_back(EntryRange{clusterStart, clusterIter.GetNextEntry()});
+   return metadata;
+}
+
+/// Return the name of the first TTree found in the given file, or an empty string if there is none.
+static std::string ReadTreeName(const std::string &fileName)
+{
+   ::TDirectory::TContext ctxt;
+   std::unique_ptr<TFile> f(TFile::Open(fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION"));
+   if (f && !f->IsZombie()) {
+      TIter next(f->GetListOfKeys());
+      while (auto *key = static_cast<TKey *>(next())) {
+         if (strcmp(key->GetClassName(), "TTree") == 0)
+            return key->GetName();
+      }
+   }
+   return "";
+}
+
+/// A persistent cache of the RFileMetadata of the files processed by TTreeProcessorMT, see
+/// TTreeProcessorMT::SetMetadataCacheFile().
+///
+/// The cache is a small text file with one line per file and tree: file name, tree name, then size and modification
+/// time of the file, number of entries, number of clusters and cluster boundaries. Files whose tree name had to be
+/// looked up also have a line with an empty tree name: file name, size and modification time, then the name of the
+/// first tree of the file. An entry is only used if the size and modification time of the file still match, otherwise
+/// the file is read again and the entry is replaced.
+class RMetadataCache {
+   struct REntry {
+      Long64_t fSize;
+      Long_t fModTime;
+      RFileMetadata fMetadata;
+   };
+
+   struct RTreeNameEntry {
+      Long64_t fSize;
+      Long_t fModTime;
+      std::string fTreeName;
+   };
+
+   const std::string fCacheFileName;
+   std::map<std::pair<std::string, std::string>, REntry> fEntries; ///< Keys are {file name, tree name}
+   std::map<std::string, RTreeNameEntry> fTreeNames;               ///< Keys are file names
+   bool fIsModified = false;
+   std::mutex fMutex;
+
+   static bool GetFileStat(const std::string &fileName, FileStat_t &stat)
+   {
+      return gSystem->GetPathInfo(fileName.c_str(), stat) == 0;
+   }
+
+public:
+   explicit RMetadataCache(const std::string &cacheFileName) : fCacheFileName(cacheFileName)
+   {
+      std::ifstream in(fCacheFileName);
+      std::string line;
+      while (std::getline(in, line)) {
+         if (line.empty() || line[0] == '#')
+            continue;
+         const auto tab1 = line.find('\t');
+         const auto tab2 = line.find('\t', tab1 + 1);
+         if (tab1 == std::string::npos || tab2 == std::string::npos)
+            continue;
+         if (tab2 == tab1 + 1) {
+            // name of the first tree of the file
+            const auto tab3 = line.find('\t', tab2 + 1);
+            if (tab3 == std::string::npos || tab3 + 1 == line.size())
+               continue;
+            std::istringstream numbers(line.substr(tab2 + 1, tab3 - tab2 - 1));
+            RTreeNameEntry entry;
+            numbers >> entry.fSize >> entry.fModTime;
+            if (!numbers)
+               continue;
+            entry.fTreeName = line.substr(tab3 + 1);
+            fTreeNames[line.substr(0, tab1)] = std::move(entry);
+            continue;
+         }
+         std::istringstream numbers(line.substr(tab2 + 1));
+         REntry entry;
+         std::size_t nClusters = 0u;
+         numbers >> entry.fSize >> entry.fModTime >> entry.fMetadata.fEntries >> nClusters;
+         entry.fMetadata.fClusters.resize(nClusters);
+         for (auto &c : entry.fMetadata.fClusters)
+            numbers >> c.first >> c.second;
+         if (!numbers)
+            continue; // malformed line, the file will be read again
+         fEntries[{line.substr(0, tab1), line.substr(tab1 + 1, tab2 - tab1 - 1)}] = std::move(entry);
+      }
+   }
+
+   RMetadataCache(const RMetadataCache &) = delete;
+   RMetadataCache &operator=(const RMetadataCache &) = delete;
+
+   /// Return the metadata of the given tree, reading it from the file only if the cache is missing or outdated.
+   RFileMetadata Get(const std::string &treeName, const std::string &fileName)
+   {
+      FileStat_t stat;
+      const bool canValidate = GetFileStat(fileName, stat);
+      if (canValidate) {
+         std::lock_guard<std::mutex> lock(fMutex);
+         const auto it = fEntries.find({fileName, treeName});
+         if (it != fEntries.end() && it->second.fSize == stat.fSize && it->second.fModTime == stat.fMtime)
+            return it->second.fMetadata;
+      }
+
+      auto metadata = ReadFileMetadata(treeName, fileName);
+      if (canValidate) {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fEntries[{fileName, treeName}] = REntry{stat.fSize, stat.fMtime, metadata};
+         fIsModified = true;
+      }
+      return metadata;
+   }
+
+   /// Return the name of the first tree of the given file, opening it only if the cache is missing or outdated.
+   std::string GetTreeName(const std::string &fileName)
+   {
+      FileStat_t stat;
+      const bool canValidate = GetFileStat(fileName, stat);
+      if (canValidate) {
+         std::lock_guard<std::mutex> lock(fMutex);
+         const auto it = fTreeNames.find(fileName);
+         if (it != fTreeNames.end() && it->second.fSize == stat.fSize && it->second.fModTime == stat.fMtime)
+            return it->second.fTreeName;
+      }
+
+      auto treeName = ReadTreeName(fileName);
+      if (canValidate && !treeName.empty()) {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fTreeNames[fileName] = RTreeNameEntry{stat.fSize, stat.fMtime, treeName};
+         fIsModified = true;
+      }
+      return treeName;
+   }
+
+   /// Write the cache back to disk if new entries were added.
+   /// The file is replaced atomically, so that concurrent jobs never read a partially written cache.
+   void Save()
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (!fIsModified)
+         return;
+      const auto tmpName = fCacheFileName + ".tmp" + std::to_string(gSystem->GetPid());
+      {
+         std::ofstream out(tmpName);
+         out << "# TTreeProcessorMT metadata cache: file, tree, size, modification time, entries, clusters\n";
+         for (const auto &e : fEntries) {
+            out << e.first.first << '\t' << e.first.second << '\t' << e.second.fSize << ' ' << e.second.fModTime << ' '
+                << e.second.fMetadata.fEntries << ' ' << e.second.fMetadata.fClusters.size();
+            for (const auto &c : e.second.fMetadata.fClusters)
+               out << ' ' << c.first << ' ' << c.second;
+            out << '\n';
+         }
+         for (const auto &e : fTreeNames)
+            out << e.first << "\t\t" << e.second.fSize << ' ' << e.second.fModTime << '\t' << e.second.fTreeName << '\n';
+         if (!out) {
+            Warning("TTreeProcessorMT::Process", "could not write the metadata cache file %s", tmpName.c_str());
+            gSystem->Unlink(tmpName.c_str());
+            return;
+         }
+      }
+      if (gSystem->Rename(tmpName.c_str(), fCacheFileName.c_str()) != 0) {
+         Warning("TTreeProcessorMT::Process", "could not write the metadata cache file %s", fCacheFileName.c_str());
+         gSystem->Unlink(tmpName.c_str());
+         return;
+      }
+      fIsModified = false;
+   }
+};
+
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector of cluster boundaries for the given tree and files.
+/// File metadata is retrieved concurrently using `pool`, a batch of files at a time, and from `cache` if not null.
 static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames,
                                        const std::vector<std::string> &fileNames, const unsigned int maxTasksPerFile,
+                                       ROOT::TThreadExecutor &pool, RMetadataCache *cache,
                                        const EntryRange &range = {0, std::numeric_limits<Long64_t>::max()})
 {
-   // Note that as a side-effect of opening all files that are going to be used in the
-   // analysis once, all necessary streamers will be loaded into memory.
-   TDirectory::TContext c;
+   // Note that as a side-effect of opening all files that are going to be used in the analysis once, all necessary
+   // streamers will be loaded into memory. This is not the case for the files whose metadata is found in `cache`:
+   // their streamers are loaded when the tasks open them.
    const auto nFileNames = fileNames.size();
+   std::vector<RFileMetadata> metadata(nFileNames);
+   auto getMetadata = [&](std::size_t i) {
+      metadata[i] = cache ? cache->Get(treeNames[i], fileNames[i]) : ReadFileMetadata(treeNames[i], fileNames[i]);
+   };
+   // Opening files is mostly latency-bound, so we read the metadata of a few files per worker at a time. Files are
+   // read in batches because, if a range is requested, we can stop as soon as its last entry has been found.
+   const std::size_t batchSize = nFileNames > 1 ? 4u * pool.GetPoolSize() : 1u;
+   std::vector<std::size_t> batch;
+
    std::vector<std::vector<EntryRange>> clustersPerFile;
    std::vector<Long64_t> entriesPerFile;
    entriesPerFile.reserve(nFileNames);
    Long64_t offset = 0ll;
    bool rangeEndReached = false; // flag to break the outer loop
    for (auto i = 0u; i < nFileNames && !rangeEndReached; ++i) {
-      const auto &fileName = fileNames[i];
-      const auto &treeName = treeNames[i];
-
-      std::unique_ptr<TFile> f(TFile::Open(
-         fileName.c_str(), "READ_WITHOUT_GLOBALREGISTRATION")); // need TFile::Open to load plugins if need be
-      if (!f || f->IsZombie()) {
-         const auto msg = "TTreeProcessorMT::Process: an error occurred while opening file \"" + fileName + "\"";
-         throw std::runtime_error(msg);
-      }
-      auto *t = f->Get<TTree>(treeName.c_str()); // t will be deleted by f
-
-      if (!t) {
-         const auto msg = "TTreeProcessorMT::Process: an error occurred while getting tree \"" + treeName +
-                          "\" from file \"" + fileName + "\"";
-         throw std::runtime_error(msg);
+      if (i % batchSize == 0) {
+         batch.resize(std::min(batchSize, nFileNames - i));
+         std::iota(batch.begin(), batch.end(), i);
+         if (batch.size() > 1)
+            pool.Foreach(getMetadata, batch);
+         else
+            getMetadata(i);
       }
 
-      // Avoid calling TROOT::RecursiveRemove for this tree, it takes the read lock and we don't need it.
-      t->ResetBit(kMustCleanup);
-      ROOT::Internal::TreeUtils::ClearMustCleanupBits(*t->GetListOfBranches());
-      auto clusterIter = t->GetClusterIterator(0);
-      Long64_t clusterStart = 0ll, clusterEnd = 0ll;
-      const Long64_t entries = t->GetEntries();
+      const auto &fileClusters = metadata[i].fClusters;
+      const Long64_t entries = metadata[i].fEntries;
       // Iterate over the clusters in the current file
       std::vector<EntryRange> entryRanges;
-      while ((clusterStart = clusterIter()) < entries && !rangeEndReached) {
-         clusterEnd = clusterIter.GetNextEntry();
+      for (auto clusterIt = fileClusters.begin(); clusterIt != fileClusters.end() && !rangeEndReached; ++clusterIt) {
+         const auto clusterStart = clusterIt->first;
+         const auto clusterEnd = clusterIt->second;
          // Currently, if a user specified a range, the clusters will be only globally obtained
          // Assume that there are 3 files with entries: [0, 100], [0, 150], [0, 200] (in this order)
          // Since the cluster boundaries are obtained sequentially, applying the offsets, the boundaries
@@ -242,11 +461,72 @@ static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames
    return std::make_pair(std::move(eventRangesPerFile), std::move(entriesPerFile));
 }
 
+/// The clusters of one file, from which the tasks processing that file take ranges of entries on demand.
+///
+/// Each call to Pop() hands out one or more consecutive clusters. The size of the range is a fraction of the entries
+/// still in the queue (guided self-scheduling): the first ranges are large, so that few TTreeReaders need to be set
+/// up, and the last ones are single clusters, so that no task is left alone with a large range at the end.
+/// The processing rate measured on previous ranges (see Done()) sets a lower bound on the range size, so that tasks
+/// do not get so short that their set-up cost dominates.
+class RClusterQueue {
+   /// Minimum wall-clock duration we aim at for a task, given the measured processing rate
+   static constexpr double kMinTaskSeconds = 0.01;
+
+   const std::vector<EntryRange> &fClusters; ///< Sorted and contiguous clusters
+   const unsigned int fNWorkers;
+   std::size_t fNext = 0u;
+   Long64_t fRemainingEntries = 0ll;
+   Long64_t fProcessedEntries = 0ll;
+   double fProcessingSeconds = 0.;
+   std::mutex fMutex;
+
+public:
+   RClusterQueue(const std::vector<EntryRange> &clusters, unsigned int nWorkers)
+      : fClusters(clusters), fNWorkers(std::max(nWorkers, 1u))
+   {
+      for (const auto &c : fClusters)
+         fRemainingEntries += c.second - c.first;
+   }
+
+   /// Take the next range of entries to process. Return false if there are none left.
+   bool Pop(EntryRange &range)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (fNext == fClusters.size())
+         return false;
+
+      Long64_t target = std::ceil(double(fRemainingEntries) / (2. * fNWorkers));
+      if (fProcessingSeconds > 0.)
+         target = std::max(target, Long64_t(kMinTaskSeconds * fProcessedEntries / fProcessingSeconds));
+
+      const auto first = fNext;
+      Long64_t nEntries = 0ll;
+      do {
+         nEntries += fClusters[fNext].second - fClusters[fNext].first;
+         ++fNext;
+      } while (nEntries < target && fNext < fClusters.size());
+
+      range = {fClusters[first].first, fClusters[fNext - 1].second};
+      fRemainingEntries -= nEntries;
+      return true;
+   }
+
+   /// Record how long it took a task to process a range, as feedback for the size of the following ranges.
+   void Done(Long64_t nEntries, double seconds)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fProcessedEntries += nEntries;
+      fProcessingSeconds += seconds;
+   }
+};
+
 } // anonymous namespace
 
 namespace ROOT {
 
 unsigned int TTreeProcessorMT::fgTasksPerWorkerHint = 10U;
+bool TTreeProcessorMT::fgDynamicScheduling = false;
+std::string TTreeProcessorMT::fgMetadataCacheFile;
 
 namespace Internal {
 
@@ -325,27 +605,32 @@ void TTreeView::Reset()
 /// Retrieve the names of the TTrees in each of the input files, throw if a TTree cannot be found.
 std::vector<std::string> TTreeProcessorMT::FindTreeNames()
 {
-   std::vector<std::string> treeNames;
-
    if (fFileNames.empty()) // This can never happen
       throw std::runtime_error("Empty list of files and no tree name provided");
 
-   ::TDirectory::TContext ctxt(gDirectory);
-   for (const auto &fname : fFileNames) {
-      std::string treeName;
-      std::unique_ptr<TFile> f(TFile::Open(fname.c_str()));
-      TIter next(f->GetListOfKeys());
-      while (auto *key = static_cast<TKey *>(next())) {
-         const char *className = key->GetClassName();
-         if (strcmp(className, "TTree") == 0) {
-            treeName = key->GetName();
-            break;
-         }
-      }
-      if (treeName.empty())
+   std::unique_ptr<RMetadataCache> metadataCache;
+   if (!fgMetadataCacheFile.empty())
+      metadataCache = std::make_unique<RMetadataCache>(fgMetadataCacheFile);
+
+   std::vector<std::string> treeNames(fFileNames.size());
+   auto findTreeName = [&](std::size_t fileIdx) {
+      const auto &fname = fFileNames[fileIdx];
+      treeNames[fileIdx] = metadataCache ? metadataCache->GetTreeName(fname) : ReadTreeName(fname);
+      if (treeNames[fileIdx].empty())
          throw std::runtime_error("Cannot find any tree in file " + fname);
-      treeNames.emplace_back(std::move(treeName));
+   };
+
+   // opening many files one after the other can take a long time, e.g. on a parallel filesystem
+   std::vector<std::size_t> fileIdxs(fFileNames.size());
+   std::iota(fileIdxs.begin(), fileIdxs.end(), 0u);
+   if (fFileNames.size() > 1 && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(findTreeName, fileIdxs);
+   } else {
+      std::for_each(fileIdxs.begin(), fileIdxs.end(), findTreeName);
    }
+   if (metadataCache)
+      metadataCache->Save();
 
    return treeNames;
 }
@@ -451,9 +736,40 @@ TTreeProcessorMT::TTreeProcessorMT(TTree &tree, UInt_t nThreads, const EntryRang
 /// \param[in] func User-defined function that processes a subrange of entries
 void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
 {
-   // compute number of tasks per file
+   // compute number of tasks per file. With dynamic scheduling, clusters are grouped on demand instead.
+   const bool dynamicScheduling = IsDynamicSchedulingEnabled();
    const unsigned int maxTasksPerFile =
-      std::ceil(float(GetTasksPerWorkerHint() * fPool.GetPoolSize()) / float(fFileNames.size()));
+      dynamicScheduling ? std::numeric_limits<unsigned int>::max()
+                        : static_cast<unsigned int>(std::ceil(float(GetTasksPerWorkerHint() * fPool.GetPoolSize()) /
+                                                              float(fFileNames.size())));
+
+   // Process the given clusters of a file, either as they are or taking ranges of clusters from a RClusterQueue
+   auto processClusters = [&](const std::vector<EntryRange> &clusters, const auto &makeReader) {
+      if (!dynamicScheduling) {
+         auto processCluster = [&](const EntryRange &c) {
+            auto r = makeReader(c);
+            func(*r);
+         };
+         fPool.Foreach(processCluster, clusters);
+         return;
+      }
+
+      RClusterQueue queue(clusters, fPool.GetPoolSize());
+      auto processQueue = [&](unsigned int) {
+         EntryRange range;
+         while (queue.Pop(range)) {
+            auto r = makeReader(range);
+            const auto start = std::chrono::steady_clock::now();
+            func(*r);
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            queue.Done(range.second - range.first, elapsed.count());
+         }
+      };
+      // one task per worker: each keeps taking work from the queue until it is empty
+      std::vector<unsigned int> workers(std::min<std::size_t>(fPool.GetPoolSize(), clusters.size()));
+      std::iota(workers.begin(), workers.end(), 0u);
+      fPool.Foreach(processQueue, workers);
+   };
 
    // If an entry list or friend trees are present, we need to generate clusters with global entry numbers,
    // so we do it here for all files.
@@ -464,23 +780,26 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const bool hasEntryList = fEntryList.GetN() > 0;
    const bool shouldRetrieveAllClusters = hasFriends || hasEntryList || fGlobalRange.first > 0 ||
                                           fGlobalRange.second != std::numeric_limits<Long64_t>::max();
+   std::unique_ptr<RMetadataCache> metadataCache;
+   if (!fgMetadataCacheFile.empty())
+      metadataCache = std::make_unique<RMetadataCache>(fgMetadataCacheFile);
    ClustersAndEntries allClusterAndEntries{};
    auto &allClusters = allClusterAndEntries.first;
    const auto &allEntries = allClusterAndEntries.second;
    if (shouldRetrieveAllClusters) {
-      allClusterAndEntries = MakeClusters(fTreeNames, fFileNames, maxTasksPerFile, fGlobalRange);
+      allClusterAndEntries =
+         MakeClusters(fTreeNames, fFileNames, maxTasksPerFile, fPool, metadataCache.get(), fGlobalRange);
       if (hasEntryList)
          allClusters = ConvertToElistClusters(std::move(allClusters), fEntryList, fTreeNames, fFileNames, allEntries);
    }
 
    // Per-file processing in case we retrieved all cluster info upfront
    auto processFileUsingGlobalClusters = [&](std::size_t fileIdx) {
-      auto processCluster = [&](const EntryRange &c) {
-         auto r =
-            fTreeView->GetTreeReader(c.first, c.second, fTreeNames, fFileNames, fFriendInfo, fEntryList, allEntries);
-         func(*r);
+      auto makeReader = [&](const EntryRange &c) {
+         return fTreeView->GetTreeReader(c.first, c.second, fTreeNames, fFileNames, fFriendInfo, fEntryList,
+                                         allEntries);
       };
-      fPool.Foreach(processCluster, allClusters[fileIdx]);
+      processClusters(allClusters[fileIdx], makeReader);
    };
 
    // Per-file processing that also retrieves cluster info for a file
@@ -488,14 +807,13 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
       // Evaluate clusters (with local entry numbers) and number of entries for this file
       const auto &treeNames = std::vector<std::string>({fTreeNames[fileIdx]});
       const auto &fileNames = std::vector<std::string>({fFileNames[fileIdx]});
-      const auto clustersAndEntries = MakeClusters(treeNames, fileNames, maxTasksPerFile);
+      const auto clustersAndEntries = MakeClusters(treeNames, fileNames, maxTasksPerFile, fPool, metadataCache.get());
       const auto &clusters = clustersAndEntries.first[0];
       const auto &entries = clustersAndEntries.second[0];
-      auto processCluster = [&](const EntryRange &c) {
-         auto r = fTreeView->GetTreeReader(c.first, c.second, treeNames, fileNames, fFriendInfo, fEntryList, {entries});
-         func(*r);
+      auto makeReader = [&](const EntryRange &c) {
+         return fTreeView->GetTreeReader(c.first, c.second, treeNames, fileNames, fFriendInfo, fEntryList, {entries});
       };
-      fPool.Foreach(processCluster, clusters);
+      processClusters(clusters, makeReader);
    };
 
    const auto firstNonEmpty =
@@ -511,6 +829,9 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    else
       fPool.Foreach(processFileRetrievingClusters, fileIdxs);
 
+   if (metadataCache)
+      metadataCache->Save();
+
    // make sure TChains and TFiles are cleaned up since they are not globally tracked
    for (unsigned int islot = 0; islot < fTreeView.GetNSlots(); ++islot) {
       ROOT::Internal::TTreeView *view = fTreeView.GetAtSlotRaw(islot);
@@ -540,3 +861,45 @@ void TTreeProcessorMT::SetTasksPerWorkerHint(unsigned int tasksPerWorkerHint)
 {
    fgTasksPerWorkerHint = tasksPerWorkerHint;
 }
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Enable or disable the dynamic scheduling of the entries of each file.
+/// \param[in] enable Whether clusters should be distributed to tasks on demand.
+///
+/// With dynamic scheduling, the clusters of a file are not grouped into a fixed set of tasks upfront. Instead, one
+/// task per worker takes ranges of clusters from a queue until the file is done. Ranges are large at first and shrink
+/// down to single clusters as the file runs out of entries, and the processing rate measured on the first ranges
+/// prevents ranges from becoming too short to be worth a new task. The tasks-per-worker hint is ignored in this mode.
+/// This also applies to RDataFrame event loops over TTrees.
+void TTreeProcessorMT::SetDynamicScheduling(bool enable)
+{
+   fgDynamicScheduling = enable;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Return whether the entries of each file are distributed to tasks on demand, see SetDynamicScheduling().
+bool TTreeProcessorMT::IsDynamicSchedulingEnabled()
+{
+   return fgDynamicScheduling;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Set a file in which to cache the number of entries and the cluster boundaries of the processed files.
+/// \param[in] fileName Path of the cache file, or an empty string to disable the cache (the default).
+///
+/// Before processing, TTreeProcessorMT needs the number of entries and the cluster boundaries of the tree in each
+/// input file, and the name of that tree if it was not given. With a cache file set, this information is looked up
+/// in the cache instead of being read from the input files, and the cache is updated with the information of the files that had to be opened. An entry of the
+/// cache is only used if the size and modification time of the input file did not change since it was recorded.
+/// The same cache file can be shared by subsequent jobs running on the same dataset.
+void TTreeProcessorMT::SetMetadataCacheFile(std::string_view fileName)
+{
+   fgMetadataCacheFile = std::string(fileName);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Return the path of the metadata cache file, see SetMetadataCacheFile().
+const std::string &TTreeProcessorMT::GetMetadataCacheFile()
+{
+   return fgMetadataCacheFile;
+}
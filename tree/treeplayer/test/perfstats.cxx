@@ -0,0 +1,146 @@
+#include "TEnv.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+#include "TTreePerfStats.h"
+#include "TVirtualPerfStats.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+constexpr Long64_t kNEntries = 10000;
+
+// Write a tree of three branches, of which the jobs below read y and z.
+void WriteXYZTree(const char *fileName)
+{
+   TFile file(fileName, "RECREATE");
+   TTree tree("tree", "tree");
+   tree.SetAutoFlush(1000);
+   Long64_t x = 0;
+   Double_t y = 0;
+   Float_t z = 0;
+   tree.Branch("x", &x);
+   tree.Branch("y", &y);
+   tree.Branch("z", &z);
+   for (x = 0; x < kNEntries; ++x) {
+      y = 0.5 * x;
+      z = 2 * x;
+      tree.Fill();
+   }
+   file.Write();
+}
+
+void ReadYZ(TTree &tree)
+{
+   Double_t y = -1;
+   Float_t z = -1;
+   tree.SetBranchStatus("*", false);
+   tree.SetBranchStatus("y", true);
+   tree.SetBranchStatus("z", true);
+   tree.SetBranchAddress("y", &y);
+   tree.SetBranchAddress("z", &z);
+   for (Long64_t i = 0; i < kNEntries; ++i) {
+      ASSERT_GT(tree.GetEntry(i), 0);
+      ASSERT_EQ(y, 0.5 * i);
+      ASSERT_EQ(z, 2.f * i);
+   }
+}
+
+// Record the access profile of a first job reading y and z.
+void RecordProfile(const char *fileName, const char *profileName)
+{
+   TFile file(fileName);
+   auto tree = file.Get<TTree>("tree");
+   ASSERT_NE(tree, nullptr);
+   TTreePerfStats ps("ioperf", tree);
+   ReadYZ(*tree);
+   EXPECT_EQ(ps.SaveProfile(profileName), 0);
+   // The perf stats are deleted before the tree.
+   tree->SetPerfStats(nullptr);
+   gPerfStats = nullptr;
+}
+
+void ExpectProfileBranches(TTree &tree, TTreeCache &cache)
+{
+   EXPECT_FALSE(cache.IsLearning());
+   const auto branches = cache.GetCachedBranches();
+   ASSERT_EQ(branches->GetEntries(), 2);
+   EXPECT_EQ(branches->At(0), tree.GetBranch("y"));
+   EXPECT_EQ(branches->At(1), tree.GetBranch("z"));
+}
+} // namespace
+
+TEST(TTreePerfStats, SaveAndLoadProfile)
+{
+   auto fileName = "perfstats_saveandload.root";
+   auto profileName = "perfstats_saveandload.txt";
+   WriteXYZTree(fileName);
+   RecordProfile(fileName, profileName);
+
+   TEnv profile;
+   ASSERT_EQ(profile.ReadFile(profileName, kEnvLocal), 0);
+   EXPECT_STREQ(profile.GetValue("tree.Branches", ""), "y z");
+
+   {
+      // The next job prefetches the branches of the profile, and only those.
+      TFile file(fileName);
+      auto tree = file.Get<TTree>("tree");
+      ASSERT_NE(tree, nullptr);
+      tree->SetCacheSize(100000);
+      auto cache = dynamic_cast<TTreeCache *>(tree->GetReadCache(&file));
+      ASSERT_NE(cache, nullptr);
+      EXPECT_EQ(cache->LoadProfile(profileName), 2);
+      ExpectProfileBranches(*tree, *cache);
+      ReadYZ(*tree);
+   }
+
+   gSystem->Unlink(fileName);
+   gSystem->Unlink(profileName);
+}
+
+TEST(TTreePerfStats, BufferPoolCounters)
+{
+   auto fileName = "perfstats_bufferpool.root";
+   WriteXYZTree(fileName);
+
+   {
+      TFile file(fileName);
+      auto tree = file.Get<TTree>("tree");
+      ASSERT_NE(tree, nullptr);
+      TTreePerfStats ps("ioperf", tree);
+      ReadYZ(*tree);
+      ps.Finish();
+      EXPECT_GT(ps.GetBufferPoolAcquired(), 0);
+      EXPECT_LE(ps.GetBufferPoolReused(), ps.GetBufferPoolAcquired());
+      tree->SetPerfStats(nullptr);
+      gPerfStats = nullptr;
+   }
+
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreePerfStats, ConfiguredProfile)
+{
+   auto fileName = "perfstats_configured.root";
+   auto profileName = "perfstats_configured.txt";
+   WriteXYZTree(fileName);
+   RecordProfile(fileName, profileName);
+
+   {
+      // The profile set in the configuration is loaded by every cache created.
+      gEnv->SetValue("TTreeCache.Profile", profileName);
+      TFile file(fileName);
+      auto tree = file.Get<TTree>("tree");
+      ASSERT_NE(tree, nullptr);
+      tree->SetCacheSize(100000);
+      auto cache = dynamic_cast<TTreeCache *>(tree->GetReadCache(&file));
+      gEnv->SetValue("TTreeCache.Profile", "");
+      ASSERT_NE(cache, nullptr);
+      ExpectProfileBranches(*tree, *cache);
+      ReadYZ(*tree);
+   }
+
+   gSystem->Unlink(fileName);
+   gSystem->Unlink(profileName);
+}
@@ -1,10 +1,14 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
+#include <fstream>
 #include <random>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <TFile.h>
 #include <TTree.h>
@@ -362,6 +366,119 @@ TEST(TreeProcessorMT, LimitNTasks_CheckClusters)
    gSystem->Unlink(filename);
 }
 
+TEST(TreeProcessorMT, DynamicScheduling)
+{
+   const auto nEvents = 991;
+   const auto filename = "TreeProcessorMT_DynamicScheduling.root";
+   const auto treename = "t";
+   WriteFileManyClusters(nEvents, treename, filename);
+
+   std::mutex m;
+   std::vector<std::pair<Long64_t, Long64_t>> ranges;
+   auto nEntries = 0ll;
+   auto f = [&](TTreeReader &t) {
+      auto n = 0ll;
+      while (t.Next())
+         ++n;
+      std::lock_guard<std::mutex> l(m);
+      ranges.emplace_back(t.GetEntriesRange());
+      nEntries += n;
+   };
+
+   ROOT::TTreeProcessorMT::SetDynamicScheduling(true);
+   for (auto nThreads = 0; nThreads <= 4; ++nThreads) {
+      ROOT::EnableImplicitMT(nThreads);
+
+      ROOT::TTreeProcessorMT p(filename, treename);
+      p.Process(f);
+
+      EXPECT_EQ(nEntries, nEvents);
+      CheckClusters(ranges, nEvents);
+      // the first range is at most half of the entries divided by the number of workers
+      EXPECT_LE(ranges.front().second - ranges.front().first, std::ceil(nEvents / 2.));
+      ranges.clear();
+      nEntries = 0ll;
+      ROOT::DisableImplicitMT();
+   }
+   ROOT::TTreeProcessorMT::SetDynamicScheduling(false);
+
+   gSystem->Unlink(filename);
+}
+
+TEST(TreeProcessorMT, MetadataCache)
+{
+   const auto nEvents = 100;
+   const auto filename = "TreeProcessorMT_MetadataCache.root";
+   const auto cachename = "TreeProcessorMT_MetadataCache.txt";
+   const auto treename = "t";
+   WriteFileManyClusters(nEvents, treename, filename);
+   gSystem->Unlink(cachename);
+
+   std::atomic<Long64_t> nEntries(0ll);
+   std::atomic<unsigned int> nTasks(0u);
+   auto f = [&](TTreeReader &t) {
+      ++nTasks;
+      while (t.Next())
+         ++nEntries;
+   };
+
+   ROOT::TTreeProcessorMT::SetMetadataCacheFile(cachename);
+   EXPECT_EQ(ROOT::TTreeProcessorMT::GetMetadataCacheFile(), cachename);
+   ROOT::EnableImplicitMT(2);
+   {
+      // the tree name is looked up in the file
+      ROOT::TTreeProcessorMT p(filename);
+      p.Process(f);
+   }
+   EXPECT_EQ(nEntries, nEvents);
+   EXPECT_GT(nTasks, 1u);
+
+   // The cache has been written. Replace the cluster boundaries of the file by a single cluster, such that the next
+   // run can only process the file in one task if it takes them from the cache.
+   std::vector<std::string> lines;
+   {
+      std::ifstream in(cachename);
+      ASSERT_TRUE(in.good());
+      std::string line;
+      bool hasTreeName = false;
+      while (std::getline(in, line)) {
+         const std::string metadataPrefix = std::string(filename) + "\t" + treename + "\t";
+         if (line.rfind(metadataPrefix, 0) == 0) {
+            std::istringstream numbers(line.substr(metadataPrefix.size()));
+            Long64_t size, modTime, entries;
+            numbers >> size >> modTime >> entries;
+            line = metadataPrefix + std::to_string(size) + ' ' + std::to_string(modTime) + ' ' +
+                   std::to_string(entries) + " 1 0 " + std::to_string(entries);
+         }
+         hasTreeName |= line.rfind(std::string(filename) + "\t\t", 0) == 0;
+         lines.push_back(line);
+      }
+      EXPECT_TRUE(hasTreeName);
+   }
+   {
+      std::ofstream out(cachename);
+      for (const auto &line : lines)
+         out << line << '\n';
+   }
+
+   // the second run reads the tree name, entries and clusters from the cache
+   nEntries = 0ll;
+   nTasks = 0u;
+   {
+      const auto nOpened = TFile::GetFileCounter();
+      ROOT::TTreeProcessorMT p(filename);
+      EXPECT_EQ(TFile::GetFileCounter(), nOpened);
+      p.Process(f);
+   }
+   EXPECT_EQ(nEntries, nEvents);
+   EXPECT_EQ(nTasks, 1u);
+   ROOT::DisableImplicitMT();
+   ROOT::TTreeProcessorMT::SetMetadataCacheFile("");
+
+   gSystem->Unlink(cachename);
+   gSystem->Unlink(filename);
+}
+
 TEST(TreeProcessorMT, TreeWithFriendTree)
 {
    std::vector<std::string> fileNames = {"TreeWithFriendTree_Tree.root", "TreeWithFriendTree_Friend.root"};